@@ -40,7 +40,4 @@ public:
 
 	// status
 	bool IsAlive(void) const;
-
-	// reporting
-	void WriteXml(std::ofstream &) {}
 };
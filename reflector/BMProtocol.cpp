@@ -78,7 +78,7 @@ void CBMProtocol::Task(void)
 		}
 		else if ( IsValidConnectPacket(Buffer, &Callsign, Modules, &Version) )
 		{
-			std::cout << "XLX (" << Version.GetMajor() << "." << Version.GetMinor() << "." << Version.GetRevision() << ") connect packet for modules " << Modules << " from " << Callsign <<  " at " << Ip << std::endl;
+			CLogLine(ELogLevel::info, "bm-connect") << "XLX (" << Version.GetMajor() << "." << Version.GetMinor() << "." << Version.GetRevision() << ") connect packet for modules " << Modules << " from " << Callsign <<  " at " << Ip;
 
 			// callsign authorized?
 			if ( g_GateKeeper.MayLink(Callsign, Ip, EProtocol::bm, Modules) )
@@ -96,7 +96,7 @@ void CBMProtocol::Task(void)
 		}
 		else if ( IsValidAckPacket(Buffer, &Callsign, Modules, &Version)  )
 		{
-			std::cout << "XLX ack packet for modules " << Modules << " from " << Callsign << " at " << Ip << std::endl;
+			CLogLine(ELogLevel::info, "bm-ack") << "XLX ack packet for modules " << Modules << " from " << Callsign << " at " << Ip;
 
 			// callsign authorized?
 			if ( g_GateKeeper.MayLink(Callsign, Ip, EProtocol::bm, Modules) )
@@ -118,7 +118,7 @@ void CBMProtocol::Task(void)
 		}
 		else if ( IsValidDisconnectPacket(Buffer, &Callsign) )
 		{
-			std::cout << "XLX disconnect packet from " << Callsign << " at " << Ip << std::endl;
+			CLogLine(ELogLevel::info, "bm-disconnect") << "XLX disconnect packet from " << Callsign << " at " << Ip;
 
 			// find peer
 			CPeers *peers = g_Reflector.GetPeers();
@@ -134,7 +134,7 @@ void CBMProtocol::Task(void)
 		}
 		else if ( IsValidNackPacket(Buffer, &Callsign) )
 		{
-			std::cout << "XLX nack packet from " << Callsign << " at " << Ip << std::endl;
+			CLogLine(ELogLevel::info, "bm-nack") << "XLX nack packet from " << Callsign << " at " << Ip;
 		}
 		else if ( IsValidKeepAlivePacket(Buffer, &Callsign) )
 		{
@@ -154,7 +154,7 @@ void CBMProtocol::Task(void)
 		{
 			std::string title("Unknown XLX packet from ");
 			title += Ip.GetAddress();
-			Buffer.Dump(title);
+			Dump(title.c_str(), Buffer.data(), Buffer.size());
 		}
 	}
 
@@ -273,7 +273,7 @@ void CBMProtocol::HandleKeepalives(void)
 			Send(disconnect, peer->GetIp());
 
 			// remove it
-			std::cout << "BM peer " << peer->GetCallsign() << " keepalive timeout" << std::endl;
+			CLogLine(ELogLevel::info, "bm-keepalive-timeout") << "BM peer " << peer->GetCallsign() << " keepalive timeout";
 			peers->RemovePeer(peer);
 		}
 	}
@@ -302,7 +302,7 @@ void CBMProtocol::HandlePeerLinks(void)
 			// send disconnect packet
 			EncodeDisconnectPacket(&buffer);
 			Send(buffer, peer->GetIp());
-			std::cout << "Sending disconnect packet to BM peer " << peer->GetCallsign() << std::endl;
+			CLogLine(ELogLevel::info, "bm-disconnect") << "Sending disconnect packet to BM peer " << peer->GetCallsign();
 			// remove client
 			peers->RemovePeer(peer);
 		}
@@ -318,7 +318,7 @@ void CBMProtocol::HandlePeerLinks(void)
 			// send connect packet to re-initiate peer link
 			EncodeConnectPacket(&buffer, it->second.GetModules().c_str());
 			Send(buffer, it->second.GetIp(), m_Port);
-			std::cout << "Sending connect packet to BM peer " << cs << " @ " << it->second.GetIp() << " for modules " << it->second.GetModules() << std::endl;
+			CLogLine(ELogLevel::info, "bm-connect") << "Sending connect packet to BM peer " << cs << " @ " << it->second.GetIp() << " for modules " << it->second.GetModules();
 		}
 	}
 
@@ -376,7 +376,7 @@ void CBMProtocol::OnDvHeaderPacketIn(std::unique_ptr<CDvHeaderPacket> &Header, c
 ////////////////////////////////////////////////////////////////////////////////////////
 // packet decoding helpers
 
-bool CBMProtocol::IsValidDvHeaderPacket(const CBuffer &Buffer, std::unique_ptr<CDvHeaderPacket> &header)
+bool CBMProtocol::IsValidDvHeaderPacket(const CBufferView &Buffer, std::unique_ptr<CDvHeaderPacket> &header)
 {
 	if ( 56==Buffer.size() && 0==Buffer.Compare((uint8_t *)"DSVT", 4) && 0x10U==Buffer.data()[4] && 0x20U==Buffer.data()[8] )
 	{
@@ -389,7 +389,7 @@ bool CBMProtocol::IsValidDvHeaderPacket(const CBuffer &Buffer, std::unique_ptr<C
 	return false;
 }
 
-bool CBMProtocol::IsValidKeepAlivePacket(const CBuffer &Buffer, CCallsign *callsign)
+bool CBMProtocol::IsValidKeepAlivePacket(const CBufferView &Buffer, CCallsign *callsign)
 {
 	bool valid = false;
 	if (Buffer.size() == 9)
@@ -401,7 +401,7 @@ bool CBMProtocol::IsValidKeepAlivePacket(const CBuffer &Buffer, CCallsign *calls
 }
 
 
-bool CBMProtocol::IsValidConnectPacket(const CBuffer &Buffer, CCallsign *callsign, char *modules, CVersion *version)
+bool CBMProtocol::IsValidConnectPacket(const CBufferView &Buffer, CCallsign *callsign, char *modules, CVersion *version)
 {
 	bool valid = false;
 	if ((Buffer.size() == 39) && (Buffer.data()[0] == 'L') && (Buffer.data()[38] == 0))
@@ -418,7 +418,7 @@ bool CBMProtocol::IsValidConnectPacket(const CBuffer &Buffer, CCallsign *callsig
 	return valid;
 }
 
-bool CBMProtocol::IsValidDisconnectPacket(const CBuffer &Buffer, CCallsign *callsign)
+bool CBMProtocol::IsValidDisconnectPacket(const CBufferView &Buffer, CCallsign *callsign)
 {
 	bool valid = false;
 	if ((Buffer.size() == 10) && (Buffer.data()[0] == 'U') && (Buffer.data()[9] == 0))
@@ -429,7 +429,7 @@ bool CBMProtocol::IsValidDisconnectPacket(const CBuffer &Buffer, CCallsign *call
 	return valid;
 }
 
-bool CBMProtocol::IsValidAckPacket(const CBuffer &Buffer, CCallsign *callsign, char *modules, CVersion *version)
+bool CBMProtocol::IsValidAckPacket(const CBufferView &Buffer, CCallsign *callsign, char *modules, CVersion *version)
 {
 	bool valid = false;
 	if ((Buffer.size() == 39) && (Buffer.data()[0] == 'A') && (Buffer.data()[38] == 0))
@@ -446,7 +446,7 @@ bool CBMProtocol::IsValidAckPacket(const CBuffer &Buffer, CCallsign *callsign, c
 	return valid;
 }
 
-bool CBMProtocol::IsValidNackPacket(const CBuffer &Buffer, CCallsign *callsign)
+bool CBMProtocol::IsValidNackPacket(const CBufferView &Buffer, CCallsign *callsign)
 {
 	bool valid = false;
 	if ((Buffer.size() == 10) && (Buffer.data()[0] == 'N') && (Buffer.data()[9] == 0))
@@ -457,7 +457,7 @@ bool CBMProtocol::IsValidNackPacket(const CBuffer &Buffer, CCallsign *callsign)
 	return valid;
 }
 
-bool CBMProtocol::IsValidDvFramePacket(const CBuffer &Buffer, std::unique_ptr<CDvFramePacket> &dvframe)
+bool CBMProtocol::IsValidDvFramePacket(const CBufferView &Buffer, std::unique_ptr<CDvFramePacket> &dvframe)
 {
 	if ( 45==Buffer.size() && 0==Buffer.Compare((uint8_t *)"DSVT", 4) && 0x20U==Buffer.data()[4] && 0x20U==Buffer.data()[8] )
 	{
@@ -52,13 +52,13 @@ protected:
 	void OnDvHeaderPacketIn(std::unique_ptr<CDvHeaderPacket> &, const CIp &);
 
 	// packet decoding helpers
-	bool IsValidDvHeaderPacket(const CBuffer &, std::unique_ptr<CDvHeaderPacket> &);
-	bool IsValidKeepAlivePacket(const CBuffer &, CCallsign *);
-	bool IsValidConnectPacket(const CBuffer &, CCallsign *, char *, CVersion *);
-	bool IsValidDisconnectPacket(const CBuffer &, CCallsign *);
-	bool IsValidAckPacket(const CBuffer &, CCallsign *, char *, CVersion *);
-	bool IsValidNackPacket(const CBuffer &, CCallsign *);
-	bool IsValidDvFramePacket(const CBuffer &, std::unique_ptr<CDvFramePacket> &);
+	bool IsValidDvHeaderPacket(const CBufferView &, std::unique_ptr<CDvHeaderPacket> &);
+	bool IsValidKeepAlivePacket(const CBufferView &, CCallsign *);
+	bool IsValidConnectPacket(const CBufferView &, CCallsign *, char *, CVersion *);
+	bool IsValidDisconnectPacket(const CBufferView &, CCallsign *);
+	bool IsValidAckPacket(const CBufferView &, CCallsign *, char *, CVersion *);
+	bool IsValidNackPacket(const CBufferView &, CCallsign *);
+	bool IsValidDvFramePacket(const CBufferView &, std::unique_ptr<CDvFramePacket> &);
 
 	// packet encoding helpers
 	void EncodeKeepAlivePacket(CBuffer *);
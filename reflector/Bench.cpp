@@ -0,0 +1,913 @@
+// urfd -- The universal reflector
+// Copyright © 2024 Thomas A. Early N7TAE
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+// A micro-benchmark for the FEC and framing kernels used by the protocol
+// encoders and decoders. The output mimics Google Benchmark: every kernel
+// is run until it has used at least the minimum time and is reported in
+// nanoseconds per operation and operations per second. Decode kernels run
+// over a pool of codewords with random errors injected, and the fraction
+// of pool entries that decoded back to the original data is also reported,
+// so a faster kernel that corrects less can be seen. The ID database parsers
+// are timed on a whole file, a real one if it's given, and report the
+// fraction of its lines that were accepted. The GateKeeper's list matching
+// is timed on a made up black list.
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <random>
+#include <functional>
+#include <algorithm>
+#include <cstring>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+#include <set>
+#include <unistd.h>
+
+#include "Global.h"
+#include "BlackWhiteSet.h"
+#include "CsvLine.h"
+#include "Golay24128.h"
+#include "Golay2087.h"
+#include "QR1676.h"
+#include "RS129.h"
+#include "BPTC19696.h"
+#include "Hamming.h"
+#include "YSFDefines.h"
+#include "YSFConvolution.h"
+#include "YSFFich.h"
+#include "YSFPayload.h"
+#include "DMRAmbe.h"
+#include "CRC.h"
+#include "M17CRC.h"
+
+////////////////////////////////////////////////////////////////////////////////////////
+// global objects needed by CCallsign
+
+SJsonKeys   g_Keys;
+CConfigure  g_Configure;
+CLookupDmr  g_LDid;
+CLookupNxdn g_LNid;
+CLookupYsf  g_LYtr;
+CFileWatcher g_FileWatcher;
+
+////////////////////////////////////////////////////////////////////////////////////////
+// harness
+
+// the number of distinct inputs each kernel cycles through
+#define BENCH_POOL_SIZE 1024
+
+// the lines in a made up DMR ID database, about the size of the radioid.net one
+#define BENCH_IDDB_LINES 250000
+
+// the entries in a made up black list, one in ten a wildcard
+#define BENCH_BWSET_ENTRIES 5000
+
+// a kernel runs its operation n times and returns something derived from
+// the results, so the compiler can't throw the work away
+using BenchKernel = std::function<unsigned(uint64_t n)>;
+
+struct SBenchmark
+{
+	std::string name;
+	BenchKernel kernel;
+	double ok;          // fraction of the pool that round-tripped, negative if not applicable
+};
+
+static std::vector<SBenchmark> g_Benchmarks;
+static std::mt19937 g_Rng(20240101u);
+static volatile unsigned g_Sink;
+
+static void Register(const std::string &name, BenchKernel kernel, double ok = -1.0)
+{
+	g_Benchmarks.push_back({ name, kernel, ok });
+}
+
+// flip count distinct bits chosen from the candidate bit positions
+static void InjectErrors(uint8_t *data, const std::vector<unsigned> &positions, unsigned count)
+{
+	std::vector<unsigned> pos(positions);
+	std::shuffle(pos.begin(), pos.end(), g_Rng);
+	for (unsigned i=0; i<count && i<pos.size(); i++)
+		data[pos[i] / 8] ^= (0x80u >> (pos[i] % 8));
+}
+
+static std::vector<unsigned> BitRange(unsigned first, unsigned last)
+{
+	std::vector<unsigned> v;
+	for (unsigned i=first; i<last; i++)
+		v.push_back(i);
+	return v;
+}
+
+static double Elapsed(const BenchKernel &kernel, uint64_t n)
+{
+	auto start = std::chrono::steady_clock::now();
+	g_Sink = g_Sink + kernel(n);
+	std::chrono::duration<double> d = std::chrono::steady_clock::now() - start;
+	return d.count();
+}
+
+static void Run(const SBenchmark &bm, double min_time)
+{
+	// grow the iteration count until a run is long enough to be timed reliably
+	uint64_t n = 1;
+	double t = Elapsed(bm.kernel, n);
+	while (t < min_time)
+	{
+		double scale = (t > 0.0) ? (1.4 * min_time / t) : 10.0;
+		if (scale > 10.0)
+			scale = 10.0;
+		if (scale < 2.0)
+			scale = 2.0;
+		n = uint64_t(n * scale);
+		t = Elapsed(bm.kernel, n);
+	}
+
+	const double ns = 1.0e9 * t / double(n);
+	std::cout << std::left << std::setw(36) << bm.name << std::right << std::fixed
+		<< std::setw(12) << std::setprecision(1) << ns
+		<< std::setw(14) << n
+		<< std::setw(16) << std::setprecision(0) << (1.0e9 / ns);
+	if (bm.ok >= 0.0)
+		std::cout << std::setw(9) << std::setprecision(1) << (100.0 * bm.ok) << '%';
+	std::cout << std::endl;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////
+// Golay, QR and RS codes
+
+static void AddGolayBenchmarks(unsigned errors)
+{
+	static std::vector<unsigned> data(BENCH_POOL_SIZE), code(BENCH_POOL_SIZE);
+	// decode24128 drops the parity bit and corrects up to three errors in the rest
+	const auto positions = BitRange(1, 24);
+	unsigned ok = 0;
+	for (unsigned i=0; i<BENCH_POOL_SIZE; i++)
+	{
+		data[i] = g_Rng() & 0xFFFu;
+		auto pos(positions);
+		std::shuffle(pos.begin(), pos.end(), g_Rng);
+		code[i] = CGolay24128::encode24128(data[i]);
+		for (unsigned e=0; e<errors && e<pos.size(); e++)
+			code[i] ^= 1u << pos[e];
+		if (CGolay24128::decode24128(code[i]) == data[i])
+			ok++;
+	}
+
+	Register("Golay24128/encode", [](uint64_t n) {
+		unsigned r = 0;
+		for (uint64_t i=0; i<n; i++)
+			r ^= CGolay24128::encode24128(data[i % BENCH_POOL_SIZE]);
+		return r;
+	});
+	Register("Golay24128/decode", [](uint64_t n) {
+		unsigned r = 0;
+		for (uint64_t i=0; i<n; i++)
+			r ^= CGolay24128::decode24128(code[i % BENCH_POOL_SIZE]);
+		return r;
+	}, double(ok) / BENCH_POOL_SIZE);
+}
+
+static void AddGolay2087Benchmarks(unsigned errors)
+{
+	static std::vector<uint8_t> data(BENCH_POOL_SIZE), code(3 * BENCH_POOL_SIZE);
+	// the decoder reads 19 bits: all of byte 0 and 1 and the top three bits of byte 2
+	const auto positions = BitRange(0, 19);
+	unsigned ok = 0;
+	for (unsigned i=0; i<BENCH_POOL_SIZE; i++)
+	{
+		uint8_t *c = &code[3 * i];
+		data[i] = c[0] = g_Rng() & 0xFFu;
+		CGolay2087::encode(c);
+		InjectErrors(c, positions, errors);
+		if (CGolay2087::decode(c) == data[i])
+			ok++;
+	}
+
+	Register("Golay2087/encode", [](uint64_t n) {
+		unsigned r = 0;
+		uint8_t c[3];
+		for (uint64_t i=0; i<n; i++)
+		{
+			c[0] = data[i % BENCH_POOL_SIZE];
+			CGolay2087::encode(c);
+			r ^= c[1];
+		}
+		return r;
+	});
+	Register("Golay2087/decode", [](uint64_t n) {
+		unsigned r = 0;
+		for (uint64_t i=0; i<n; i++)
+			r ^= CGolay2087::decode(&code[3 * (i % BENCH_POOL_SIZE)]);
+		return r;
+	}, double(ok) / BENCH_POOL_SIZE);
+}
+
+static void AddQR1676Benchmarks(unsigned errors)
+{
+	static std::vector<uint8_t> data(BENCH_POOL_SIZE), code(2 * BENCH_POOL_SIZE);
+	// the decoder reads 15 bits
+	const auto positions = BitRange(0, 15);
+	unsigned ok = 0;
+	for (unsigned i=0; i<BENCH_POOL_SIZE; i++)
+	{
+		uint8_t *c = &code[2 * i];
+		data[i] = g_Rng() & 0x7Fu;
+		c[0] = data[i] << 1;
+		CQR1676::encode(c);
+		// the decoder hands back the first byte of the codeword
+		const uint8_t expected = c[0];
+		InjectErrors(c, positions, errors);
+		if (CQR1676::decode(c) == expected)
+			ok++;
+	}
+
+	Register("QR1676/encode", [](uint64_t n) {
+		unsigned r = 0;
+		uint8_t c[2];
+		for (uint64_t i=0; i<n; i++)
+		{
+			c[0] = data[i % BENCH_POOL_SIZE] << 1;
+			CQR1676::encode(c);
+			r ^= c[1];
+		}
+		return r;
+	});
+	Register("QR1676/decode", [](uint64_t n) {
+		unsigned r = 0;
+		for (uint64_t i=0; i<n; i++)
+			r ^= CQR1676::decode(&code[2 * (i % BENCH_POOL_SIZE)]);
+		return r;
+	}, double(ok) / BENCH_POOL_SIZE);
+}
+
+static void AddRS129Benchmarks()
+{
+	static std::vector<uint8_t> lc(12 * BENCH_POOL_SIZE);
+	for (unsigned i=0; i<BENCH_POOL_SIZE; i++)
+	{
+		uint8_t *p = &lc[12 * i];
+		for (unsigned j=0; j<9; j++)
+			p[j] = g_Rng() & 0xFFu;
+		uint8_t parity[4];
+		CRS129::encode(p, 9, parity);
+		p[9]  = parity[2];
+		p[10] = parity[1];
+		p[11] = parity[0];
+	}
+
+	Register("RS129/encode", [](uint64_t n) {
+		unsigned r = 0;
+		uint8_t parity[4];
+		for (uint64_t i=0; i<n; i++)
+		{
+			CRS129::encode(&lc[12 * (i % BENCH_POOL_SIZE)], 9, parity);
+			r ^= parity[0];
+		}
+		return r;
+	});
+	Register("RS129/check", [](uint64_t n) {
+		unsigned r = 0;
+		for (uint64_t i=0; i<n; i++)
+			r += CRS129::check(&lc[12 * (i % BENCH_POOL_SIZE)]) ? 1 : 0;
+		return r;
+	});
+}
+
+////////////////////////////////////////////////////////////////////////////////////////
+// DMR block codes
+
+static void AddBPTC19696Benchmarks(unsigned errors)
+{
+	static std::vector<uint8_t> lc(12 * BENCH_POOL_SIZE), payload(33 * BENCH_POOL_SIZE);
+	// the 196 coded bits are split either side of the 48 bit sync/slot type gap
+	std::vector<unsigned> positions = BitRange(0, 98);
+	for (unsigned i=166; i<264; i++)
+		positions.push_back(i);
+
+	CBPTC19696 bptc;
+	unsigned ok = 0;
+	for (unsigned i=0; i<BENCH_POOL_SIZE; i++)
+	{
+		uint8_t *in = &lc[12 * i];
+		uint8_t *out = &payload[33 * i];
+		for (unsigned j=0; j<12; j++)
+			in[j] = g_Rng() & 0xFFu;
+		memset(out, 0, 33);
+		bptc.encode(in, out);
+		InjectErrors(out, positions, errors);
+		uint8_t check[12];
+		bptc.decode(out, check);
+		if (0 == memcmp(check, in, 12))
+			ok++;
+	}
+
+	Register("BPTC19696/encode", [](uint64_t n) {
+		CBPTC19696 bptc;
+		uint8_t out[33];
+		memset(out, 0, sizeof(out));
+		unsigned r = 0;
+		for (uint64_t i=0; i<n; i++)
+		{
+			bptc.encode(&lc[12 * (i % BENCH_POOL_SIZE)], out);
+			r ^= out[0];
+		}
+		return r;
+	});
+	Register("BPTC19696/decode", [](uint64_t n) {
+		CBPTC19696 bptc;
+		uint8_t out[12];
+		unsigned r = 0;
+		for (uint64_t i=0; i<n; i++)
+		{
+			bptc.decode(&payload[33 * (i % BENCH_POOL_SIZE)], out);
+			r ^= out[0];
+		}
+		return r;
+	}, double(ok) / BENCH_POOL_SIZE);
+}
+
+static void AddHammingBenchmarks(unsigned errors)
+{
+	// Hamming codes only correct a single error
+	const unsigned e = (errors > 1) ? 1 : errors;
+	static std::vector<bool> clean(15 * BENCH_POOL_SIZE), noisy(15 * BENCH_POOL_SIZE);
+	unsigned ok = 0;
+	for (unsigned i=0; i<BENCH_POOL_SIZE; i++)
+	{
+		bool d[15];
+		for (unsigned j=0; j<11; j++)
+			d[j] = g_Rng() & 1u;
+		CHamming::encode15113_2(d);
+		bool c[15];
+		memcpy(c, d, sizeof(c));
+		if (e)
+			c[g_Rng() % 15] ^= true;
+		for (unsigned j=0; j<15; j++)
+		{
+			clean[15 * i + j] = d[j];
+			noisy[15 * i + j] = c[j];
+		}
+		CHamming::decode15113_2(c);
+		if (0 == memcmp(c, d, 11))
+			ok++;
+	}
+
+	Register("Hamming15113/encode", [](uint64_t n) {
+		bool d[15];
+		unsigned r = 0;
+		for (uint64_t i=0; i<n; i++)
+		{
+			const unsigned base = 15 * (i % BENCH_POOL_SIZE);
+			for (unsigned j=0; j<11; j++)
+				d[j] = clean[base + j];
+			CHamming::encode15113_2(d);
+			r ^= d[14] ? 1 : 0;
+		}
+		return r;
+	});
+	Register("Hamming15113/decode", [](uint64_t n) {
+		bool d[15];
+		unsigned r = 0;
+		for (uint64_t i=0; i<n; i++)
+		{
+			const unsigned base = 15 * (i % BENCH_POOL_SIZE);
+			for (unsigned j=0; j<15; j++)
+				d[j] = noisy[base + j];
+			r += CHamming::decode15113_2(d) ? 1 : 0;
+		}
+		return r;
+	}, double(ok) / BENCH_POOL_SIZE);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////
+// YSF framing
+
+static void AddYSFBenchmarks(unsigned errors)
+{
+	static std::vector<uint8_t> fich(YSF_FICH_LENGTH_BYTES * BENCH_POOL_SIZE), frames(YSF_FRAME_LENGTH_BYTES * BENCH_POOL_SIZE), dts(10 * BENCH_POOL_SIZE);
+
+	// the DCH of a VD mode 2 frame is five 5 byte blocks with a stride of 18 bytes
+	std::vector<unsigned> dchpos;
+	for (unsigned b=0; b<5; b++)
+		for (unsigned i=0; i<40; i++)
+			dchpos.push_back(8 * (YSF_SYNC_LENGTH_BYTES + YSF_FICH_LENGTH_BYTES + 18 * b) + i);
+	const auto fichpos = BitRange(0, 8 * YSF_FICH_LENGTH_BYTES);
+
+	unsigned fichok = 0, dtok = 0;
+	for (unsigned i=0; i<BENCH_POOL_SIZE; i++)
+	{
+		CYSFFICH Fich;
+		Fich.setFI(YSF_FI_COMMUNICATIONS);
+		Fich.setCS(2U);
+		Fich.setFN(i % 8);
+		Fich.setFT(7U);
+		Fich.setDev(false);
+		Fich.setMR(YSF_MR_BUSY);
+		Fich.setDT(YSF_DT_VD_MODE2);
+		Fich.setSQL(false);
+		Fich.setSQ(0U);
+		uint8_t *f = &fich[YSF_FICH_LENGTH_BYTES * i];
+		memset(f, 0, YSF_FICH_LENGTH_BYTES);
+		Fich.encode(f);
+		InjectErrors(f, fichpos, errors);
+		CYSFFICH check;
+		if (check.decode(f) && check.getFN() == (i % 8))
+			fichok++;
+
+		uint8_t *dt = &dts[10 * i];
+		for (unsigned j=0; j<10; j++)
+			dt[j] = 'A' + (g_Rng() % 26);
+		uint8_t *frame = &frames[YSF_FRAME_LENGTH_BYTES * i];
+		memset(frame, 0, YSF_FRAME_LENGTH_BYTES);
+		CYSFPayload payload;
+		payload.writeVDMode2Data(frame, dt);
+		InjectErrors(frame, dchpos, errors);
+		uint8_t out[20];
+		if (payload.readVDMode2Data(frame, out) && 0 == memcmp(out, dt, 10))
+			dtok++;
+	}
+
+	Register("YSFFICH/encode", [](uint64_t n) {
+		CYSFFICH Fich;
+		Fich.setFI(YSF_FI_COMMUNICATIONS);
+		Fich.setCS(2U);
+		Fich.setFT(7U);
+		Fich.setDT(YSF_DT_VD_MODE2);
+		uint8_t out[YSF_FICH_LENGTH_BYTES];
+		memset(out, 0, sizeof(out));
+		unsigned r = 0;
+		for (uint64_t i=0; i<n; i++)
+		{
+			Fich.setFN(i % 8);
+			Fich.encode(out);
+			r ^= out[0];
+		}
+		return r;
+	});
+	Register("YSFFICH/decode", [](uint64_t n) {
+		CYSFFICH Fich;
+		unsigned r = 0;
+		for (uint64_t i=0; i<n; i++)
+			r += Fich.decode(&fich[YSF_FICH_LENGTH_BYTES * (i % BENCH_POOL_SIZE)]) ? 1 : 0;
+		return r;
+	}, double(fichok) / BENCH_POOL_SIZE);
+	Register("YSFConvolution/encode", [](uint64_t n) {
+		CYSFConvolution conv;
+		uint8_t out[25];
+		unsigned r = 0;
+		for (uint64_t i=0; i<n; i++)
+		{
+			conv.encode(&dts[10 * (i % BENCH_POOL_SIZE)], out, 80U);
+			r ^= out[0];
+		}
+		return r;
+	});
+	Register("YSFPayload/writeVDMode2", [](uint64_t n) {
+		CYSFPayload payload;
+		uint8_t frame[YSF_FRAME_LENGTH_BYTES];
+		memset(frame, 0, sizeof(frame));
+		unsigned r = 0;
+		for (uint64_t i=0; i<n; i++)
+		{
+			payload.writeVDMode2Data(frame, &dts[10 * (i % BENCH_POOL_SIZE)]);
+			r ^= frame[YSF_SYNC_LENGTH_BYTES + YSF_FICH_LENGTH_BYTES];
+		}
+		return r;
+	});
+	Register("YSFPayload/readVDMode2", [](uint64_t n) {
+		CYSFPayload payload;
+		uint8_t out[20];
+		unsigned r = 0;
+		for (uint64_t i=0; i<n; i++)
+			r += payload.readVDMode2Data(&frames[YSF_FRAME_LENGTH_BYTES * (i % BENCH_POOL_SIZE)], out) ? 1 : 0;
+		return r;
+	}, double(dtok) / BENCH_POOL_SIZE);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////
+// AMBE+2 interleave
+
+static void AddAmbeBenchmarks()
+{
+	// random vocoder parameters, and the frames they encode to
+	static std::vector<unsigned> params(3 * BENCH_POOL_SIZE);
+	static std::vector<uint8_t> frames(9 * BENCH_POOL_SIZE);
+	unsigned ok = 0;
+	for (unsigned i=0; i<BENCH_POOL_SIZE; i++)
+	{
+		unsigned *p = &params[3 * i];
+		p[0] = g_Rng() & 0xFFFu;
+		p[1] = g_Rng() & 0xFFFu;
+		p[2] = g_Rng() & 0x1FFFFFFu;
+		CDmrAmbe::Encode(p[0], p[1], p[2], &frames[9 * i]);
+		unsigned a, b, c;
+		CDmrAmbe::Decode(&frames[9 * i], a, b, c);
+		if (a == p[0] && b == p[1] && c == p[2])
+			ok++;
+	}
+
+	Register("DMRAmbe/encode", [](uint64_t n) {
+		uint8_t frame[9];
+		unsigned r = 0;
+		for (uint64_t i=0; i<n; i++)
+		{
+			const unsigned *p = &params[3 * (i % BENCH_POOL_SIZE)];
+			CDmrAmbe::Encode(p[0], p[1], p[2], frame);
+			r ^= frame[4];
+		}
+		return r;
+	});
+	Register("DMRAmbe/decode", [](uint64_t n) {
+		unsigned r = 0;
+		for (uint64_t i=0; i<n; i++)
+		{
+			unsigned a, b, c;
+			CDmrAmbe::Decode(&frames[9 * (i % BENCH_POOL_SIZE)], a, b, c);
+			r ^= a ^ b ^ c;
+		}
+		return r;
+	}, double(ok) / BENCH_POOL_SIZE);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////
+// checksums
+
+static void AddCRCBenchmarks()
+{
+	// a DMR LC sized block for the CCITT and CRC8 checks, and an M17 LSF sized block
+	static std::vector<uint8_t> blocks(30 * BENCH_POOL_SIZE);
+	for (auto &b : blocks)
+		b = g_Rng() & 0xFFu;
+
+	Register("CRC/addCCITT162", [](uint64_t n) {
+		uint8_t buf[12];
+		unsigned r = 0;
+		for (uint64_t i=0; i<n; i++)
+		{
+			memcpy(buf, &blocks[30 * (i % BENCH_POOL_SIZE)], 10);
+			CCRC::addCCITT162(buf, 12U);
+			r ^= buf[11];
+		}
+		return r;
+	});
+	Register("CRC/checkCCITT162", [](uint64_t n) {
+		unsigned r = 0;
+		for (uint64_t i=0; i<n; i++)
+			r += CCRC::checkCCITT162(&blocks[30 * (i % BENCH_POOL_SIZE)], 12U) ? 1 : 0;
+		return r;
+	});
+	Register("CRC/crc8", [](uint64_t n) {
+		unsigned r = 0;
+		for (uint64_t i=0; i<n; i++)
+			r ^= CCRC::crc8(&blocks[30 * (i % BENCH_POOL_SIZE)], 12U);
+		return r;
+	});
+	Register("M17CRC/lsf", [](uint64_t n) {
+		static const CM17CRC crc;
+		unsigned r = 0;
+		for (uint64_t i=0; i<n; i++)
+			r ^= crc.CalcCRC(&blocks[30 * (i % BENCH_POOL_SIZE)], 28);
+		return r;
+	});
+}
+
+////////////////////////////////////////////////////////////////////////////////////////
+// ID database parsing
+
+// the way CLookupDmr parsed a line before it had CCsvLine
+static bool GetlineParse(const std::string &line, uint32_t &id, UCallsign &key)
+{
+	auto l = atol(line.c_str());
+	if (0L < l && l <= 9999999L)
+	{
+		auto p1 = line.find(';');
+		if (std::string::npos != p1)
+		{
+			auto p2 = line.find(';', ++p1);
+			if (std::string::npos != p2)
+			{
+				const auto cs_str(line.substr(p1, p2-p1));
+				CCallsign cs;
+				cs.SetCallsign(cs_str, false);
+				if (cs.IsValid())
+				{
+					id = uint32_t(l);
+					key = cs.GetKey();
+					return true;
+				}
+			}
+		}
+	}
+	return false;
+}
+
+static bool ScanParse(std::string_view line, uint32_t &id, UCallsign &key)
+{
+	CCsvLine csv(line, ';');
+	std::string_view id_str, cs_str;
+	unsigned long l;
+	if (csv.Next(id_str) && CCsvLine::Number(id_str, l) && 0UL < l && l <= 9999999UL
+		&& csv.Next(cs_str) && csv.More() && CCallsign::MakeKey(cs_str.data(), cs_str.size(), key))
+	{
+		id = uint32_t(l);
+		return true;
+	}
+	return false;
+}
+
+static void AddIdDbBenchmarks(const std::string &path)
+{
+	static std::string text;
+	if (path.size())
+	{
+		std::ifstream file(path, std::ios::binary);
+		if (! file)
+		{
+			std::cerr << "Can't read " << path << ", using a made up database" << std::endl;
+		}
+		else
+		{
+			text.assign((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+		}
+	}
+	if (text.empty())
+	{
+		// id;callsign;name; with a few bad lines, like the xlxapi export
+		std::ostringstream ss;
+		for (unsigned i=0; i<BENCH_IDDB_LINES; i++)
+		{
+			ss << (1000000 + g_Rng() % 8999999) << ';';
+			if (0 == g_Rng() % 100)
+				ss << "n0-call";
+			else
+			{
+				for (unsigned j = 1 + g_Rng() % 2; j; j--)
+					ss << char('A' + g_Rng() % 26);
+				ss << char('0' + g_Rng() % 10);
+				for (unsigned j = 1 + g_Rng() % 3; j; j--)
+					ss << char('A' + g_Rng() % 26);
+			}
+			ss << ";Firstname Lastname;\n";
+		}
+		text.assign(ss.str());
+	}
+
+	unsigned lines = 0, getlineok = 0, scanok = 0;
+	{
+		std::istringstream iss(text);
+		std::string line;
+		uint32_t id, id2;
+		UCallsign key, key2;
+		while (std::getline(iss, line))
+		{
+			lines++;
+			const bool a = GetlineParse(line, id, key);
+			const bool b = ScanParse(line, id2, key2);
+			getlineok += a ? 1 : 0;
+			scanok += b ? 1 : 0;
+			if (a != b || (a && (id != id2 || key.l != key2.l)))
+				std::cerr << "The ID database parsers disagree on: " << line << std::endl;
+		}
+	}
+	std::cout << "ID database: " << lines << " lines, " << text.size() << " bytes" << std::endl;
+
+	Register("IdDb/getline", [](uint64_t n) {
+		unsigned r = 0;
+		for (uint64_t i=0; i<n; i++)
+		{
+			std::istringstream iss(text);
+			std::string line;
+			uint32_t id;
+			UCallsign key;
+			while (std::getline(iss, line))
+				if (GetlineParse(line, id, key))
+					r += id ^ unsigned(key.l);
+		}
+		return r;
+	}, lines ? double(getlineok) / lines : 0.0);
+	Register("IdDb/scan", [](uint64_t n) {
+		unsigned r = 0;
+		for (uint64_t i=0; i<n; i++)
+		{
+			const char *p = text.data(), *end = p + text.size();
+			uint32_t id;
+			UCallsign key;
+			while (p < end)
+			{
+				auto nl = static_cast<const char *>(memchr(p, '\n', end - p));
+				if (nullptr == nl)
+					nl = end;
+				if (ScanParse(std::string_view(p, nl - p), id, key))
+					r += id ^ unsigned(key.l);
+				p = nl + 1;
+			}
+		}
+		return r;
+	}, lines ? double(scanok) / lines : 0.0);
+}
+
+// a few stations taking turns, the way a busy module looks. The databases here are
+// empty, so this is the cost of reaching them, not of searching them.
+static void AddCallsignBenchmarks()
+{
+	static const std::string stations[] = { "N7TAE", "K2DLS", "W1ABC", "G4XYZ", "DL1AAA", "VK2BBB", "JA1CCC", "KB1DDD" };
+
+	Register("Callsign/lookup", [](uint64_t n) {
+		unsigned r = 0;
+		for (uint64_t i=0; i<n; i++)
+		{
+			const CCallsign cs(stations[i % 8], 1, 1);
+			const auto key = cs.GetKey();
+			r += g_LDid.FindDmrid(key) + g_LNid.FindNXDNid(key);
+		}
+		return r;
+	});
+	Register("Callsign/construct", [](uint64_t n) {
+		unsigned r = 0;
+		for (uint64_t i=0; i<n; i++)
+		{
+			const CCallsign cs(stations[i % 8]);
+			r += cs.GetDmrid() + cs.GetNXDNid();
+		}
+		return r;
+	});
+}
+
+// how CBlackWhiteSet::IsMatched() searched before the lists were compiled
+static bool LinearMatch(const std::set<std::string> &list, const std::string &cs)
+{
+	for ( const auto &item : list )
+	{
+		auto pos = item.find('*');
+		switch (pos)
+		{
+			case 0:
+				return true;
+			case std::string::npos:
+				if (0 == item.compare(cs))
+					return true;
+				break;
+			default:
+				if (0 == item.compare(0, pos, cs, 0, pos))
+					return true;
+				break;
+		}
+	}
+	return false;
+}
+
+static std::string RandomCallsign()
+{
+	std::string cs;
+	for (unsigned j = 1 + g_Rng() % 2; j; j--)
+		cs.push_back(char('A' + g_Rng() % 26));
+	cs.push_back(char('0' + g_Rng() % 10));
+	for (unsigned j = 1 + g_Rng() % 3; j; j--)
+		cs.push_back(char('A' + g_Rng() % 26));
+	return cs;
+}
+
+static void AddBlackWhiteSetBenchmarks()
+{
+	static std::set<std::string> list;
+	static CBlackWhiteSet set;
+	static std::vector<std::string> queries;
+
+	char path[] = "/tmp/benchbwsetXXXXXX";
+	int fd = mkstemp(path);
+	if (fd < 0)
+	{
+		std::cerr << "Can't make a black list in /tmp" << std::endl;
+		return;
+	}
+	std::ostringstream ss;
+	while (list.size() < BENCH_BWSET_ENTRIES)
+	{
+		auto cs = RandomCallsign();
+		if (0 == g_Rng() % 10)
+			cs = cs.substr(0, 1 + g_Rng() % 3) + '*';
+		if (list.insert(cs).second)
+			ss << cs << '\n';
+	}
+	const auto text = ss.str();
+	bool written = text.size() == size_t(write(fd, text.data(), text.size()));
+	close(fd);
+	written = written && set.LoadFromFile(path);
+	unlink(path);
+	if (! written)
+		return;
+
+	// mostly callsigns that aren't listed, which is what a black list usually sees
+	unsigned agree = 0;
+	for (unsigned i=0; i<BENCH_POOL_SIZE; i++)
+	{
+		queries.push_back((0 == i % 8) ? *std::next(list.begin(), g_Rng() % list.size()) : RandomCallsign());
+		if (LinearMatch(list, queries.back()) == set.IsMatched(queries.back()))
+			agree++;
+		else
+			std::cerr << "The list matchers disagree on: " << queries.back() << std::endl;
+	}
+
+	Register("BlackWhiteSet/linear", [](uint64_t n) {
+		unsigned r = 0;
+		for (uint64_t i=0; i<n; i++)
+			r += LinearMatch(list, queries[i % BENCH_POOL_SIZE]) ? 1 : 0;
+		return r;
+	}, double(agree) / BENCH_POOL_SIZE);
+	Register("BlackWhiteSet/compiled", [](uint64_t n) {
+		unsigned r = 0;
+		for (uint64_t i=0; i<n; i++)
+			r += set.IsMatched(queries[i % BENCH_POOL_SIZE]) ? 1 : 0;
+		return r;
+	}, double(agree) / BENCH_POOL_SIZE);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+static void usage(std::ostream &os, const char *name)
+{
+	os << "\nUsage: " << name << " [OPTIONS]\n";
+	os << "OPTIONS\n"
+		"    --filter=STRING   : Only run benchmarks whose name contains STRING.\n"
+		"    --min_time=SECS   : Minimum run time for each benchmark (default 0.5).\n"
+		"    --errors=N        : Bit errors injected into each codeword before decoding (default 2).\n"
+		"    --seed=N          : Seed for the random data and error positions.\n"
+		"    --iddb=FILE       : A DMR ID database (id;callsign;...) to time the parsers on.\n\n";
+}
+
+int main(int argc, char *argv[])
+{
+	std::string filter;
+	double min_time = 0.5;
+	unsigned errors = 2;
+	std::string iddb;
+
+	for (int i=1; i<argc; i++)
+	{
+		const std::string arg(argv[i]);
+		if (0 == arg.compare(0, 9, "--filter="))
+			filter.assign(arg.substr(9));
+		else if (0 == arg.compare(0, 11, "--min_time="))
+			min_time = std::atof(arg.substr(11).c_str());
+		else if (0 == arg.compare(0, 9, "--errors="))
+			errors = unsigned(std::atoi(arg.substr(9).c_str()));
+		else if (0 == arg.compare(0, 7, "--seed="))
+			g_Rng.seed(unsigned(std::atol(arg.substr(7).c_str())));
+		else if (0 == arg.compare(0, 7, "--iddb="))
+			iddb.assign(arg.substr(7));
+		else
+		{
+			usage(std::cerr, argv[0]);
+			return EXIT_FAILURE;
+		}
+	}
+
+	AddGolayBenchmarks(errors);
+	AddGolay2087Benchmarks(errors);
+	AddQR1676Benchmarks(errors);
+	AddRS129Benchmarks();
+	AddBPTC19696Benchmarks(errors);
+	AddHammingBenchmarks(errors);
+	AddYSFBenchmarks(errors);
+	AddAmbeBenchmarks();
+	AddCRCBenchmarks();
+	AddIdDbBenchmarks(iddb);
+	AddCallsignBenchmarks();
+	AddBlackWhiteSetBenchmarks();
+
+	std::cout << "Injected bit errors per codeword: " << errors << std::endl;
+	std::cout << std::string(87, '-') << std::endl;
+	std::cout << std::left << std::setw(36) << "Benchmark" << std::right
+		<< std::setw(12) << "ns/op"
+		<< std::setw(14) << "Iterations"
+		<< std::setw(16) << "ops/sec"
+		<< std::setw(10) << "Decoded" << std::endl;
+	std::cout << std::string(87, '-') << std::endl;
+
+	for (const auto &bm : g_Benchmarks)
+	{
+		if (filter.empty() || std::string::npos != bm.name.find(filter))
+			Run(bm, min_time);
+	}
+
+	return EXIT_SUCCESS;
+}
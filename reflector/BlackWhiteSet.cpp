@@ -27,7 +27,6 @@
 #include <fstream>
 #include <string.h>
 #include <fcntl.h>
-#include <sys/stat.h>
 
 #include "BlackWhiteSet.h"
 
@@ -43,10 +42,9 @@ bool CBlackWhiteSet::LoadFromFile(const std::string &filename)
 	std::ifstream file(filename);
 	if ( file.is_open() )
 	{
-		Lock();
-
-		// empty list
-		m_Callsigns.clear();
+		// compile a new list off to the side
+		auto matcher = std::make_shared<SMatcher>();
+		std::unordered_set<std::string> entries;
 		// fill with file content
 		while ( file.getline(sz, sizeof(sz)).good()  )
 		{
@@ -60,9 +58,9 @@ bool CBlackWhiteSet::LoadFromFile(const std::string &filename)
 				if ( (szt = strtok(szt, " ,\t")) != nullptr )
 				{
 					std::string cs(ToUpper(szt));
-					if (m_Callsigns.end() == m_Callsigns.find(cs))
+					if (entries.insert(cs).second)
 					{
-						m_Callsigns.insert(cs);
+						matcher->Add(cs);
 					}
 					else
 					{
@@ -77,13 +75,10 @@ bool CBlackWhiteSet::LoadFromFile(const std::string &filename)
 		// keep file path
 		m_Filename = filename;
 
-		// update time
-		GetLastModTime(&m_LastModTime);
-
-		// and done
-		Unlock();
+		// and publish
+		std::atomic_store(&m_Matcher, std::shared_ptr<const SMatcher>(std::move(matcher)));
 		ok = true;
-		std::cout << "Gatekeeper loaded " << m_Callsigns.size() << " lines from " << filename <<  std::endl;
+		std::cout << "Gatekeeper loaded " << entries.size() << " lines from " << filename <<  std::endl;
 	}
 	else
 	{
@@ -104,39 +99,82 @@ bool CBlackWhiteSet::ReloadFromFile(void)
 	return ok;
 }
 
-bool CBlackWhiteSet::NeedReload(void)
+////////////////////////////////////////////////////////////////////////////////////////
+// compare
+
+bool CBlackWhiteSet::empty() const
 {
-	bool needReload = false;
+	auto matcher = std::atomic_load(&m_Matcher);
+	return (! matcher) || 0 == matcher->size;
+}
 
-	time_t time;
-	if ( GetLastModTime(&time) )
-	{
-		needReload = time != m_LastModTime;
-	}
-	return needReload;
+bool CBlackWhiteSet::IsMatched(const std::string &cs) const
+{
+	auto matcher = std::atomic_load(&m_Matcher);
+	return matcher && matcher->IsMatched(cs);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////
-// compare
+// the compiled list
 
-bool CBlackWhiteSet::IsMatched(const std::string &cs) const
+CBlackWhiteSet::SMatcher::SMatcher() : size(0)
+{
+	trie.push_back(STrieNode{});	// the root
+}
+
+void CBlackWhiteSet::SMatcher::Add(const std::string &entry)
 {
-	for ( const auto &item : m_Callsigns )
+	size++;
+	// anything after the wildcard has never mattered
+	auto pos = entry.find('*');
+	if (std::string::npos == pos)
 	{
-		auto pos = item.find('*');
-		switch (pos)
+		exact.insert(entry);
+		return;
+	}
+
+	uint32_t n = 0;
+	for (std::size_t i = 0; i < pos; i++)
+	{
+		const unsigned c = uint8_t(entry[i]) - BWSET_TRIE_FIRST;
+		if (c >= BWSET_TRIE_FANOUT)
+		{
+			odd.push_back(entry.substr(0, pos));
+			return;
+		}
+		if (0 == trie[n].next[c])
 		{
-			case 0:
-				return true;
-			case std::string::npos:
-				if (0 == item.compare(cs))
-					return true;
-				break;
-			default:
-				if (0 == item.compare(0, pos, cs, 0, pos))
-					return true;
-				break;
+			trie[n].next[c] = uint32_t(trie.size());
+			trie.push_back(STrieNode{});	// this may move the nodes, so index, don't point
 		}
+		n = trie[n].next[c];
+	}
+	trie[n].end = true;
+}
+
+bool CBlackWhiteSet::SMatcher::IsMatched(const std::string &cs) const
+{
+	if (exact.end() != exact.find(cs))
+		return true;
+
+	// does any wildcard entry's prefix start the callsign?
+	uint32_t n = 0;
+	for (std::size_t i = 0; ; i++)
+	{
+		if (trie[n].end)
+			return true;
+		if (i == cs.size())
+			break;
+		const unsigned c = uint8_t(cs[i]) - BWSET_TRIE_FIRST;
+		if (c >= BWSET_TRIE_FANOUT || 0 == trie[n].next[c])
+			break;
+		n = trie[n].next[c];
+	}
+
+	for (const auto &prefix : odd)
+	{
+		if (0 == cs.compare(0, prefix.size(), prefix))
+			return true;
 	}
 	return false;
 }
@@ -165,22 +203,6 @@ char *CBlackWhiteSet::TrimWhiteSpaces(char *str)
 	return str;
 }
 
-bool CBlackWhiteSet::GetLastModTime(time_t *time)
-{
-	bool ok = false;
-
-	if ( !m_Filename.empty() )
-	{
-		struct stat fileStat;
-		if( ::stat(m_Filename.c_str(), &fileStat) != -1 )
-		{
-			*time = fileStat.st_mtime;
-			ok = true;
-		}
-	}
-	return ok;
-}
-
 char *CBlackWhiteSet::ToUpper(char *str)
 {
 	constexpr auto diff = 'a' - 'A';
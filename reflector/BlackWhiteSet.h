@@ -20,42 +20,66 @@
 
 #pragma once
 
-#include <set>
+#include <atomic>
+#include <cstdint>
+#include <memory>
 #include <string>
-#include <mutex>
+#include <unordered_set>
+#include <vector>
+
+// the characters a wildcard entry's prefix is walked on, ' ' to '_', which covers
+// upper case letters, digits and the punctuation found in callsigns
+#define BWSET_TRIE_FIRST    ' '
+#define BWSET_TRIE_FANOUT   64
 
 ////////////////////////////////////////////////////////////////////////////////////////
 // class
+//
+// A white or black list is compiled when it's loaded: entries without a '*' go in a
+// hash set, and the part of a wildcard entry before its '*' goes in a prefix trie, so
+// a callsign is checked in time proportional to its length, however long the list.
+// The compiled list is published with an atomic swap, the same as the ID databases,
+// so IsMatched() takes no lock and a reload never holds up a header.
 
 class CBlackWhiteSet
 {
 public:
 	// constructor
-	CBlackWhiteSet() : m_LastModTime(0) {}
-
-	// locks
-	void Lock(void)   const { m_Mutex.lock(); }
-	void Unlock(void) const { m_Mutex.unlock(); }
+	CBlackWhiteSet() {}
 
-	// file io
+	// file io, only from one thread at a time
 	bool LoadFromFile(const std::string &filename);
 	bool ReloadFromFile(void);
-	bool NeedReload(void);
 
 	// pass-through
-	bool empty() const { return m_Callsigns.empty(); }
+	bool empty() const;
 
 	// compare
 	bool IsMatched(const std::string &) const;
 
 protected:
-	bool GetLastModTime(time_t *);
 	char *TrimWhiteSpaces(char *);
 	char *ToUpper(char *str);
 
+	struct STrieNode
+	{
+		uint32_t next[BWSET_TRIE_FANOUT];	// 0 is no child, the root is never one
+		bool     end;						// a wildcard entry's prefix ends here
+	};
+
+	struct SMatcher
+	{
+		SMatcher();
+		void Add(const std::string &entry);
+		bool IsMatched(const std::string &cs) const;
+
+		std::unordered_set<std::string> exact;
+		std::vector<STrieNode> trie;
+		std::vector<std::string> odd;	// prefixes with a character the trie can't hold
+		std::size_t size;
+	};
+
 	// data
-	mutable std::mutex  m_Mutex;
 	std::string m_Filename;
-	time_t m_LastModTime;
-	std::set<std::string> m_Callsigns;
+	std::shared_ptr<const SMatcher> m_Matcher;	// only touched with std::atomic_load/store
 };
@@ -17,66 +17,133 @@
 // along with this program.  If not, see <https://www.gnu.org/licenses/>.
 
 #include <iostream>
+#include <stdexcept>
 #include <string.h>
 #include "Buffer.h"
 
+////////////////////////////////////////////////////////////////////////////////////////
+// view
+
+uint8_t CBufferView::at(unsigned i) const
+{
+	if ( i >= m_len )
+	{
+		throw std::out_of_range("CBufferView::at");
+	}
+	return m_ptr[i];
+}
+
+int CBufferView::Compare(const uint8_t *buffer, unsigned off, unsigned len) const
+{
+	int result = -1;
+	if ( m_len >= off+len )
+	{
+		result = memcmp(m_ptr+off, buffer, len);
+	}
+	return result;
+}
+
+CBufferView CBufferView::Sub(unsigned off, unsigned len) const
+{
+	if ( off >= m_len )
+	{
+		return CBufferView();
+	}
+	if ( len > m_len-off )
+	{
+		len = m_len-off;
+	}
+	return CBufferView(m_ptr+off, len);
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////
 // constructor
 
-CBuffer::CBuffer(uint8_t *buffer, int len)
+CBuffer::CBuffer(const uint8_t *buffer, int len) : m_size(0), m_overflow(false), m_npatches(0)
+{
+	Set(buffer, len);
+}
+
+CBuffer::CBuffer(const CBuffer &Buffer)
+{
+	*this = Buffer;
+}
+
+// only the bytes in use are copied
+CBuffer &CBuffer::operator =(const CBuffer &Buffer)
 {
-	m_data.resize(len);
-	memcpy(m_data.data(), buffer, len);
+	if ( this != &Buffer )
+	{
+		m_size = Buffer.m_size;
+		m_overflow = Buffer.m_overflow;
+		m_npatches = Buffer.m_npatches;
+		memcpy(m_data, Buffer.m_data, m_size);
+		for ( unsigned i = 0; i < m_npatches; i++ )
+		{
+			m_patches[i] = Buffer.m_patches[i];
+		}
+	}
+	return *this;
+}
+
+bool CBuffer::Fits(unsigned off, unsigned len)
+{
+	if ( (off > BUFFER_LENMAX) || (len > BUFFER_LENMAX-off) )
+	{
+		m_overflow = true;
+		return false;
+	}
+	return true;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////
 // set
 
-void CBuffer::Set(uint8_t *buffer, int len)
+void CBuffer::Set(const uint8_t *buffer, int len)
 {
-	m_data.resize(len);
-	memcpy(m_data.data(), buffer, len);
+	m_size = 0;
+	m_overflow = false;
+	Append(buffer, len);
 }
 
 void CBuffer::Set(const char *sz)
 {
-	m_data.resize(::strlen(sz)+1);
-	::strcpy((char *)m_data.data(), sz);
+	m_size = 0;
+	m_overflow = false;
+	Append((const uint8_t *)sz, (int)::strlen(sz)+1);
 }
 
 void CBuffer::Append(const uint8_t *buffer, int len)
 {
-	int n = (int)m_data.size();
-	m_data.resize(n+len);
-	memcpy(&(m_data.data()[n]), buffer, len);
+	if ( (len > 0) && Fits(m_size, len) )
+	{
+		memcpy(m_data+m_size, buffer, len);
+		m_size += len;
+	}
 }
 
 void CBuffer::Append(uint8_t ui, int len)
 {
-	int n = (int)m_data.size();
-	m_data.resize(n+len);
-	memset(&(m_data.data()[n]), ui, len);
+	if ( (len > 0) && Fits(m_size, len) )
+	{
+		memset(m_data+m_size, ui, len);
+		m_size += len;
+	}
 }
 
 void CBuffer::Append(uint8_t ui)
 {
-	int n = (int)m_data.size();
-	m_data.resize(n+sizeof(uint8_t));
-	memcpy(&(m_data.data()[n]), &ui, sizeof(uint8_t));
+	Append(&ui, sizeof(uint8_t));
 }
 
 void CBuffer::Append(uint16_t ui)
 {
-	int n = (int)m_data.size();
-	m_data.resize(n+sizeof(uint16_t));
-	memcpy(&(m_data.data()[n]), &ui, sizeof(uint16_t));
+	Append((const uint8_t *)&ui, sizeof(uint16_t));
 }
 
 void CBuffer::Append(uint32_t ui)
 {
-	int n = (int)m_data.size();
-	m_data.resize(n+sizeof(uint32_t));
-	memcpy(&(m_data.data()[n]), &ui, sizeof(uint32_t));
+	Append((const uint8_t *)&ui, sizeof(uint32_t));
 }
 
 void CBuffer::Append(const char *sz)
@@ -87,38 +154,93 @@ void CBuffer::Append(const char *sz)
 
 void CBuffer::ReplaceAt(int i, uint8_t ui)
 {
-	if ( m_data.size() < (i+sizeof(uint8_t)) )
+	ReplaceAt(i, &ui, sizeof(uint8_t));
+}
+
+void CBuffer::ReplaceAt(int i, uint16_t ui)
+{
+	ReplaceAt(i, (const uint8_t *)&ui, sizeof(uint16_t));
+}
+
+void CBuffer::ReplaceAt(int i, uint32_t ui)
+{
+	ReplaceAt(i, (const uint8_t *)&ui, sizeof(uint32_t));
+}
+
+void CBuffer::ReplaceAt(int i, const uint8_t *ptr, int len)
+{
+	if ( (i < 0) || (len < 0) || ! Fits(i, len) )
 	{
-		m_data.resize(i+sizeof(uint8_t));
+		m_overflow = true;
+		return;
 	}
-	*(uint8_t *)(&(m_data.data()[i])) = ui;
+	if ( m_size < unsigned(i+len) )
+	{
+		// like resize, any gap is zero filled
+		if ( m_size < unsigned(i) )
+		{
+			memset(m_data+m_size, 0, i-m_size);
+		}
+		m_size = i+len;
+	}
+	memcpy(m_data+i, ptr, len);
 }
 
-void CBuffer::ReplaceAt(int i, uint16_t ui)
+void CBuffer::resize(unsigned len, uint8_t val)
 {
-	if ( m_data.size() < (i+sizeof(uint16_t)) )
+	if ( ! Fits(0, len) )
 	{
-		m_data.resize(i+sizeof(uint16_t));
+		len = BUFFER_LENMAX;
 	}
-	*(uint16_t *)(&(m_data.data()[i])) = ui;
+	if ( len > m_size )
+	{
+		memset(m_data+m_size, val, len-m_size);
+	}
+	m_size = len;
 }
 
-void CBuffer::ReplaceAt(int i, uint32_t ui)
+void CBuffer::SetSize(unsigned len)
+{
+	m_size = (len > BUFFER_LENMAX) ? BUFFER_LENMAX : len;
+	m_overflow = false;
+}
+
+uint8_t CBuffer::at(unsigned i) const
 {
-	if ( m_data.size() < (i+sizeof(uint32_t)) )
+	if ( i >= m_size )
 	{
-		m_data.resize(i+sizeof(uint32_t));
+		throw std::out_of_range("CBuffer::at");
 	}
-	*(uint32_t *)(&(m_data.data()[i])) = ui;
+	return m_data[i];
 }
 
-void CBuffer::ReplaceAt(int i, const uint8_t *ptr, int len)
+////////////////////////////////////////////////////////////////////////////////////////
+// patch
+
+void CBuffer::AddPatch(int offset, int len)
+{
+	if ( (len > 0) && (len <= (int)sizeof(uint32_t)) && (m_npatches < BUFFER_PATCHMAX) )
+	{
+		m_patches[m_npatches++] = std::make_pair(offset, len);
+	}
+}
+
+// write value into the field, most significant byte first
+void CBuffer::Patch(unsigned index, uint32_t value)
 {
-	if ( m_data.size() < unsigned(i+len) )
+	if ( index < m_npatches )
 	{
-		m_data.resize(i+len);
+		const int offset = m_patches[index].first;
+		const int len = m_patches[index].second;
+		if ( m_size >= unsigned(offset+len) )
+		{
+			for ( int i = len-1; i >= 0; i-- )
+			{
+				m_data[offset+i] = (uint8_t)(value & 0xFF);
+				value >>= 8;
+			}
+		}
 	}
-	memcpy(&(m_data.data()[i]), ptr, len);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////
@@ -127,9 +249,9 @@ void CBuffer::ReplaceAt(int i, const uint8_t *ptr, int len)
 int CBuffer::Compare(uint8_t *buffer, int len) const
 {
 	int result = -1;
-	if ( m_data.size() >= unsigned(len) )
+	if ( m_size >= unsigned(len) )
 	{
-		result = memcmp(m_data.data(), buffer, len);
+		result = memcmp(m_data, buffer, len);
 	}
 	return result;
 }
@@ -137,9 +259,9 @@ int CBuffer::Compare(uint8_t *buffer, int len) const
 int CBuffer::Compare(uint8_t *buffer, int off, int len) const
 {
 	int result = -1;
-	if ( m_data.size() >= unsigned(off+len) )
+	if ( m_size >= unsigned(off+len) )
 	{
-		result = memcmp(&(m_data.data()[off]), buffer, len);
+		result = memcmp(m_data+off, buffer, len);
 	}
 	return result;
 }
@@ -150,25 +272,25 @@ int CBuffer::Compare(uint8_t *buffer, int off, int len) const
 
 bool CBuffer::operator ==(const CBuffer &Buffer) const
 {
-	if ( m_data.size() == Buffer.m_data.size() )
+	if ( m_size == Buffer.m_size )
 	{
-		return (memcmp((const char *)m_data.data(), (const char *)Buffer.m_data.data(), m_data.size()) == 0);
+		return (memcmp(m_data, Buffer.m_data, m_size) == 0);
 	}
 	return false;
 }
 
 bool CBuffer::operator ==(const char *sz) const
 {
-	if ( m_data.size() == ::strlen(sz) )
+	if ( m_size == ::strlen(sz) )
 	{
-		return (memcmp((const char *)m_data.data(), sz, m_data.size()) == 0);
+		return (memcmp(m_data, sz, m_size) == 0);
 	}
 	return false;
 }
 
 CBuffer::operator const char *() const
 {
-	return (const char *)m_data.data();
+	return (const char *)m_data;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////
@@ -177,13 +299,13 @@ CBuffer::operator const char *() const
 void CBuffer::DebugDump(std::ofstream &debugout) const
 {
 	// dump a hex line
-	for ( unsigned int i = 0; i < m_data.size(); i++ )
+	for ( unsigned int i = 0; i < m_size; i++ )
 	{
 		char sz[16];
-		//sprintf(sz, "%02X", m_data.data()[i]);
-		sprintf(sz, "0x%02X", m_data.data()[i]);
+		//sprintf(sz, "%02X", m_data[i]);
+		sprintf(sz, "0x%02X", m_data[i]);
 		debugout << sz;
-		if ( i == m_data.size()-1 )
+		if ( i == m_size-1 )
 		{
 			debugout << std::endl;
 		}
@@ -197,9 +319,9 @@ void CBuffer::DebugDump(std::ofstream &debugout) const
 void CBuffer::DebugDumpAscii(std::ofstream &debugout) const
 {
 	// dump an ascii line
-	for ( unsigned int i = 0; i < m_data.size(); i++ )
+	for ( unsigned int i = 0; i < m_size; i++ )
 	{
-		char c = m_data.data()[i];
+		char c = m_data[i];
 		if ( isascii(c) )
 		{
 			debugout << c;
@@ -208,55 +330,9 @@ void CBuffer::DebugDumpAscii(std::ofstream &debugout) const
 		{
 			debugout << '.';
 		}
-		if ( i == m_data.size()-1 )
+		if ( i == m_size-1 )
 		{
 			debugout << std::endl;
 		}
 	}
 }
-
-void CBuffer::Dump(const std::string &title)
-{
-	std::cout << title << ":" << std::endl;
-
-	unsigned int offset = 0U;
-	unsigned int length = m_data.size();
-
-	while (length > 0U) {
-		std::string output;
-
-		unsigned int bytes = (length > 16U) ? 16U : length;
-
-		char temp[10U];
-		for (unsigned i = 0U; i < bytes; i++) {
-			::sprintf(temp, "%02X ", m_data[offset + i]);
-			output += temp;
-		}
-
-		for (unsigned int i = bytes; i < 16U; i++)
-			output += "   ";
-
-		output += "   *";
-
-		for (unsigned i = 0U; i < bytes; i++) {
-			unsigned char c = m_data[offset + i];
-
-			if (::isprint(c))
-				output += c;
-			else
-				output += '.';
-		}
-
-		output += '*';
-
-		::sprintf(temp, "%04X:  ", offset);
-		std::cout << temp << output << std::endl;
-
-		offset += 16U;
-
-		if (length >= 16U)
-			length -= 16U;
-		else
-			length = 0U;
-	}
-}
@@ -18,23 +18,67 @@
 
 #pragma once
 
-#include <vector>
 #include <fstream>
 #include <cstdint>
+#include <cstring>
+#include <string>
+#include <utility>
+
+// the largest datagram that any protocol sends or receives
+#define BUFFER_LENMAX       1024
+// the most per recipient fields in one buffer
+#define BUFFER_PATCHMAX     4
+
+class CBuffer;
 
 ////////////////////////////////////////////////////////////////////////////////////////
+// a read only window on bytes that belong to someone else, for parsing.
+// A received CBuffer converts to one, so a packet is validated and decoded where it landed.
+
+class CBufferView
+{
+public:
+	CBufferView() : m_ptr(nullptr), m_len(0) {}
+	CBufferView(const uint8_t *ptr, unsigned len) : m_ptr(ptr), m_len(len) {}
+	CBufferView(const CBuffer &);
+
+	// get
+	const uint8_t *data() const { return m_ptr; }
+	unsigned size() const { return m_len; }
+	bool empty() const { return 0 == m_len; }
+	uint8_t operator[](unsigned i) const { return m_ptr[i]; }
+	uint8_t at(unsigned i) const;
+
+	// operation
+	bool StartsWith(const uint8_t *tag, unsigned len) const { return (m_len >= len) && (0 == memcmp(m_ptr, tag, len)); }
+	int Compare(const uint8_t *tag, unsigned len) const { return (m_len >= len) ? memcmp(m_ptr, tag, len) : -1; }
+	int Compare(const uint8_t *, unsigned off, unsigned len) const;
+	CBufferView Sub(unsigned off, unsigned len) const;
+
+protected:
+	const uint8_t *m_ptr;
+	unsigned       m_len;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
+// a datagram, held inline so that building or receiving one never touches the heap.
+// Writes that would go past BUFFER_LENMAX are dropped and mark the buffer Overflowed().
 
 class CBuffer
 {
 public:
-	CBuffer() {}
-	CBuffer(uint8_t *, int);
+	CBuffer() : m_size(0), m_overflow(false), m_npatches(0) {}
+	CBuffer(const uint8_t *, int);
+	CBuffer(const CBuffer &);
 
 	// destructor
 	virtual ~CBuffer() {};
 
+	// copy
+	CBuffer &operator =(const CBuffer &);
+
 	// set
-	void Set(uint8_t *, int);
+	void Set(const uint8_t *, int);
 	void Set(const char *);
 	void Append(const uint8_t *, int);
 	void Append(uint8_t, int);
@@ -47,9 +91,17 @@ public:
 	void ReplaceAt(int, uint32_t);
 	void ReplaceAt(int, const uint8_t *, int);
 
+	// per recipient fields, so an encoded packet can be sent to many clients
+	void AddPatch(int offset, int len);
+	void Patch(unsigned index, uint32_t value);
+	void ClearPatches(void) { m_npatches = 0; }
+	unsigned PatchCount(void) const { return m_npatches; }
+
 	// operation
 	int Compare(uint8_t *, int) const;
 	int Compare(uint8_t *, int, int) const;
+	CBufferView View(unsigned off = 0) const { return (off < m_size) ? CBufferView(m_data+off, m_size-off) : CBufferView(); }
+	bool Overflowed(void) const { return m_overflow; }
 
 	// operator
 	bool operator ==(const CBuffer &) const;
@@ -59,17 +111,28 @@ public:
 	// debug
 	void DebugDump(std::ofstream &) const;
 	void DebugDumpAscii(std::ofstream &) const;
-	void Dump(const std::string &title);
 
 	// pass through
-	void clear() { m_data.clear(); }
-	void reserve(unsigned int size) { m_data.reserve(size); }
-	std::vector<uint8_t>::size_type size() const { return m_data.size(); }
-	uint8_t *data() { return m_data.data(); }
-	const uint8_t *data() const { return m_data.data(); }
-	void resize(std::vector<uint8_t>::size_type len, uint8_t val = 0) { m_data.resize(len, val); }
-	uint8_t at(std::vector<uint8_t>::size_type i) const { return m_data.at(i); }
+	void clear() { m_size = 0; m_overflow = false; }
+	void reserve(unsigned int) {}
+	unsigned size() const { return m_size; }
+	static constexpr unsigned capacity() { return BUFFER_LENMAX; }
+	uint8_t *data() { return m_data; }
+	const uint8_t *data() const { return m_data; }
+	void resize(unsigned len, uint8_t val = 0);
+	// after writing up to capacity() bytes directly into data(), like a socket read
+	void SetSize(unsigned len);
+	uint8_t at(unsigned i) const;
 
 protected:
-	std::vector<uint8_t> m_data;
+	// true if len bytes fit at off, otherwise the buffer is marked as overflowed
+	bool Fits(unsigned off, unsigned len);
+
+	uint8_t  m_data[BUFFER_LENMAX];
+	unsigned m_size;
+	bool     m_overflow;
+	std::pair<int, int> m_patches[BUFFER_PATCHMAX];  // offset and length of each field
+	unsigned m_npatches;
 };
+
+inline CBufferView::CBufferView(const CBuffer &buf) : m_ptr(buf.data()), m_len(buf.size()) {}
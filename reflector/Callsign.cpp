@@ -20,11 +20,87 @@
 #include <string.h>
 #include <cctype>
 #include "Global.h"
+#include "IdCache.h"
 #include "Callsign.h"
 
 // if a client is using special characters '.', '-' or '/', he's out of luck!
 #define M17CHARACTERS " ABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789-/."
 
+////////////////////////////////////////////////////////////////////////////////////////
+// id resolution
+//
+// Callsigns are built for every header, every keepalive and every entry in the heard
+// list, and almost always for the same few stations. Each thread keeps its own recent
+// answers, so those don't go back to the shared databases. A miss is remembered too:
+// most callsigns aren't in the DMR or NXDN databases at all.
+
+struct SIdCaches
+{
+	CIdCache<uint64_t, uint32_t> dmrid;     // callsign key to DMR id, 0 if there's none
+	CIdCache<uint32_t, uint64_t> dmrcs;     // DMR id to callsign key, 0 if there's none
+	CIdCache<uint64_t, uint16_t> nxdnid;
+	CIdCache<uint16_t, uint64_t> nxdncs;
+};
+
+static thread_local SIdCaches t_IdCaches;
+
+static uint32_t CachedDmrid(const UCallsign &key)
+{
+	auto &cache = t_IdCaches.dmrid;
+	cache.Validate(g_LDid.GetGeneration());
+	uint32_t id;
+	if (! cache.Find(key.l, id))
+	{
+		id = g_LDid.FindDmrid(key);
+		cache.Insert(key.l, id);
+	}
+	return id;
+}
+
+static uint16_t CachedNXDNid(const UCallsign &key)
+{
+	auto &cache = t_IdCaches.nxdnid;
+	cache.Validate(g_LNid.GetGeneration());
+	uint16_t id;
+	if (! cache.Find(key.l, id))
+	{
+		id = g_LNid.FindNXDNid(key);
+		cache.Insert(key.l, id);
+	}
+	return id;
+}
+
+// like the lookups' FindCallsign(), ucs is left alone if the id isn't there
+static void CachedDmrCallsign(uint32_t dmrid, UCallsign &ucs)
+{
+	auto &cache = t_IdCaches.dmrcs;
+	cache.Validate(g_LDid.GetGeneration());
+	uint64_t l;
+	if (! cache.Find(dmrid, l))
+	{
+		UCallsign found;
+		l = g_LDid.FindCallsign(dmrid, found) ? found.l : 0;
+		cache.Insert(dmrid, l);
+	}
+	if (l)
+		ucs.l = l;
+}
+
+static void CachedNXDNCallsign(uint16_t nxdnid, UCallsign &ucs)
+{
+	auto &cache = t_IdCaches.nxdncs;
+	cache.Validate(g_LNid.GetGeneration());
+	uint64_t l;
+	if (! cache.Find(nxdnid, l))
+	{
+		UCallsign found;
+		l = g_LNid.FindCallsign(nxdnid, found) ? found.l : 0;
+		cache.Insert(nxdnid, l);
+	}
+	if (l)
+		ucs.l = l;
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////
 // constructors
 
@@ -56,46 +132,30 @@ CCallsign::CCallsign(const std::string &cs, uint32_t dmrid, uint16_t nxdnid) : C
 		auto key = GetKey();
 		if (0 == m_uiDmrid)
 		{
-			g_LDid.Lock();
-			m_uiDmrid = g_LDid.FindDmrid(key);
-			g_LDid.Unlock();
+			m_uiDmrid = CachedDmrid(key);
 		}
 
 		if (0 == m_uiNXDNid)
 		{
-			g_LNid.Lock();
-			m_uiNXDNid = g_LNid.FindNXDNid(key);
-			g_LNid.Unlock();
+			m_uiNXDNid = CachedNXDNid(key);
 		}
 	}
 	else if (dmrid)
 	{
-		g_LDid.Lock();
-		auto pItem = g_LDid.FindCallsign(dmrid);
-		if (pItem)
-			m_Callsign = *pItem;
-		g_LDid.Unlock();
+		CachedDmrCallsign(dmrid, m_Callsign);
 
 		if (m_Callsign.l && 0 == nxdnid)
 		{
-			g_LNid.Lock();
-			m_uiNXDNid = g_LNid.FindNXDNid(GetKey());
-			g_LNid.Unlock();
+			m_uiNXDNid = CachedNXDNid(GetKey());
 		}
 	}
 	else if (nxdnid)
 	{
-		g_LNid.Lock();
-		auto pItem = g_LNid.FindCallsign(nxdnid);
-		if (pItem)
-			m_Callsign = *pItem;
-		g_LNid.Unlock();
+		CachedNXDNCallsign(nxdnid, m_Callsign);
 
 		if (m_Callsign.l && 0 == dmrid)
 		{
-			g_LDid.Lock();
-			m_uiDmrid = g_LDid.FindDmrid(GetKey());
-			g_LDid.Unlock();
+			m_uiDmrid = CachedDmrid(GetKey());
 		}
 	}
 	if (m_Callsign.l)
@@ -174,6 +234,37 @@ bool CCallsign::IsValid(void) const
 	return valid;
 }
 
+bool CCallsign::MakeKey(const char *s, std::size_t len, UCallsign &key)
+{
+	auto letter = [](char c) { return c >= 'A' && c <= 'Z'; };
+	auto number = [](char c) { return c >= '0' && c <= '9'; };
+
+	UCallsign cs;
+	cs.l = 0x2020202020202020ul;
+	memcpy(cs.c, s, MIN(len, CALLSIGN_LEN-1));
+
+	// the same rules as IsValid(), with a blank suffix
+	int iNum = 0;
+	for (unsigned i = 0; i < CALLSIGN_LEN; i++)
+	{
+		const char c = cs.c[i];
+		if (number(c))
+			iNum += (i < 3) ? 1 : 0;
+		else if (! letter(c) && (i < 3 || ' ' != c))
+			return false;
+	}
+	if (iNum >= 3)
+		return false;
+	if (len >= CALLSIGN_LEN && ! letter(s[len-1]) && ' ' != s[len-1])
+		return false;
+
+	// and the same key as GetKey()
+	key.l = 0x2020202020202020ul;
+	for (unsigned i = 0; i < CALLSIGN_LEN && (letter(cs.c[i]) || number(cs.c[i])); i++)
+		key.c[i] = cs.c[i];
+	return true;
+}
+
 bool CCallsign::HasSuffix(void) const
 {
 	return 0x20202020u != m_Suffix.u;
@@ -199,16 +290,8 @@ void CCallsign::SetCallsign(const std::string &s, bool updateids)
 	if (updateids)
 	{
 		auto key = GetKey();
-		g_LDid.Lock();
-		{
-			m_uiDmrid = g_LDid.FindDmrid(key);
-		}
-		g_LDid.Unlock();
-		g_LNid.Lock();
-		{
-			m_uiNXDNid = g_LNid.FindNXDNid(key);
-		}
-		g_LNid.Unlock();
+		m_uiDmrid = CachedDmrid(key);
+		m_uiNXDNid = CachedNXDNid(key);
 	}
 }
 
@@ -233,16 +316,8 @@ void CCallsign::SetCallsign(const uint8_t *buffer, int len, bool updateids)
 	if (updateids)
 	{
 		auto key = GetKey();
-		g_LDid.Lock();
-		{
-			m_uiDmrid = g_LDid.FindDmrid(key);
-		}
-		g_LDid.Unlock();
-		g_LNid.Lock();
-		{
-			m_uiNXDNid = g_LNid.FindNXDNid(key);
-		}
-		g_LNid.Unlock();
+		m_uiDmrid = CachedDmrid(key);
+		m_uiNXDNid = CachedNXDNid(key);
 	}
 }
 
@@ -251,15 +326,7 @@ void CCallsign::SetDmrid(uint32_t dmrid, bool UpdateCallsign)
 	m_uiDmrid = dmrid;
 	if ( UpdateCallsign )
 	{
-		g_LDid.Lock();
-		{
-			auto callsign = g_LDid.FindCallsign(dmrid);
-			if ( callsign != nullptr )
-			{
-				m_Callsign.l = callsign->l;
-			}
-		}
-		g_LDid.Unlock();
+		CachedDmrCallsign(dmrid, m_Callsign);
 		CSIn();
 	}
 }
@@ -277,15 +344,7 @@ void CCallsign::SetNXDNid(uint16_t nxdnid, bool UpdateCallsign)
 	m_uiNXDNid = nxdnid;
 	if ( UpdateCallsign )
 	{
-		g_LNid.Lock();
-		{
-			auto callsign = g_LNid.FindCallsign(nxdnid);
-			if ( callsign != nullptr )
-			{
-				m_Callsign.l = callsign->l;
-			}
-		}
-		g_LNid.Unlock();
+		CachedNXDNCallsign(nxdnid, m_Callsign);
 		CSIn();
 	}
 }
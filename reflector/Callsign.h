@@ -69,6 +69,10 @@ public:
 	CCallsign(const CCallsign &cs);
 	CCallsign(const std::string &cs, uint32_t dmrid = 0, uint16_t nxdnid = 0);
 
+	// the key SetCallsign(s, false) followed by GetKey() would give, without building a
+	// CCallsign, false if IsValid() would fail. For parsing the lookup databases.
+	static bool MakeKey(const char *s, std::size_t len, UCallsign &key);
+
 	// status
 	bool IsValid(void) const;
 	bool HasSuffix(void) const;
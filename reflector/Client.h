@@ -18,6 +18,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <nlohmann/json.hpp>
 
 #include "Defines.h"
@@ -55,7 +56,7 @@ public:
 
 	// set
 	void SetCSModule(char c)                             { m_Callsign.SetCSModule(c); }
-	void SetReflectorModule(char c)                      { m_ReflectorModule = c; }
+	void SetReflectorModule(char c)                      { m_ReflectorModule = c; s_Changes.fetch_add(1, std::memory_order_release); }
 
 	// identity
 	virtual EProtocol GetProtocol(void) const            { return EProtocol::none; }
@@ -72,11 +73,10 @@ public:
 	virtual bool IsAMaster(void) const                  { return (m_ModuleMastered != ' '); }
 	virtual void SetMasterOfModule(char c)              { m_ModuleMastered = c; }
 	virtual void NotAMaster(void)                       { m_ModuleMastered = ' '; }
-	virtual void Heard(void)                            { m_LastHeardTime = std::time(nullptr); }
+	virtual void Heard(void)                            { m_LastHeardTime = std::time(nullptr); s_Changes.fetch_add(1, std::memory_order_release); }
 
-	// reporting
-	virtual void WriteXml(std::ofstream &);
-	void JsonReport(nlohmann::json &report);
+	// reporting, counts the changes to any client that the status files would show
+	static uint32_t GetChanges(void)                     { return s_Changes.load(std::memory_order_acquire); }
 
 protected:
 	// data
@@ -91,4 +91,6 @@ protected:
 	CTimer      m_LastKeepaliveTime;
 	std::time_t m_ConnectTime;
 	std::time_t m_LastHeardTime;
+
+	static std::atomic<uint32_t> s_Changes;
 };
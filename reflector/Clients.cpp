@@ -23,7 +23,7 @@
 ////////////////////////////////////////////////////////////////////////////////////////
 // constructor
 
-CClients::CClients()
+CClients::CClients() : m_Generation(0)
 {
 }
 
@@ -57,12 +57,15 @@ void CClients::AddClient(std::shared_ptr<CClient> client)
 
 	// and append
 	m_Clients.push_back(client);
-	std::cout << "New client " << client->GetCallsign() << " at " << client->GetIp() << " added with protocol " << client->GetProtocolName();
+	m_Generation.fetch_add(1, std::memory_order_release);
+	if (g_Reflector.IsListening())
+		g_Reflector.Notify("client-link", nlohmann::json{ { "Callsign", client->GetCallsign().GetCS() }, { "IP", client->GetIp().GetAddress() }, { "OnModule", std::string(1, client->GetReflectorModule()) }, { "Protocol", client->GetProtocolName() } });
+	CLogLine line(ELogLevel::info, "client-add");
+	line << "New client" << Field("callsign", client->GetCallsign()) << Field("ip", client->GetIp()) << Field("protocol", client->GetProtocolName());
 	if ( client->GetReflectorModule() != ' ' )
 	{
-		std::cout << " on module " << client->GetReflectorModule();
+		line << Field("module", client->GetReflectorModule());
 	}
-	std::cout << std::endl;
 }
 
 void CClients::RemoveClient(std::shared_ptr<CClient> client)
@@ -78,13 +81,18 @@ void CClients::RemoveClient(std::shared_ptr<CClient> client)
 			if ( !(*it)->IsAMaster() )
 			{
 				// remove it
-				std::cout << "Client " << (*it)->GetCallsign() << " at " << (*it)->GetIp() << " removed with protocol " << (*it)->GetProtocolName();
-				if ( (*it)->GetReflectorModule() != ' ' )
 				{
-					std::cout << " on module " << (*it)->GetReflectorModule();
+					CLogLine line(ELogLevel::info, "client-remove");
+					line << "Client removed" << Field("callsign", (*it)->GetCallsign()) << Field("ip", (*it)->GetIp()) << Field("protocol", (*it)->GetProtocolName());
+					if ( (*it)->GetReflectorModule() != ' ' )
+					{
+						line << Field("module", (*it)->GetReflectorModule());
+					}
 				}
-				std::cout << std::endl;
+				if (g_Reflector.IsListening())
+					g_Reflector.Notify("client-unlink", nlohmann::json{ { "Callsign", client->GetCallsign().GetCS() }, { "IP", client->GetIp().GetAddress() }, { "OnModule", std::string(1, client->GetReflectorModule()) }, { "Protocol", client->GetProtocolName() } });
 				m_Clients.erase(it);
+				m_Generation.fetch_add(1, std::memory_order_release);
 				break;
 			}
 		}
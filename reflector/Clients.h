@@ -18,6 +18,8 @@
 
 #pragma once
 
+#include <atomic>
+
 #include "Client.h"
 
 
@@ -47,6 +49,9 @@ public:
 	void    RemoveClient(std::shared_ptr<CClient>);
 	bool    IsClient(std::shared_ptr<CClient>) const;
 
+	// reporting, counts the changes the status files would show, to the list or to any client in it
+	uint32_t GetGeneration(void) const  { return m_Generation.load(std::memory_order_acquire) + CClient::GetChanges(); }
+
 	// pass-through
 	std::list<std::shared_ptr<CClient>>::iterator begin()              { return m_Clients.begin(); }
 	std::list<std::shared_ptr<CClient>>::iterator end()                { return m_Clients.end(); }
@@ -70,4 +75,5 @@ protected:
 	// data
 	std::mutex           m_Mutex;
 	std::list<std::shared_ptr<CClient>> m_Clients;
+	std::atomic<uint32_t> m_Generation;
 };
@@ -113,7 +113,7 @@ void CCodecStream::Task(void)
 	{
 		if ( m_LocalQueue.IsEmpty() )
 		{
-			std::cout << "Unexpected transcoded packet received from transcoder: Module='" << pack.module << "' StreamID=" << std::hex << std::showbase << ntohs(pack.streamid) << std::endl;
+			CLogLine(ELogLevel::warning, "tc-unexpected") << "Unexpected transcoded packet received from transcoder" << Field("module", pack.module) << HexField("sid", ntohs(pack.streamid));
 		}
 		else if (m_IsOpen)
 		{
@@ -157,15 +157,15 @@ void CCodecStream::Task(void)
 				// Not the correct packet! It will be ignored
 				// Report it
 				if (pack.streamid != Packet->GetCodecPacket()->streamid)
-					std::cerr << std::hex  << std::showbase << "StreamID mismatch: this voice frame=" << ntohs(Packet->GetCodecPacket()->streamid) << " returned transcoder packet=" << ntohs(pack.streamid) << std::dec << std::noshowbase << std::endl;
+					CLogLine(ELogLevel::error, "tc-sid-mismatch") << "StreamID mismatch" << HexField("frame", ntohs(Packet->GetCodecPacket()->streamid)) << HexField("transcoder", ntohs(pack.streamid));
 				if (pack.sequence != Packet->GetCodecPacket()->sequence)
-					std::cerr << "Sequence mismatch: this voice frame=" << Packet->GetCodecPacket()->sequence << " returned transcoder packet=" << pack.sequence << std::endl;
+					CLogLine(ELogLevel::error, "tc-sequence-mismatch") << "Sequence mismatch" << Field("frame", Packet->GetCodecPacket()->sequence) << Field("transcoder", pack.sequence);
 			}
 		}
 		else
 		{
 			// Likewise, this packet will be ignored
-			std::cout << "Transcoder packet received but CodecStream[" << m_CSModule << "] is closed: Module='" << pack.module << "' StreamID=" << std::hex << std::showbase << ntohs(pack.streamid) << std::endl;
+			CLogLine(ELogLevel::warning, "tc-closed") << "Transcoder packet received but CodecStream is closed" << Field("stream", m_CSModule) << Field("module", pack.module) << HexField("sid", ntohs(pack.streamid));
 		}
 	}
 
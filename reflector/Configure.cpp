@@ -34,8 +34,10 @@
 #define JAUTOLINKMODULE          "AutoLinkModule"
 #define JBINDINGADDRESS          "BindingAddress"
 #define JBLACKLISTPATH           "BlacklistPath"
+#define JBANSECONDS              "BanSeconds"
 #define JBOOTSTRAP               "Bootstrap"
 #define JBRANDMEISTER            "Brandmeister"
+#define JBURSTSECONDS            "BurstSeconds"
 #define JCALLSIGN                "Callsign"
 #define JCOUNTRY                 "Country"
 #define JDASHBOARDURL            "DashboardUrl"
@@ -49,6 +51,7 @@
 #define JDMRPLUS                 "DMRPlus"
 #define JDPLUS                   "DPlus"
 #define JENABLE                  "Enable"
+#define JEVENTSPATH              "EventsPath"
 #define JFILES                   "Files"
 #define JFILEPATH                "FilePath"
 #define JG3                      "G3"
@@ -56,6 +59,7 @@
 #define JINTERLINKPATH           "InterlinkPath"
 #define JIPADDRESS               "IPAddress"
 #define JIPADDRESSES             "IP Addresses"
+#define JIPLISTPATH              "IPListPath"
 #define JIPV4BINDING             "IPv4Binding"
 #define JIPV4EXTERNAL            "IPv4External"
 #define JIPV6BINDING             "IPv6Binding"
@@ -72,13 +76,17 @@
 #define JP25                     "P25"
 #define JPIDPATH                 "PidPath"
 #define JPORT                    "Port"
+#define JRATELIMITS              "Rate Limits"
 #define JREFLECTORID             "ReflectorID"
 #define JREFRESHMIN              "RefreshMin"
 #define JREGISTRATIONDESCRIPTION "RegistrationDescription"
 #define JREGISTRATIONID          "RegistrationID"
 #define JREGISTRATIONNAME        "RegistrationName"
 #define JRXPORT                  "RxPort"
+#define JSELECTEDMODULEONLY      "SelectedModuleOnly"
+#define JSOCKETFILTER            "SocketFilter"
 #define JSPONSOR                 "Sponsor"
+#define JSTATUSSERVER            "Status Server"
 #define JSYSOPEMAIL              "SysopEmail"
 #define JTRANSCODER              "Transcoder"
 #define JTXPORT                  "TxPort"
@@ -219,6 +227,10 @@ bool CConfigure::ReadData(const std::string &path)
 				section = ESection::ysffreq;
 			else if (0 == hname.compare(JFILES))
 				section = ESection::files;
+			else if (0 == hname.compare(JRATELIMITS))
+				section = ESection::ratelimit;
+			else if (0 == hname.compare(JSTATUSSERVER))
+				section = ESection::status;
 			else
 			{
 				std::cerr << "WARNING: unknown ini file section: " << line << std::endl;
@@ -362,6 +374,8 @@ bool CConfigure::ReadData(const std::string &path)
 			case ESection::dplus:
 				if (0 == key.compare(JPORT))
 					data[g_Keys.dplus.port] = getUnsigned(value, "DPlus Port", 1024, 65535, 20001);
+				else if (0 == key.compare(JSELECTEDMODULEONLY))
+					data[g_Keys.dplus.selectedmodule] = IS_TRUE(value[0]);
 				else
 					badParam(key);
 				break;
@@ -464,6 +478,8 @@ bool CConfigure::ReadData(const std::string &path)
 				{
 					if ((0==value.compare("file")) || (0==value.compare("http")) || (0==value.compare("both")))
 						data[pdb->mode] = value;
+					else if (0==value.compare("binary") && ESection::ysffreq != section)
+						data[pdb->mode] = value;	// compiled by dbutil
 					else
 					{
 						std::cout << "WARNING: line #" << counter << ": Mode, '" << value << "' not recognized. Setting to 'http'" << std::endl;
@@ -484,17 +500,55 @@ bool CConfigure::ReadData(const std::string &path)
 					data[g_Keys.files.xml] = value;
 				else if (0 == key.compare(JJSONPATH))
 					data[g_Keys.files.json] = value;
+				else if (0 == key.compare(JEVENTSPATH))
+					data[g_Keys.files.events] = value;
 				else if (0 == key.compare(JWHITELISTPATH))
 					data[g_Keys.files.white] = value;
 				else if (0 == key.compare(JBLACKLISTPATH))
 					data[g_Keys.files.black] = value;
 				else if (0 == key.compare(JINTERLINKPATH))
 					data[g_Keys.files.interlink] = value;
+				else if (0 == key.compare(JIPLISTPATH))
+					data[g_Keys.files.iplist] = value;
 				else if (0 == key.compare(JG3TERMINALPATH))
 					data[g_Keys.files.terminal] = value;
 				else
 					badParam(key);
 				break;
+			case ESection::ratelimit:
+				if (0 == key.compare(JSOCKETFILTER))
+					data[g_Keys.ratelimit.filter] = IS_TRUE(value[0]);
+				else if (0 == key.compare(JBURSTSECONDS))
+					data[g_Keys.ratelimit.burst] = getUnsigned(value, "Rate Limits BurstSeconds", 1, 60, 2);
+				else if (0 == key.compare(JBANSECONDS))
+					data[g_Keys.ratelimit.ban] = getUnsigned(value, "Rate Limits BanSeconds", 0, 86400, 60);
+				else
+				{
+					// the rest are packets per second from one address, by protocol
+					bool found = false;
+					for (const auto &item : rateLimits())
+					{
+						if (0 == key.compare(item.name))
+						{
+							data[item.key] = getUnsigned(value, std::string("Rate Limits ") + item.name, 0, 100000, item.rate);
+							found = true;
+							break;
+						}
+					}
+					if (! found)
+						badParam(key);
+				}
+				break;
+			case ESection::status:
+				if (0 == key.compare(JENABLE))
+					data[g_Keys.status.enable] = IS_TRUE(value[0]);
+				else if (0 == key.compare(JPORT))
+					data[g_Keys.status.port] = getUnsigned(value, "Status Server Port", 1, 65535, 8080);
+				else if (0 == key.compare(JBINDINGADDRESS))
+					data[g_Keys.status.bind] = value;
+				else
+					badParam(key);
+				break;
 			default:
 				std::cout << "WARNING: parameter '" << line << "' defined before any [section]" << std::endl;
 		}
@@ -686,6 +740,10 @@ bool CConfigure::ReadData(const std::string &path)
 	isDefined(ErrorLevel::fatal, JM17, JPORT, g_Keys.m17.port, rval);
 	isDefined(ErrorLevel::fatal, JURF, JPORT, g_Keys.urf.port, rval);
 
+	// DPlus
+	if (! data.contains(g_Keys.dplus.selectedmodule))
+		data[g_Keys.dplus.selectedmodule] = false;
+
 	// BM
 	if (isDefined(ErrorLevel::fatal, JBRANDMEISTER, JENABLE, g_Keys.bm.enable, rval))
 	{
@@ -760,6 +818,30 @@ bool CConfigure::ReadData(const std::string &path)
 	isDefined(ErrorLevel::mild, JYSF, JREGISTRATIONNAME, g_Keys.ysf.ysfreflectordb.name, rval);
 	isDefined(ErrorLevel::mild, JYSF, JREGISTRATIONDESCRIPTION, g_Keys.ysf.ysfreflectordb.description, rval);
 
+	// Rate Limits, all of them are optional
+	if (! data.contains(g_Keys.ratelimit.filter))
+		data[g_Keys.ratelimit.filter] = true;
+	if (! data.contains(g_Keys.ratelimit.burst))
+		data[g_Keys.ratelimit.burst] = 2u;
+	if (! data.contains(g_Keys.ratelimit.ban))
+		data[g_Keys.ratelimit.ban] = 60u;
+	for (const auto &item : rateLimits())
+	{
+		if (! data.contains(item.key))
+			data[item.key] = item.rate;
+	}
+
+	// Status Server, optional
+	if (! data.contains(g_Keys.status.enable))
+		data[g_Keys.status.enable] = false;
+	if (GetBoolean(g_Keys.status.enable))
+	{
+		if (! data.contains(g_Keys.status.port))
+			data[g_Keys.status.port] = 8080u;
+		if (! data.contains(g_Keys.status.bind))
+			data[g_Keys.status.bind] = "127.0.0.1";
+	}
+
 	// Databases
 	std::list<std::pair<const std::string, const struct SJsonKeys::DB *>> dbs = {
 		{ JDMRIDDB,   &g_Keys.dmriddb   },
@@ -770,12 +852,13 @@ bool CConfigure::ReadData(const std::string &path)
 	{
 		if (isDefined(ErrorLevel::fatal, item.first, JMODE,       item.second->mode,       rval))
 		{
-			if (ERefreshType::file != GetRefreshType(item.second->mode))
+			const auto type = GetRefreshType(item.second->mode);
+			if (ERefreshType::file != type && ERefreshType::binary != type)
 			{
 				isDefined(ErrorLevel::fatal, item.first, JURL,        item.second->url,        rval);
 				isDefined(ErrorLevel::fatal, item.first, JREFRESHMIN, item.second->refreshmin, rval);
 			}
-			if (ERefreshType::http != GetRefreshType(item.second->mode))
+			if (ERefreshType::http != type)
 			{
 				if (isDefined(ErrorLevel::fatal, item.first, JFILEPATH,   item.second->filepath,   rval))
 					checkFile(item.first, JFILEPATH, data[item.second->filepath]);
@@ -792,6 +875,9 @@ bool CConfigure::ReadData(const std::string &path)
 		checkFile(JFILES, JBLACKLISTPATH, data[g_Keys.files.black]);
 	if (isDefined(ErrorLevel::fatal, JFILES, JINTERLINKPATH, g_Keys.files.interlink, rval))
 		checkFile(JFILES, JINTERLINKPATH, data[g_Keys.files.interlink]);
+	// the IP access list is optional
+	if (data.contains(g_Keys.files.iplist))
+		checkFile(JFILES, JIPLISTPATH, data[g_Keys.files.iplist]);
 	if (data.contains(g_Keys.g3.enable) && GetBoolean(g_Keys.g3.enable))
 	{
 		if (isDefined(ErrorLevel::fatal, JFILES, JG3TERMINALPATH, g_Keys.files.terminal, rval))
@@ -834,12 +920,35 @@ void CConfigure::checkAutoLink(const std::string &section, const std::string &pn
 	}
 }
 
+// the [Rate Limits] protocol keys and their defaults, interlinks aren't limited unless asked
+const std::vector<CConfigure::SRateLimit> &CConfigure::rateLimits() const
+{
+	static const std::vector<SRateLimit> limits = {
+		{ JBRANDMEISTER, g_Keys.ratelimit.bm,      0 },
+		{ JDCS,          g_Keys.ratelimit.dcs,     2000 },
+		{ JDEXTRA,       g_Keys.ratelimit.dextra,  2000 },
+		{ JDMRPLUS,      g_Keys.ratelimit.dmrplus, 200 },
+		{ JDPLUS,        g_Keys.ratelimit.dplus,   2000 },
+		{ JG3,           g_Keys.ratelimit.g3,      200 },
+		{ JM17,          g_Keys.ratelimit.m17,     200 },
+		{ JMMDVM,        g_Keys.ratelimit.mmdvm,   200 },
+		{ JNXDN,         g_Keys.ratelimit.nxdn,    200 },
+		{ JP25,          g_Keys.ratelimit.p25,     200 },
+		{ JURF,          g_Keys.ratelimit.urf,     0 },
+		{ JUSRP,         g_Keys.ratelimit.usrp,    200 },
+		{ JYSF,          g_Keys.ratelimit.ysf,     200 }
+	};
+	return limits;
+}
+
 std::string CConfigure::getDataRefreshType(ERefreshType type) const
 {
 	if (ERefreshType::both == type)
 		return std::string("both");
 	else if (ERefreshType::file == type)
 		return std::string("file");
+	else if (ERefreshType::binary == type)
+		return std::string("binary");
 	else
 		return std::string("http");
 }
@@ -921,6 +1030,8 @@ ERefreshType CConfigure::GetRefreshType(const std::string &key) const
 				type = ERefreshType::both;
 			else if (0 == s.compare("file"))
 				type = ERefreshType::file;
+			else if (0 == s.compare("binary"))
+				type = ERefreshType::binary;
 			else
 				type = ERefreshType::http;
 		}
@@ -21,11 +21,12 @@
 #include <cstdint>
 #include <string>
 #include <regex>
+#include <vector>
 #include <nlohmann/json.hpp>
 
 enum class ErrorLevel { fatal, mild };
-enum class ERefreshType { file, http, both };
-enum class ESection { none, names, ip, modules, urf, dplus, dextra, dcs, g3, dmrplus, mmdvm, nxdn, bm, ysf, p25, m17, usrp, dmrid, nxdnid, ysffreq, files, tc };
+enum class ERefreshType { file, http, both, binary };
+enum class ESection { none, names, ip, modules, urf, dplus, dextra, dcs, g3, dmrplus, mmdvm, nxdn, bm, ysf, p25, m17, usrp, dmrid, nxdnid, ysffreq, files, tc, ratelimit, status };
 
 #define IS_TRUE(a) ((a)=='t' || (a)=='T' || (a)=='1')
 
@@ -50,6 +51,9 @@ private:
 	nlohmann::json data;
 	std::regex IPv4RegEx, IPv6RegEx;
 
+	struct SRateLimit { const char *name; const std::string &key; unsigned rate; };
+	const std::vector<SRateLimit> &rateLimits() const;
+
 	std::string getDataRefreshType(ERefreshType t) const;
 	unsigned getUnsigned(const std::string &value, const std::string &label, unsigned min, unsigned max, unsigned defaultvalue) const;
 	void badParam(const std::string &param) const;
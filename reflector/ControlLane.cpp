@@ -0,0 +1,72 @@
+// urfd -- The universal reflector
+// Copyright © 2024 Thomas A. Early N7TAE
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "ControlLane.h"
+
+////////////////////////////////////////////////////////////////////////////////////////
+// operation
+
+bool CControlLane::Push(const CBuffer &Buffer, const CIp &Ip, unsigned type)
+{
+	if ( m_count == CONTROL_LANE_SIZE )
+	{
+		m_dropped.store(m_dropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+		return false;
+	}
+
+	auto &p = m_packets[(m_head + m_count) % CONTROL_LANE_SIZE];
+	p.buffer = Buffer;
+	p.ip = Ip;
+	p.type = type;
+	m_count++;
+	return true;
+}
+
+int CControlLane::WaitTime(int time_ms) const
+{
+	if ( 0 == m_count )
+		return time_ms;
+
+	// until the bucket holds a whole token, at least 1 ms so a receive doesn't spin
+	const double tokens = m_tokens + m_refill.time() * CONTROL_LANE_RATE;
+	if ( tokens >= 1.0 )
+		return 0;
+	const int ms = int((1.0 - tokens) * 1000.0 / CONTROL_LANE_RATE) + 1;
+	return (ms < time_ms) ? ms : time_ms;
+}
+
+bool CControlLane::Pop(CBuffer &Buffer, CIp &Ip, unsigned &type)
+{
+	if ( 0 == m_count )
+		return false;
+
+	// refill the bucket
+	m_tokens += m_refill.time() * CONTROL_LANE_RATE;
+	m_refill.start();
+	if ( m_tokens > CONTROL_LANE_BURST )
+		m_tokens = CONTROL_LANE_BURST;
+	if ( m_tokens < 1.0 )
+		return false;
+	m_tokens -= 1.0;
+
+	const auto &p = m_packets[m_head];
+	Buffer = p.buffer;
+	Ip = p.ip;
+	type = p.type;
+	m_head = (m_head + 1) % CONTROL_LANE_SIZE;
+	m_count--;
+	return true;
+}
@@ -0,0 +1,67 @@
+// urfd -- The universal reflector
+// Copyright © 2024 Thomas A. Early N7TAE
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+#include "Buffer.h"
+#include "IP.h"
+#include "Timer.h"
+
+#define CONTROL_LANE_SIZE   256     // control packets waiting to be handled
+#define CONTROL_LANE_RATE   1000    // control packets handled per second
+#define CONTROL_LANE_BURST  50      // control packets handled back to back
+
+////////////////////////////////////////////////////////////////////////////////////////
+// The low priority lane for a protocol's incoming control traffic: connects, keepalives
+// and the like. They wait here while voice packets are handled, and they are let out at
+// CONTROL_LANE_RATE, so a storm of reconnecting clients can't hold up the streams.
+// When the lane is full, the newest packet is dropped; clients retry these anyway.
+
+class CControlLane
+{
+public:
+	CControlLane() : m_head(0), m_count(0), m_tokens(CONTROL_LANE_BURST), m_dropped(0) {}
+
+	bool IsEmpty(void) const { return 0 == m_count; }
+
+	// how long a receive may wait before the next packet can be popped, up to time_ms
+	int WaitTime(int time_ms) const;
+
+	// false if the lane is full and the packet was dropped
+	bool Push(const CBuffer &Buffer, const CIp &Ip, unsigned type);
+
+	// the oldest waiting packet, if the rate allows one to be handled now
+	bool Pop(CBuffer &Buffer, CIp &Ip, unsigned &type);
+
+	uint64_t GetDropped(void) const { return m_dropped.load(std::memory_order_relaxed); }
+
+protected:
+	struct SControlPacket
+	{
+		CBuffer  buffer;
+		CIp      ip;
+		unsigned type;
+	};
+
+	SControlPacket m_packets[CONTROL_LANE_SIZE];
+	unsigned m_head, m_count;
+	double   m_tokens;
+	CTimer   m_refill;
+	std::atomic<uint64_t> m_dropped;
+};
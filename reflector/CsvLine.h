@@ -0,0 +1,69 @@
+// urfd -- The universal reflector
+// Copyright © 2024 Thomas A. Early N7TAE
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <charconv>
+#include <cstring>
+#include <string_view>
+
+////////////////////////////////////////////////////////////////////////////////////////
+// The fields of one line of a lookup database. Each field is a view into the line, so
+// nothing is copied or allocated, and the separators are found with memchr, which
+// the C library vectorizes.
+
+class CCsvLine
+{
+public:
+	CCsvLine(std::string_view line, char separator) : m_next(line.data()), m_end(line.data() + line.size()), m_sep(separator), m_done(false) {}
+
+	// the next field, false when there are none left. Like std::getline with a
+	// delimiter, the text after the last separator is a field only if it isn't empty.
+	bool Next(std::string_view &field)
+	{
+		if (m_done || m_next == m_end)
+			return false;
+		auto sep = static_cast<const char *>(memchr(m_next, m_sep, m_end - m_next));
+		if (nullptr == sep)
+		{
+			field = std::string_view(m_next, m_end - m_next);
+			m_done = true;
+		}
+		else
+		{
+			field = std::string_view(m_next, sep - m_next);
+			m_next = sep + 1;
+		}
+		return true;
+	}
+
+	// true if the last field was followed by a separator
+	bool More(void) const { return ! m_done; }
+
+	// the number at the start of a field, after any blanks, like atol() but it can fail
+	template <typename T> static bool Number(std::string_view field, T &value)
+	{
+		auto p = field.data(), end = p + field.size();
+		while (p < end && (' ' == *p || '\t' == *p))
+			p++;
+		return std::errc() == std::from_chars(p, end, value).ec;
+	}
+
+private:
+	const char *m_next, *m_end;
+	const char m_sep;
+	bool m_done;
+};
@@ -16,6 +16,8 @@
  *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
  */
 
+#include <strings.h>
+
 #include "CurlGet.h"
 
 CCurlGet::CCurlGet()
@@ -42,6 +44,37 @@ size_t CCurlGet::data_write(void* buf, size_t size, size_t nmemb, void* userp)
 	return 0;
 }
 
+// callback function hands data to a std::function
+size_t CCurlGet::data_stream(void* buf, size_t size, size_t nmemb, void* userp)
+{
+	auto &write = *static_cast<const std::function<bool(const char *, size_t)>*>(userp);
+	size_t len = size * nmemb;
+	return write(static_cast<const char*>(buf), len) ? len : 0;
+}
+
+// callback function picks the validators out of the response headers
+size_t CCurlGet::header_read(char* buf, size_t size, size_t nmemb, void* userp)
+{
+	auto &v = *static_cast<SCurlValidators*>(userp);
+	size_t len = size * nmemb;
+	std::string line(buf, len);
+	while (line.size() && ('\r' == line.back() || '\n' == line.back()))
+		line.pop_back();
+
+	auto value = [&line](size_t n) { auto p = line.find_first_not_of(' ', n); return (std::string::npos == p) ? std::string() : line.substr(p); };
+	if (0 == line.compare(0, 5, "HTTP/"))
+	{
+		// a new response, after a redirect
+		v.etag.clear();
+		v.lastmodified.clear();
+	}
+	else if (0 == strncasecmp(line.c_str(), "ETag:", 5))
+		v.etag.assign(value(5));
+	else if (0 == strncasecmp(line.c_str(), "Last-Modified:", 14))
+		v.lastmodified.assign(value(14));
+	return len;
+}
+
 CURLcode CCurlGet::GetURL(const std::string &url, std::stringstream &ss, long timeout)
 {
 	CURLcode code(CURLE_FAILED_INIT);
@@ -66,3 +99,54 @@ CURLcode CCurlGet::GetURL(const std::string &url, std::stringstream &ss, long ti
 	}
 	return code;
 }
+
+CURLcode CCurlGet::GetURL(const std::string &url, SCurlValidators &validators, const std::function<bool(const char *, size_t)> &write, bool &unchanged, long timeout)
+{
+	CURLcode code(CURLE_FAILED_INIT);
+	CURL* curl = curl_easy_init();
+	struct curl_slist *headers = nullptr;
+	SCurlValidators received;
+	long status = 0;
+
+	unchanged = false;
+	if (validators.etag.size())
+		headers = curl_slist_append(headers, ("If-None-Match: " + validators.etag).c_str());
+	if (validators.lastmodified.size())
+		headers = curl_slist_append(headers, ("If-Modified-Since: " + validators.lastmodified).c_str());
+
+	if(curl)
+	{
+		if(CURLE_OK == (code = curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, &data_stream))
+		&& CURLE_OK == (code = curl_easy_setopt(curl, CURLOPT_WRITEDATA, &write))
+		&& CURLE_OK == (code = curl_easy_setopt(curl, CURLOPT_HEADERFUNCTION, &header_read))
+		&& CURLE_OK == (code = curl_easy_setopt(curl, CURLOPT_HEADERDATA, &received))
+		&& CURLE_OK == (code = curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers))
+		&& CURLE_OK == (code = curl_easy_setopt(curl, CURLOPT_ACCEPT_ENCODING, ""))	// whatever libcurl can decompress
+		&& CURLE_OK == (code = curl_easy_setopt(curl, CURLOPT_FAILONERROR, 1L))
+		&& CURLE_OK == (code = curl_easy_setopt(curl, CURLOPT_NOPROGRESS, 1L))
+		&& CURLE_OK == (code = curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1L))
+		&& CURLE_OK == (code = curl_easy_setopt(curl, CURLOPT_TIMEOUT, timeout))
+		&& CURLE_OK == (code = curl_easy_setopt(curl, CURLOPT_URL, url.c_str())))
+		{
+			code = curl_easy_perform(curl);
+			if (CURLE_OK == code)
+				curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &status);
+		}
+		curl_easy_cleanup(curl);
+	}
+	curl_slist_free_all(headers);
+
+	if (code != CURLE_OK)
+	{
+		std::cout << "WARNING: was not able retrieve data at '" << url << "'\nCurl returned: " << code << std::endl;
+	}
+	else if (304 == status)
+	{
+		unchanged = true;
+	}
+	else
+	{
+		validators = received;
+	}
+	return code;
+}
@@ -19,9 +19,16 @@
 #pragma once
 
 #include <curl/curl.h>
+#include <functional>
 #include <iostream>
 #include <string>
 
+// what the server said about the last copy it sent, for a conditional GET
+struct SCurlValidators
+{
+	std::string etag, lastmodified;
+};
+
 class CCurlGet
 {
 public:
@@ -29,6 +36,13 @@ public:
 	~CCurlGet();
 	// the contents of the URL will be appended to the stringstream.
 	CURLcode GetURL(const std::string &url, std::stringstream &ss, long timeout = 30);
+	// a conditional GET: if the server still has what the validators describe, unchanged
+	// is set and nothing is written. Otherwise the body is handed to write as it arrives,
+	// already decompressed, and the validators are updated. A write that returns false
+	// aborts the transfer.
+	CURLcode GetURL(const std::string &url, SCurlValidators &validators, const std::function<bool(const char *, size_t)> &write, bool &unchanged, long timeout = 30);
 private:
 	static size_t data_write(void* buf, size_t size, size_t nmemb, void* userp);
+	static size_t data_stream(void* buf, size_t size, size_t nmemb, void* userp);
+	static size_t header_read(char* buf, size_t size, size_t nmemb, void* userp);
 };
@@ -25,8 +25,23 @@
 ////////////////////////////////////////////////////////////////////////////////////////
 // operation
 
+enum class EDcsPacket : unsigned { unknown, voice, connect, disconnect, keepalive };
+
+// a 15 byte keepalive of zeros is one to ignore
+static constexpr SPacketRoute DCSRoutes[] = {
+	{ EDcsPacket::voice,      "voice",      100, BUFFER_LENMAX, "0001", true },
+	{ EDcsPacket::keepalive,  "keepalive",   17,  17 },
+	{ EDcsPacket::keepalive,  "keepalive",   22,  22 },
+	{ EDcsPacket::keepalive,  "keepalive",   15,  15 },
+	{ EDcsPacket::connect,    "connect",    519, 519 },
+	{ EDcsPacket::disconnect, "disconnect",  11,  11 },
+	{ EDcsPacket::disconnect, "disconnect",  19,  19 },
+};
+
 bool CDcsProtocol::Initialize(const char *type, const EProtocol ptype, const uint16_t port, const bool has_ipv4, const bool has_ipv6)
 {
+	m_Router.SetRoutes("DCS", DCSRoutes);
+
 	// base class
 	if (! CProtocol::Initialize(type, ptype, port, has_ipv4, has_ipv6))
 		return false;
@@ -55,28 +70,38 @@ void CDcsProtocol::Task(void)
 	// handle incoming packets
 #if DSTAR_IPV6==true
 #if DSTAR_IPV4==true
-	if ( ReceiveDS(Buffer, Ip, 20) )
+	const bool received = ReceiveDS(Buffer, Ip, ReceiveTimeout(20));
 #else
-	if ( Receive6(Buffer, Ip, 20) )
+	const bool received = Receive6(Buffer, Ip, ReceiveTimeout(20));
 #endif
 #else
-	if ( Receive4(Buffer, Ip, 20) )
+	const bool received = Receive4(Buffer, Ip, ReceiveTimeout(20));
 #endif
+	unsigned route;
+	if ( NextPacket(received, Buffer, Ip, route) )
 	{
 		// crack the packet
-		if ( IsValidDvPacket(Buffer, Header, Frame) )
+		const auto type = EDcsPacket(route);
+		if ( EDcsPacket::voice == type && IsValidDvPacket(Buffer, Ip, Header, Frame) )
 		{
-			// callsign muted?
-			if ( g_GateKeeper.MayTransmit(Header->GetMyCallsign(), Ip, EProtocol::dcs, Header->GetRpt2Module()) )
+			if ( Header )
 			{
-				OnDvHeaderPacketIn(Header, Ip);
+				// callsign muted?
+				if ( g_GateKeeper.MayTransmit(Header->GetMyCallsign(), Ip, EProtocol::dcs, Header->GetRpt2Module()) )
+				{
+					OnDvHeaderPacketIn(Header, Ip);
 
+					OnDvFramePacketIn(Frame, &Ip);
+				}
+			}
+			else if ( MayTransmitOnStream(Frame->GetStreamId(), Ip, EProtocol::dcs) )
+			{
 				OnDvFramePacketIn(Frame, &Ip);
 			}
 		}
-		else if ( IsValidConnectPacket(Buffer, &Callsign, &ToLinkModule) )
+		else if ( EDcsPacket::connect == type && IsValidConnectPacket(Buffer, &Callsign, &ToLinkModule) )
 		{
-			std::cout << "DCS connect packet for module " << ToLinkModule << " from " << Callsign << " at " << Ip << std::endl;
+			CLogLine(ELogLevel::info, "dcs-connect") << "DCS connect packet for module " << ToLinkModule << " from " << Callsign << " at " << Ip;
 
 			// callsign authorized?
 			if ( g_GateKeeper.MayLink(Callsign, Ip, EProtocol::dcs) && g_Reflector.IsValidModule(ToLinkModule) )
@@ -94,7 +119,7 @@ void CDcsProtocol::Task(void)
 				}
 				else
 				{
-					std::cout << "DCS node " << Callsign << " connect attempt on non-existing module" << std::endl;
+					CLogLine(ELogLevel::warning, "dcs-link-refused") << "DCS node " << Callsign << " connect attempt on non-existing module";
 
 					// deny the request
 					EncodeConnectNackPacket(Callsign, ToLinkModule, &Buffer);
@@ -109,9 +134,9 @@ void CDcsProtocol::Task(void)
 			}
 
 		}
-		else if ( IsValidDisconnectPacket(Buffer, &Callsign) )
+		else if ( EDcsPacket::disconnect == type && IsValidDisconnectPacket(Buffer, &Callsign) )
 		{
-			std::cout << "DCS disconnect packet from " << Callsign << " at " << Ip << std::endl;
+			CLogLine(ELogLevel::info, "dcs-disconnect") << "DCS disconnect packet from " << Callsign << " at " << Ip;
 
 			// find client
 			CClients *clients = g_Reflector.GetClients();
@@ -126,7 +151,7 @@ void CDcsProtocol::Task(void)
 			}
 			g_Reflector.ReleaseClients();
 		}
-		else if ( IsValidKeepAlivePacket(Buffer, &Callsign) )
+		else if ( EDcsPacket::keepalive == type && IsValidKeepAlivePacket(Buffer, &Callsign) )
 		{
 			//std::cout << "DCS keepalive packet from " << Callsign << " at " << Ip << std::endl;
 
@@ -140,7 +165,7 @@ void CDcsProtocol::Task(void)
 			}
 			g_Reflector.ReleaseClients();
 		}
-		else if ( IsIgnorePacket(Buffer) )
+		else if ( EDcsPacket::keepalive == type && IsIgnorePacket(Buffer) )
 		{
 			// valid but ignore packet
 			//std::cout << "DCS ignored packet from " << Ip << std::endl;
@@ -150,7 +175,7 @@ void CDcsProtocol::Task(void)
 			// invalid packet
 			std::string title("Unknown DCS packet from ");
 			title += Ip.GetAddress();
-			Buffer.Dump(title);
+			Dump(title.c_str(), Buffer.data(), Buffer.size());
 		}
 	}
 
@@ -233,22 +258,31 @@ void CDcsProtocol::HandleQueue(void)
 			// m_StreamsCache[module] will be created if it doesn't exist
 			m_StreamsCache[module].m_dvHeader = CDvHeaderPacket((const CDvHeaderPacket &)*packet.get());
 			m_StreamsCache[module].m_iSeqCounter = 0;
+			EncodeDCSTemplate(m_StreamsCache[module].m_dvHeader, &m_StreamsCache[module].m_Frame);
 		}
 		else
 		{
-			// encode it
-			CBuffer buffer;
+			// encode it, in the module's frame buffer
+			auto &cache = m_StreamsCache[module];
+			if ( cache.m_Frame.size() == 0 )
+			{
+				EncodeDCSTemplate(cache.m_dvHeader, &cache.m_Frame);
+			}
+			CBuffer &buffer = cache.m_Frame;
+			bool encoded = false;
 			if ( packet->IsLastPacket() )
 			{
-				EncodeLastDCSPacket(m_StreamsCache[module].m_dvHeader, (const CDvFramePacket &)*packet.get(), m_StreamsCache[module].m_iSeqCounter++, &buffer);
+				EncodeLastDCSPacket((const CDvFramePacket &)*packet.get(), cache.m_iSeqCounter++, &buffer);
+				encoded = true;
 			}
 			else if ( packet->IsDvFrame() )
 			{
-				EncodeDCSPacket(m_StreamsCache[module].m_dvHeader, (const CDvFramePacket &)*packet.get(), m_StreamsCache[module].m_iSeqCounter++, &buffer);
+				EncodeDCSPacket((const CDvFramePacket &)*packet.get(), cache.m_iSeqCounter++, &buffer);
+				encoded = true;
 			}
 
 			// send it
-			if ( buffer.size() > 0 )
+			if ( encoded )
 			{
 				// and push it to all our clients linked to the module and who are not streaming in
 				CClients *clients = g_Reflector.GetClients();
@@ -310,7 +344,7 @@ void CDcsProtocol::HandleKeepalives(void)
 			Send(disconnect, client->GetIp());
 
 			// remove it
-			std::cout << "DCS client " << client->GetCallsign() << " keepalive timeout" << std::endl;
+			CLogLine(ELogLevel::info, "dcs-keepalive-timeout") << "DCS client " << client->GetCallsign() << " keepalive timeout";
 			clients->RemoveClient(client);
 		}
 
@@ -321,7 +355,7 @@ void CDcsProtocol::HandleKeepalives(void)
 ////////////////////////////////////////////////////////////////////////////////////////
 // packet decoding helpers
 
-bool CDcsProtocol::IsValidConnectPacket(const CBuffer &Buffer, CCallsign *callsign, char *reflectormodule)
+bool CDcsProtocol::IsValidConnectPacket(const CBufferView &Buffer, CCallsign *callsign, char *reflectormodule)
 {
 	bool valid = false;
 	if ( Buffer.size() == 519 )
@@ -334,7 +368,7 @@ bool CDcsProtocol::IsValidConnectPacket(const CBuffer &Buffer, CCallsign *callsi
 	return valid;
 }
 
-bool CDcsProtocol::IsValidDisconnectPacket(const CBuffer &Buffer, CCallsign *callsign)
+bool CDcsProtocol::IsValidDisconnectPacket(const CBufferView &Buffer, CCallsign *callsign)
 {
 	bool valid = false;
 	if ((Buffer.size() == 11) && (Buffer.data()[9] == ' '))
@@ -352,7 +386,7 @@ bool CDcsProtocol::IsValidDisconnectPacket(const CBuffer &Buffer, CCallsign *cal
 	return valid;
 }
 
-bool CDcsProtocol::IsValidKeepAlivePacket(const CBuffer &Buffer, CCallsign *callsign)
+bool CDcsProtocol::IsValidKeepAlivePacket(const CBufferView &Buffer, CCallsign *callsign)
 {
 	bool valid = false;
 	if ( (Buffer.size() == 17) || (Buffer.size() == 15) || (Buffer.size() == 22) )
@@ -363,26 +397,38 @@ bool CDcsProtocol::IsValidKeepAlivePacket(const CBuffer &Buffer, CCallsign *call
 	return valid;
 }
 
-bool CDcsProtocol::IsValidDvPacket(const CBuffer &Buffer, std::unique_ptr<CDvHeaderPacket> &header, std::unique_ptr<CDvFramePacket> &frame)
+// every DCS packet repeats the stream's header, it's only decoded
+// if the packet doesn't belong to a stream that is already open
+bool CDcsProtocol::IsValidDvPacket(const CBufferView &Buffer, const CIp &Ip, std::unique_ptr<CDvHeaderPacket> &header, std::unique_ptr<CDvFramePacket> &frame)
 {
 	uint8_t tag[] = { '0','0','0','1' };
 
-	if ( (Buffer.size() >= 100) && (Buffer.Compare(tag, sizeof(tag)) == 0) )
+	if ( (Buffer.size() >= 100) && Buffer.StartsWith(tag, sizeof(tag)) )
 	{
-		// get the header
-		header = std::unique_ptr<CDvHeaderPacket>(new CDvHeaderPacket((struct dstar_header *)&(Buffer.data()[4]), *((uint16_t *)&(Buffer.data()[43])), 0x80));
+		const uint16_t sid = *((uint16_t *)&(Buffer.data()[43]));
 
 		// get the frame
-		frame = std::unique_ptr<CDvFramePacket>(new CDvFramePacket((SDStarFrame *)&(Buffer.data()[46]), *((uint16_t *)&(Buffer.data()[43])), Buffer.data()[45]));
+		frame = std::unique_ptr<CDvFramePacket>(new CDvFramePacket((SDStarFrame *)&(Buffer.data()[46]), sid, Buffer.data()[45]));
+		if ( ! frame->IsValid() )
+			return false;
+
+		if ( GetStream(sid, &Ip) )
+		{
+			header.reset();
+			return true;
+		}
+
+		// get the header
+		header = std::unique_ptr<CDvHeaderPacket>(new CDvHeaderPacket((struct dstar_header *)&(Buffer.data()[4]), sid, 0x80));
 
 		// check validity of packets
-		if ( header && header->IsValid() && frame && frame->IsValid() )
+		if ( header->IsValid() )
 			return true;
 	}
 	return false;
 }
 
-bool CDcsProtocol::IsIgnorePacket(const CBuffer &Buffer)
+bool CDcsProtocol::IsIgnorePacket(const CBufferView &Buffer)
 {
 	uint8_t tag[] = { 0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00, };
 
@@ -450,7 +496,9 @@ void CDcsProtocol::EncodeDisconnectPacket(CBuffer *Buffer, std::shared_ptr<CClie
 	Buffer->Append((uint8_t)0x00);
 }
 
-void CDcsProtocol::EncodeDCSPacket(const CDvHeaderPacket &Header, const CDvFramePacket &DvFrame, uint32_t iSeq, CBuffer *Buffer) const
+// everything but the stream id, packet id, ambe, dv data and sequence number
+// is the same for every frame of a stream
+void CDcsProtocol::EncodeDCSTemplate(const CDvHeaderPacket &Header, CBuffer *Buffer) const
 {
 	uint8_t tag[] = { '0','0','0','1' };
 	struct dstar_header DstarHeader;
@@ -459,19 +507,31 @@ void CDcsProtocol::EncodeDCSPacket(const CDvHeaderPacket &Header, const CDvFrame
 
 	Buffer->Set(tag, sizeof(tag));
 	Buffer->Append((uint8_t *)&DstarHeader, sizeof(struct dstar_header) - sizeof(uint16_t));
-	Buffer->Append(DvFrame.GetStreamId());
-	Buffer->Append((uint8_t)(DvFrame.GetPacketId() % 21));
-	Buffer->Append((uint8_t *)DvFrame.GetCodecData(ECodecType::dstar), 9);
-	Buffer->Append((uint8_t *)DvFrame.GetDvData(), 3);
-	Buffer->Append((uint8_t)((iSeq >> 0) & 0xFF));
-	Buffer->Append((uint8_t)((iSeq >> 8) & 0xFF));
-	Buffer->Append((uint8_t)((iSeq >> 16) & 0xFF));
+	Buffer->Append(Header.GetStreamId());
+	Buffer->Append((uint8_t)0x00);
+	Buffer->Append((uint8_t)0x00, 9);
+	Buffer->Append((uint8_t)0x00, 3);
+	Buffer->Append((uint8_t)0x00, 3);
 	Buffer->Append((uint8_t)0x01);
 	Buffer->Append((uint8_t)0x00, 38);
 }
 
-void CDcsProtocol::EncodeLastDCSPacket(const CDvHeaderPacket &Header, const CDvFramePacket &DvFrame, uint32_t iSeq, CBuffer *Buffer) const
+void CDcsProtocol::EncodeDCSPacket(const CDvFramePacket &DvFrame, uint32_t iSeq, CBuffer *Buffer) const
+{
+	uint8_t *data = Buffer->data();
+	const uint16_t sid = DvFrame.GetStreamId();
+
+	memcpy(data+43, &sid, sizeof(uint16_t));
+	data[45] = (uint8_t)(DvFrame.GetPacketId() % 21);
+	memcpy(data+46, DvFrame.GetCodecData(ECodecType::dstar), 9);
+	memcpy(data+55, DvFrame.GetDvData(), 3);
+	data[58] = (uint8_t)((iSeq >> 0) & 0xFF);
+	data[59] = (uint8_t)((iSeq >> 8) & 0xFF);
+	data[60] = (uint8_t)((iSeq >> 16) & 0xFF);
+}
+
+void CDcsProtocol::EncodeLastDCSPacket(const CDvFramePacket &DvFrame, uint32_t iSeq, CBuffer *Buffer) const
 {
-	EncodeDCSPacket(Header, DvFrame, iSeq, Buffer);
+	EncodeDCSPacket(DvFrame, iSeq, Buffer);
 	(Buffer->data())[45] |= 0x40;
 }
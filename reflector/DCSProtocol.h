@@ -37,6 +37,7 @@ public:
 
 	CDvHeaderPacket m_dvHeader;
 	uint32_t        m_iSeqCounter;
+	CBuffer         m_Frame;    // encoded with the header, then patched for each frame
 };
 
 class CDcsProtocol : public CProtocol
@@ -59,11 +60,11 @@ protected:
 	void OnDvHeaderPacketIn(std::unique_ptr<CDvHeaderPacket> &, const CIp &);
 
 	// packet decoding helpers
-	bool IsValidConnectPacket(const CBuffer &, CCallsign *, char *);
-	bool IsValidDisconnectPacket(const CBuffer &, CCallsign *);
-	bool IsValidKeepAlivePacket(const CBuffer &, CCallsign *);
-	bool IsValidDvPacket(const CBuffer &, std::unique_ptr<CDvHeaderPacket> &, std::unique_ptr<CDvFramePacket> &);
-	bool IsIgnorePacket(const CBuffer &);
+	bool IsValidConnectPacket(const CBufferView &, CCallsign *, char *);
+	bool IsValidDisconnectPacket(const CBufferView &, CCallsign *);
+	bool IsValidKeepAlivePacket(const CBufferView &, CCallsign *);
+	bool IsValidDvPacket(const CBufferView &, const CIp &, std::unique_ptr<CDvHeaderPacket> &, std::unique_ptr<CDvFramePacket> &);
+	bool IsIgnorePacket(const CBufferView &);
 
 	// packet encoding helpers
 	void EncodeKeepAlivePacket(CBuffer *);
@@ -71,8 +72,9 @@ protected:
 	void EncodeConnectAckPacket(const CCallsign &, char, CBuffer *);
 	void EncodeConnectNackPacket(const CCallsign &, char, CBuffer *);
 	void EncodeDisconnectPacket(CBuffer *, std::shared_ptr<CClient>);
-	void EncodeDCSPacket(const CDvHeaderPacket &, const CDvFramePacket &, uint32_t, CBuffer *) const;
-	void EncodeLastDCSPacket(const CDvHeaderPacket &, const CDvFramePacket &, uint32_t, CBuffer *) const;
+	void EncodeDCSTemplate(const CDvHeaderPacket &, CBuffer *) const;
+	void EncodeDCSPacket(const CDvFramePacket &, uint32_t, CBuffer *) const;
+	void EncodeLastDCSPacket(const CDvFramePacket &, uint32_t, CBuffer *) const;
 
 protected:
 	// for keep alive
@@ -27,8 +27,20 @@
 ////////////////////////////////////////////////////////////////////////////////////////
 // operation
 
+enum class EDextraPacket : unsigned { unknown, frame, header, link, keepalive };
+
+// connect and disconnect packets are only told apart by their content
+static constexpr SPacketRoute DExtraRoutes[] = {
+	{ EDextraPacket::frame,     "frame",     27, 27, "DSVT", true },
+	{ EDextraPacket::header,    "header",    56, 56, "DSVT", true },
+	{ EDextraPacket::keepalive, "keepalive",  9,  9 },
+	{ EDextraPacket::link,      "link",      11, 11 },
+};
+
 bool CDextraProtocol::Initialize(const char *type, const EProtocol ptype, const uint16_t port, const bool has_ipv4, const bool has_ipv6)
 {
+	m_Router.SetRoutes("DExtra", DExtraRoutes);
+
 	// base class
 	if (! CProtocol::Initialize(type, ptype, port, has_ipv4, has_ipv6))
 		return false;
@@ -56,20 +68,23 @@ void CDextraProtocol::Task(void)
 	// any incoming packet ?
 #if DSTAR_IPV6==true
 #if DSTAR_IPV4==true
-	if ( ReceiveDS(Buffer, Ip, 20) )
+	const bool received = ReceiveDS(Buffer, Ip, ReceiveTimeout(20));
 #else
-	if ( Receive6(Buffer, Ip, 20) )
+	const bool received = Receive6(Buffer, Ip, ReceiveTimeout(20));
 #endif
 #else
-	if ( Receive4(Buffer, Ip, 20) )
+	const bool received = Receive4(Buffer, Ip, ReceiveTimeout(20));
 #endif
+	unsigned route;
+	if ( NextPacket(received, Buffer, Ip, route) )
 	{
 		// crack the packet
-		if ( IsValidDvFramePacket(Buffer, Frame) )
+		const auto type = EDextraPacket(route);
+		if ( EDextraPacket::frame == type && IsValidDvFramePacket(Buffer, Frame) )
 		{
 			OnDvFramePacketIn(Frame, &Ip);
 		}
-		else if ( IsValidDvHeaderPacket(Buffer, Header) )
+		else if ( EDextraPacket::header == type && IsValidDvHeaderPacket(Buffer, Header) )
 		{
 			// callsign muted?
 			if ( g_GateKeeper.MayTransmit(Header->GetMyCallsign(), Ip, EProtocol::dextra, Header->GetRpt2Module()) )
@@ -77,22 +92,25 @@ void CDextraProtocol::Task(void)
 				OnDvHeaderPacketIn(Header, Ip);
 			}
 		}
-		else if ( IsValidConnectPacket(Buffer, Callsign, ToLinkModule, ProtRev) )
+		else if ( EDextraPacket::link == type && IsValidConnectPacket(Buffer, Callsign, ToLinkModule, ProtRev) )
 		{
-			std::cout << "DExtra connect packet for module " << ToLinkModule << " from " << Callsign << " at " << Ip << " rev ";
-			switch (ProtRev) {
-				case EProtoRev::original:
-					std::cout << "Original" << std::endl;
-					break;
-				case EProtoRev::revised:
-					std::cout << "Revised" << std::endl;
-					break;
-				case EProtoRev::ambe:
-					std::cout << "AMBE" << std::endl;
-					break;
-				default:
-					std::cout << "UNEXPECTED Revision" << std::endl;
-					break;
+			{
+				CLogLine line(ELogLevel::info, "dextra-connect");
+				line << "DExtra connect packet for module " << ToLinkModule << " from " << Callsign << " at " << Ip << " rev ";
+				switch (ProtRev) {
+					case EProtoRev::original:
+						line << "Original";
+						break;
+					case EProtoRev::revised:
+						line << "Revised";
+						break;
+					case EProtoRev::ambe:
+						line << "AMBE";
+						break;
+					default:
+						line << "UNEXPECTED Revision";
+						break;
+				}
 			}
 
 			// callsign authorized?
@@ -111,7 +129,7 @@ void CDextraProtocol::Task(void)
 				}
 				else
 				{
-					std::cout << "DExtra node " << Callsign << " connect attempt on non-existing module" << std::endl;
+					CLogLine(ELogLevel::warning, "dextra-link-refused") << "DExtra node " << Callsign << " connect attempt on non-existing module";
 
 					// deny the request
 					EncodeConnectNackPacket(&Buffer);
@@ -125,9 +143,9 @@ void CDextraProtocol::Task(void)
 				Send(Buffer, Ip);
 			}
 		}
-		else if ( IsValidDisconnectPacket(Buffer, &Callsign) )
+		else if ( EDextraPacket::link == type && IsValidDisconnectPacket(Buffer, &Callsign) )
 		{
-			std::cout << "DExtra disconnect packet from " << Callsign << " at " << Ip << std::endl;
+			CLogLine(ELogLevel::info, "dextra-disconnect") << "DExtra disconnect packet from " << Callsign << " at " << Ip;
 
 			// find client & remove it
 			CClients *clients = g_Reflector.GetClients();
@@ -149,7 +167,7 @@ void CDextraProtocol::Task(void)
 			}
 			g_Reflector.ReleaseClients();
 		}
-		else if ( IsValidKeepAlivePacket(Buffer, &Callsign) )
+		else if ( EDextraPacket::keepalive == type && IsValidKeepAlivePacket(Buffer, &Callsign) )
 		{
 			//std::cout << "DExtra keepalive packet from " << Callsign << " at " << Ip << std::endl;
 
@@ -167,7 +185,7 @@ void CDextraProtocol::Task(void)
 		{
 			std::string title("Unknown DExtra packet from ");
 			title += Ip.GetAddress();
-			Buffer.Dump(title);
+			Dump(title.c_str(), Buffer.data(), Buffer.size());
 		}
 	}
 
@@ -267,7 +285,7 @@ void CDextraProtocol::HandleKeepalives(void)
 				Send(disconnect, client->GetIp());
 
 				// remove it
-				std::cout << "DExtra client " << client->GetCallsign() << " keepalive timeout" << std::endl;
+				CLogLine(ELogLevel::info, "dextra-keepalive-timeout") << "DExtra client " << client->GetCallsign() << " keepalive timeout";
 				clients->RemoveClient(client);
 			}
 			g_Reflector.ReleasePeers();
@@ -298,7 +316,7 @@ void CDextraProtocol::HandleKeepalives(void)
 			g_Reflector.ReleaseClients();
 
 			// remove it
-			std::cout << "DExtra peer " << peer->GetCallsign() << " keepalive timeout" << std::endl;
+			CLogLine(ELogLevel::info, "dextra-keepalive-timeout") << "DExtra peer " << peer->GetCallsign() << " keepalive timeout";
 			peers->RemovePeer(peer);
 		}
 	}
@@ -359,7 +377,7 @@ void CDextraProtocol::OnDvHeaderPacketIn(std::unique_ptr<CDvHeaderPacket> &Heade
 ////////////////////////////////////////////////////////////////////////////////////////
 // packet decoding helpers
 
-bool CDextraProtocol::IsValidConnectPacket(const CBuffer &Buffer, CCallsign &callsign, char &module, EProtoRev &protrev)
+bool CDextraProtocol::IsValidConnectPacket(const CBufferView &Buffer, CCallsign &callsign, char &module, EProtoRev &protrev)
 {
 	bool valid = false;
 	if ((Buffer.size() == 11) && (Buffer.data()[9] != ' '))
@@ -385,7 +403,7 @@ bool CDextraProtocol::IsValidConnectPacket(const CBuffer &Buffer, CCallsign &cal
 	return valid;
 }
 
-bool CDextraProtocol::IsValidDisconnectPacket(const CBuffer &Buffer, CCallsign *callsign)
+bool CDextraProtocol::IsValidDisconnectPacket(const CBufferView &Buffer, CCallsign *callsign)
 {
 	bool valid = false;
 	if ((Buffer.size() == 11) && (Buffer.data()[9] == ' '))
@@ -397,7 +415,7 @@ bool CDextraProtocol::IsValidDisconnectPacket(const CBuffer &Buffer, CCallsign *
 	return valid;
 }
 
-bool CDextraProtocol::IsValidKeepAlivePacket(const CBuffer &Buffer, CCallsign *callsign)
+bool CDextraProtocol::IsValidKeepAlivePacket(const CBufferView &Buffer, CCallsign *callsign)
 {
 	bool valid = false;
 	if (Buffer.size() == 9)
@@ -408,7 +426,7 @@ bool CDextraProtocol::IsValidKeepAlivePacket(const CBuffer &Buffer, CCallsign *c
 	return valid;
 }
 
-bool CDextraProtocol::IsValidDvHeaderPacket(const CBuffer &Buffer, std::unique_ptr<CDvHeaderPacket> &header)
+bool CDextraProtocol::IsValidDvHeaderPacket(const CBufferView &Buffer, std::unique_ptr<CDvHeaderPacket> &header)
 {
 	if ( 56==Buffer.size() && 0==Buffer.Compare((uint8_t *)"DSVT", 4) && 0x10U==Buffer.data()[4] && 0x20U==Buffer.data()[8] )
 	{
@@ -421,7 +439,7 @@ bool CDextraProtocol::IsValidDvHeaderPacket(const CBuffer &Buffer, std::unique_p
 	return false;
 }
 
-bool CDextraProtocol::IsValidDvFramePacket(const CBuffer &Buffer, std::unique_ptr<CDvFramePacket> &dvframe)
+bool CDextraProtocol::IsValidDvFramePacket(const CBufferView &Buffer, std::unique_ptr<CDvFramePacket> &dvframe)
 {
 	if ( 27==Buffer.size() && 0==Buffer.Compare((uint8_t *)"DSVT", 4) && 0x20U==Buffer.data()[4] && 0x20U==Buffer.data()[8] )
 	{
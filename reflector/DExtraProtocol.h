@@ -68,11 +68,11 @@ protected:
 	void OnDvHeaderPacketIn(std::unique_ptr<CDvHeaderPacket> &, const CIp &);
 
 	// packet decoding helpers
-	bool IsValidConnectPacket(    const CBuffer &, CCallsign &, char &, EProtoRev &);
-	bool IsValidDisconnectPacket( const CBuffer &, CCallsign *);
-	bool IsValidKeepAlivePacket(  const CBuffer &, CCallsign *);
-	bool IsValidDvHeaderPacket(   const CBuffer &, std::unique_ptr<CDvHeaderPacket> &);
-	bool IsValidDvFramePacket(    const CBuffer &, std::unique_ptr<CDvFramePacket> &);
+	bool IsValidConnectPacket(    const CBufferView &, CCallsign &, char &, EProtoRev &);
+	bool IsValidDisconnectPacket( const CBufferView &, CCallsign *);
+	bool IsValidKeepAlivePacket(  const CBufferView &, CCallsign *);
+	bool IsValidDvHeaderPacket(   const CBufferView &, std::unique_ptr<CDvHeaderPacket> &);
+	bool IsValidDvFramePacket(    const CBufferView &, std::unique_ptr<CDvFramePacket> &);
 
 	// packet encoding helpers
 	void EncodeKeepAlivePacket(CBuffer *);
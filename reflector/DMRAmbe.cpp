@@ -0,0 +1,165 @@
+// urfd -- The universal reflector
+// Copyright © 2024 Thomas A. Early N7TAE
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "YSFDefines.h"
+#include "Golay24128.h"
+#include "DMRAmbe.h"
+
+////////////////////////////////////////////////////////////////////////////////////////
+// lookup tables
+
+// the words' bits in one byte of a frame
+struct SAmbeWords
+{
+	uint32_t a, b, c;
+};
+
+// the frame bits of one byte of a word, bits 0 to 63 and bits 64 to 71
+struct SAmbeFrameBits
+{
+	uint64_t hi;
+	uint8_t  lo;
+};
+
+class CDmrAmbeTables
+{
+public:
+	CDmrAmbeTables()
+	{
+		for (unsigned k = 0U; k < 9U; k++)
+			for (unsigned v = 0U; v < 256U; v++)
+				gather[k][v] = { 0U, 0U, 0U };
+
+		Add(DMR_A_TABLE, 24U, 0U, scatterA);
+		Add(DMR_B_TABLE, 23U, 1U, scatterB);
+		Add(DMR_C_TABLE, 25U, 2U, scatterC);
+	}
+
+	SAmbeWords     gather[9][256];     // indexed by frame byte and its value
+	SAmbeFrameBits scatterA[4][256];   // indexed by word byte, least significant first, and its value
+	SAmbeFrameBits scatterB[4][256];
+	SAmbeFrameBits scatterC[4][256];
+
+private:
+	// word bit i of a width bit word is at frame bit table[i], most significant first
+	void Add(const unsigned int *table, unsigned width, unsigned word, SAmbeFrameBits scatter[4][256])
+	{
+		for (unsigned k = 0U; k < 4U; k++)
+		{
+			for (unsigned v = 0U; v < 256U; v++)
+			{
+				SAmbeFrameBits bits = { 0U, 0U };
+				for (unsigned j = 0U; j < 8U; j++)
+				{
+					const unsigned bit = 8U * k + j;    // from the least significant
+					if (bit >= width || 0U == (v & (1U << j)))
+						continue;
+					const unsigned pos = table[width - 1U - bit];
+					if (pos < 64U)
+						bits.hi |= 1ULL << (63U - pos);
+					else
+						bits.lo |= 1U << (71U - pos);
+				}
+				scatter[k][v] = bits;
+			}
+		}
+
+		for (unsigned i = 0U; i < width; i++)
+		{
+			const unsigned pos = table[i];
+			const uint32_t mask = 1U << (width - 1U - i);
+			for (unsigned v = 0U; v < 256U; v++)
+			{
+				if (v & BIT_MASK_TABLE[pos & 7U])
+				{
+					SAmbeWords &w = gather[pos >> 3][v];
+					if (0U == word)
+						w.a |= mask;
+					else if (1U == word)
+						w.b |= mask;
+					else
+						w.c |= mask;
+				}
+			}
+		}
+	}
+};
+
+static const CDmrAmbeTables &Tables()
+{
+	static const CDmrAmbeTables tables;
+	return tables;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////
+// operation
+
+void CDmrAmbe::Deinterleave(const uint8_t *frame, unsigned int &a, unsigned int &b, unsigned int &c)
+{
+	const auto &t = Tables();
+	uint32_t wa = 0U, wb = 0U, wc = 0U;
+	for (unsigned k = 0U; k < 9U; k++)
+	{
+		const SAmbeWords &w = t.gather[k][frame[k]];
+		wa |= w.a;
+		wb |= w.b;
+		wc |= w.c;
+	}
+	a = wa;
+	b = wb;
+	c = wc;
+}
+
+void CDmrAmbe::Interleave(unsigned int a, unsigned int b, unsigned int c, uint8_t *frame)
+{
+	const auto &t = Tables();
+	uint64_t hi = 0U;
+	uint8_t lo = 0U;
+	for (unsigned k = 0U; k < 4U; k++)
+	{
+		const SAmbeFrameBits &ba = t.scatterA[k][(a >> (8U * k)) & 0xFFU];
+		const SAmbeFrameBits &bb = t.scatterB[k][(b >> (8U * k)) & 0xFFU];
+		const SAmbeFrameBits &bc = t.scatterC[k][(c >> (8U * k)) & 0xFFU];
+		hi |= ba.hi | bb.hi | bc.hi;
+		lo |= ba.lo | bb.lo | bc.lo;
+	}
+	for (unsigned k = 0U; k < 8U; k++)
+		frame[k] = (uint8_t)(hi >> (56U - 8U * k));
+	frame[8] = lo;
+}
+
+void CDmrAmbe::Decode(const uint8_t *frame, unsigned int &dat_a, unsigned int &dat_b, unsigned int &dat_c)
+{
+	unsigned int a, b;
+	Deinterleave(frame, a, b, dat_c);
+
+	dat_a = a >> 12;
+
+	// The PRNG
+	b ^= (PRNG_TABLE[dat_a] >> 1);
+	dat_b = b >> 11;
+}
+
+void CDmrAmbe::Encode(unsigned int dat_a, unsigned int dat_b, unsigned int dat_c, uint8_t *frame)
+{
+	const unsigned int a = CGolay24128::encode24128(dat_a);
+
+	// The PRNG
+	const unsigned int p = PRNG_TABLE[dat_a] >> 1;
+	const unsigned int b = (CGolay24128::encode23127(dat_b) >> 1) ^ p;
+
+	Interleave(a, b, dat_c, frame);
+}
@@ -0,0 +1,39 @@
+// urfd -- The universal reflector
+// Copyright © 2024 Thomas A. Early N7TAE
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <cstdint>
+
+////////////////////////////////////////////////////////////////////////////////////////
+// class
+
+// Conversion between a 72 bit (9 byte) DMR AMBE+2 frame and its 49 vocoder
+// parameter bits. The A (24 bit), B (23 bit) and C (25 bit) words of a frame
+// are interleaved with DMR_A_TABLE, DMR_B_TABLE and DMR_C_TABLE. This is done
+// a byte at a time with lookup tables built from those, instead of a bit at a time.
+
+class CDmrAmbe
+{
+public:
+	// the interleaved A, B and C words
+	static void Deinterleave(const uint8_t *frame, unsigned int &a, unsigned int &b, unsigned int &c);
+	static void Interleave(unsigned int a, unsigned int b, unsigned int c, uint8_t *frame);
+
+	// the 12 bit A, 12 bit B and 25 bit C vocoder parameters, there is no FEC correction
+	static void Decode(const uint8_t *frame, unsigned int &dat_a, unsigned int &dat_b, unsigned int &dat_c);
+	static void Encode(unsigned int dat_a, unsigned int dat_b, unsigned int dat_c, uint8_t *frame);
+};
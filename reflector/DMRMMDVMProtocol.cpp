@@ -46,8 +46,23 @@ static uint8_t g_DmrSyncMSData[]     = { 0x0D,0x5D,0x7F,0x77,0xFD,0x75,0x70 };
 ////////////////////////////////////////////////////////////////////////////////////////
 // operation
 
+enum class EMmdvmPacket : unsigned { unknown, voice, login, auth, config, keepalive, disconnect, rssi, option };
+
+// RPTC and RPTCL are told apart by length
+static constexpr SPacketRoute MMDVMRoutes[] = {
+	{ EMmdvmPacket::voice,      "voice",      55,  55, "DMRD", true },
+	{ EMmdvmPacket::keepalive,  "keepalive",  11,  11, "RPTP" },
+	{ EMmdvmPacket::login,      "login",       8,   8, "RPTL" },
+	{ EMmdvmPacket::auth,       "auth",       40,  40, "RPTK" },
+	{ EMmdvmPacket::disconnect, "disconnect", 13,  13, "RPTC" },
+	{ EMmdvmPacket::config,     "config",    302, 302, "RPTC" },
+	{ EMmdvmPacket::rssi,       "rssi",       17,  17, "RPTI" },
+	{ EMmdvmPacket::option,     "option",      8, BUFFER_LENMAX, "RPTO" },
+};
+
 bool CDmrmmdvmProtocol::Initialize(const char *type, const EProtocol ptype, const uint16_t port, const bool has_ipv4, const bool has_ipv6)
 {
+	m_Router.SetRoutes("DMRMMDVM", MMDVMRoutes);
 	m_DefaultId = g_Configure.GetUnsigned(g_Keys.mmdvm.defaultid);
 	// base class
 	if (! CProtocol::Initialize(type, ptype, port, has_ipv4, has_ipv6))
@@ -85,24 +100,27 @@ void CDmrmmdvmProtocol::Task(void)
 	// handle incoming packets
 #if DMR_IPV6==true
 #if DMR_IPV4==true
-	if ( ReceiveDS(Buffer, Ip, 20) )
+	const bool received = ReceiveDS(Buffer, Ip, ReceiveTimeout(20));
 #else
-	if ( Receive6(Buffer, Ip, 20) )
+	const bool received = Receive6(Buffer, Ip, ReceiveTimeout(20));
 #endif
 #else
-	if ( Receive4(Buffer, Ip, 20) )
+	const bool received = Receive4(Buffer, Ip, ReceiveTimeout(20));
 #endif
+	unsigned route;
+	if ( NextPacket(received, Buffer, Ip, route) )
 	{
 		//Buffer.DebugDump(g_Reflector.m_DebugFile);
 		// crack the packet
-		if ( IsValidDvFramePacket(Ip, Buffer, Header, Frames) )
+		const auto type = EMmdvmPacket(route);
+		if ( EMmdvmPacket::voice == type && IsValidDvFramePacket(Ip, Buffer, Header, Frames) )
 		{
 			for ( int i = 0; i < 3; i++ )
 			{
 				OnDvFramePacketIn(Frames.at(i), &Ip);
 			}
 		}
-		else if ( IsValidDvHeaderPacket(Buffer, Header, &Cmd, &CallType) )
+		else if ( EMmdvmPacket::voice == type && IsValidDvHeaderPacket(Buffer, Header, &Cmd, &CallType) )
 		{
 			// callsign muted?
 			if ( g_GateKeeper.MayTransmit(Header->GetMyCallsign(), Ip, EProtocol::dmrmmdvm) )
@@ -111,13 +129,13 @@ void CDmrmmdvmProtocol::Task(void)
 				OnDvHeaderPacketIn(Header, Ip, Cmd, CallType);
 			}
 		}
-		else if ( IsValidDvLastFramePacket(Buffer, LastFrame) )
+		else if ( EMmdvmPacket::voice == type && IsValidDvLastFramePacket(Buffer, LastFrame) )
 		{
 			OnDvFramePacketIn(LastFrame, &Ip);
 		}
-		else if ( IsValidConnectPacket(Buffer, &Callsign, Ip) )
+		else if ( EMmdvmPacket::login == type && IsValidConnectPacket(Buffer, &Callsign, Ip) )
 		{
-			std::cout << "DMRmmdvm connect packet from " << Callsign << " at " << Ip << std::endl;
+			CLogLine(ELogLevel::info, "mmdvm-connect") << "DMRmmdvm connect packet from " << Callsign << " at " << Ip;
 
 			// callsign authorized?
 			if ( g_GateKeeper.MayLink(Callsign, Ip, EProtocol::dmrmmdvm) )
@@ -134,9 +152,9 @@ void CDmrmmdvmProtocol::Task(void)
 			}
 
 		}
-		else if ( IsValidAuthenticationPacket(Buffer, &Callsign, Ip) )
+		else if ( EMmdvmPacket::auth == type && IsValidAuthenticationPacket(Buffer, &Callsign, Ip) )
 		{
-			std::cout << "DMRmmdvm authentication packet from " << Callsign << " at " << Ip << std::endl;
+			CLogLine(ELogLevel::info, "mmdvm-login") << "DMRmmdvm authentication packet from " << Callsign << " at " << Ip;
 
 			// callsign authorized?
 			if ( g_GateKeeper.MayLink(Callsign, Ip, EProtocol::dmrmmdvm) )
@@ -151,7 +169,7 @@ void CDmrmmdvmProtocol::Task(void)
 				// client already connected ?
 				if ( client == nullptr )
 				{
-					std::cout << "DMRmmdvm login from " << Callsign << " at " << Ip << std::endl;
+					CLogLine(ELogLevel::info, "mmdvm-login") << "DMRmmdvm login from " << Callsign << " at " << Ip;
 
 					// create the client and append
 					clients->AddClient(std::make_shared<CDmrmmdvmClient>(Callsign, Ip));
@@ -171,9 +189,9 @@ void CDmrmmdvmProtocol::Task(void)
 			}
 
 		}
-		else if ( IsValidDisconnectPacket(Buffer, &Callsign) )
+		else if ( EMmdvmPacket::disconnect == type && IsValidDisconnectPacket(Buffer, &Callsign) )
 		{
-			std::cout << "DMRmmdvm disconnect packet from " << Callsign << " at " << Ip << std::endl;
+			CLogLine(ELogLevel::info, "mmdvm-disconnect") << "DMRmmdvm disconnect packet from " << Callsign << " at " << Ip;
 
 			// find client & remove it
 			CClients *clients = g_Reflector.GetClients();
@@ -184,15 +202,15 @@ void CDmrmmdvmProtocol::Task(void)
 			}
 			g_Reflector.ReleaseClients();
 		}
-		else if ( IsValidConfigPacket(Buffer, &Callsign, Ip) )
+		else if ( EMmdvmPacket::config == type && IsValidConfigPacket(Buffer, &Callsign, Ip) )
 		{
-			std::cout << "DMRmmdvm configuration packet from " << Callsign << " at " << Ip << std::endl;
+			CLogLine(ELogLevel::info, "mmdvm-config") << "DMRmmdvm configuration packet from " << Callsign << " at " << Ip;
 
 			// acknowledge the request
 			EncodeAckPacket(&Buffer, Callsign);
 			Send(Buffer, Ip);
 		}
-		else if ( IsValidKeepAlivePacket(Buffer, &Callsign) )
+		else if ( EMmdvmPacket::keepalive == type && IsValidKeepAlivePacket(Buffer, &Callsign) )
 		{
 			//std::cout << "DMRmmdvm keepalive packet from " << Callsign << " at " << Ip << std::endl;
 
@@ -211,15 +229,15 @@ void CDmrmmdvmProtocol::Task(void)
 			}
 			g_Reflector.ReleaseClients();
 		}
-		else if ( IsValidRssiPacket(Buffer, &Callsign, &iRssi) )
+		else if ( EMmdvmPacket::rssi == type && IsValidRssiPacket(Buffer, &Callsign, &iRssi) )
 		{
 			// std::cout << "DMRmmdvm RSSI packet from " << Callsign << " at " << Ip << std::endl
 
 			// ignore...
 		}
-		else if ( IsValidOptionPacket(Buffer, &Callsign) )
+		else if ( EMmdvmPacket::option == type && IsValidOptionPacket(Buffer, &Callsign) )
 		{
-			std::cout << "DMRmmdvm options packet from " << Callsign << " at " << Ip << std::endl;
+			CLogLine(ELogLevel::info, "mmdvm-config") << "DMRmmdvm options packet from " << Callsign << " at " << Ip;
 
 			// acknowledge the request
 			EncodeAckPacket(&Buffer, Callsign);
@@ -284,13 +302,13 @@ void CDmrmmdvmProtocol::OnDvHeaderPacketIn(std::unique_ptr<CDvHeaderPacket> &Hea
 				{
 					if ( g_Reflector.IsValidModule(rpt2.GetCSModule()) )
 					{
-						std::cout << "DMRmmdvm client " << client->GetCallsign() << " linking on module " << rpt2.GetCSModule() << std::endl;
+						CLogLine(ELogLevel::info, "mmdvm-link") << "DMRmmdvm client " << client->GetCallsign() << " linking on module " << rpt2.GetCSModule();
 						// link
 						client->SetReflectorModule(rpt2.GetCSModule());
 					}
 					else
 					{
-						std::cout << "DMRMMDVM node " << rpt1 << " link attempt on non-existing module" << std::endl;
+						CLogLine(ELogLevel::warning, "mmdvm-link-refused") << "DMRMMDVM node " << rpt1 << " link attempt on non-existing module";
 					}
 				}
 			}
@@ -299,7 +317,7 @@ void CDmrmmdvmProtocol::OnDvHeaderPacketIn(std::unique_ptr<CDvHeaderPacket> &Hea
 				// already linked
 				if ( cmd == CMD_UNLINK )
 				{
-					std::cout << "DMRmmdvm client " << client->GetCallsign() << " unlinking" << std::endl;
+					CLogLine(ELogLevel::info, "mmdvm-unlink") << "DMRmmdvm client " << client->GetCallsign() << " unlinking";
 					// unlink
 					client->SetReflectorModule(' ');
 				}
@@ -365,15 +383,17 @@ void CDmrmmdvmProtocol::HandleQueue(void)
 			m_StreamsCache[mod].m_dvHeader = CDvHeaderPacket((const CDvHeaderPacket &)*packet.get());
 			m_StreamsCache[mod].m_uiSeqId = 0;
 
-			// encode it
-			EncodeMMDVMHeaderPacket((CDvHeaderPacket &)*packet.get(), m_StreamsCache[mod].m_uiSeqId, &buffer);
+			// encode everything that's constant for the stream, including the header itself
+			EncodeStreamTemplates(m_StreamsCache[mod]);
+			buffer.Set(m_StreamsCache[mod].m_Header, MMDVM_PACKET_SIZE);
 			m_StreamsCache[mod].m_uiSeqId = 1;
 		}
 		// check if it's a last frame
 		else if ( packet->IsLastPacket() )
 		{
 			// encode it
-			EncodeLastMMDVMPacket(m_StreamsCache[mod].m_dvHeader, m_StreamsCache[mod].m_uiSeqId, &buffer);
+			buffer.Set(m_StreamsCache[mod].m_Terminator, MMDVM_PACKET_SIZE);
+			buffer.ReplaceAt(4, m_StreamsCache[mod].m_uiSeqId);
 			m_StreamsCache[mod].m_uiSeqId = (m_StreamsCache[mod].m_uiSeqId + 1) & 0xFF;
 		}
 		// otherwise, just a regular DV frame
@@ -389,7 +409,7 @@ void CDmrmmdvmProtocol::HandleQueue(void)
 				m_StreamsCache[mod].m_dvFrame1 = CDvFramePacket((const CDvFramePacket &)*packet.get());
 				break;
 			case 3:
-				EncodeMMDVMPacket(m_StreamsCache[mod].m_dvHeader, m_StreamsCache[mod].m_dvFrame0, m_StreamsCache[mod].m_dvFrame1, (const CDvFramePacket &)*packet.get(), m_StreamsCache[mod].m_uiSeqId, &buffer);
+				EncodeMMDVMPacket(m_StreamsCache[mod], (const CDvFramePacket &)*packet.get(), m_StreamsCache[mod].m_uiSeqId, &buffer);
 				m_StreamsCache[mod].m_uiSeqId = (m_StreamsCache[mod].m_uiSeqId + 1) & 0xFF;
 				break;
 			default:
@@ -400,6 +420,9 @@ void CDmrmmdvmProtocol::HandleQueue(void)
 		// send it
 		if ( buffer.size() > 0 )
 		{
+			// the repeater id is the recipient's, everything else is the same for all
+			buffer.AddPatch(MMDVM_RPTRID_OFFSET, 4);
+
 			// and push it to all our clients linked to the module and who are not streaming in
 			CClients *clients = g_Reflector.GetClients();
 			auto it = clients->begin();
@@ -410,6 +433,7 @@ void CDmrmmdvmProtocol::HandleQueue(void)
 				if ( !client->IsAMaster() && (client->GetReflectorModule() == packet->GetPacketModule()) )
 				{
 					// no, send the packet
+					buffer.Patch(0, client->GetCallsign().GetDmrid());
 					Send(buffer, client->GetIp());
 
 				}
@@ -448,7 +472,7 @@ void CDmrmmdvmProtocol::HandleKeepalives(void)
 			Send(disconnect, client->GetIp());
 
 			// remove it
-			std::cout << "DMRmmdvm client " << client->GetCallsign() << " keepalive timeout" << std::endl;
+			CLogLine(ELogLevel::info, "mmdvm-keepalive-timeout") << "DMRmmdvm client " << client->GetCallsign() << " keepalive timeout";
 			clients->RemoveClient(client);
 		}
 
@@ -459,7 +483,7 @@ void CDmrmmdvmProtocol::HandleKeepalives(void)
 ////////////////////////////////////////////////////////////////////////////////////////
 // packet decoding helpers
 
-bool CDmrmmdvmProtocol::IsValidKeepAlivePacket(const CBuffer &Buffer, CCallsign *callsign)
+bool CDmrmmdvmProtocol::IsValidKeepAlivePacket(const CBufferView &Buffer, CCallsign *callsign)
 {
 	uint8_t tag[] = { 'R','P','T','P','I','N','G' };
 
@@ -474,7 +498,7 @@ bool CDmrmmdvmProtocol::IsValidKeepAlivePacket(const CBuffer &Buffer, CCallsign
 	return valid;
 }
 
-bool CDmrmmdvmProtocol::IsValidConnectPacket(const CBuffer &Buffer, CCallsign *callsign, const CIp &Ip)
+bool CDmrmmdvmProtocol::IsValidConnectPacket(const CBufferView &Buffer, CCallsign *callsign, const CIp &Ip)
 {
 	uint8_t tag[] = { 'R','P','T','L' };
 
@@ -487,13 +511,13 @@ bool CDmrmmdvmProtocol::IsValidConnectPacket(const CBuffer &Buffer, CCallsign *c
 		valid = callsign->IsValid();
 		if ( !valid)
 		{
-			std::cout << "Invalid callsign in DMRmmdvm RPTL packet from IP: " << Ip << " CS:" << *callsign << " DMRID:" << callsign->GetDmrid() << std::endl;
+			CLogLine(ELogLevel::warning, "mmdvm-invalid-callsign") << "Invalid callsign in DMRmmdvm RPTL packet from IP: " << Ip << " CS:" << *callsign << " DMRID:" << callsign->GetDmrid();
 		}
 	}
 	return valid;
 }
 
-bool CDmrmmdvmProtocol::IsValidAuthenticationPacket(const CBuffer &Buffer, CCallsign *callsign, const CIp &Ip)
+bool CDmrmmdvmProtocol::IsValidAuthenticationPacket(const CBufferView &Buffer, CCallsign *callsign, const CIp &Ip)
 {
 	uint8_t tag[] = { 'R','P','T','K' };
 
@@ -506,14 +530,14 @@ bool CDmrmmdvmProtocol::IsValidAuthenticationPacket(const CBuffer &Buffer, CCall
 		valid = callsign->IsValid();
 		if ( !valid)
 		{
-			std::cout << "Invalid callsign in DMRmmdvm RPTK packet from IP: " << Ip << " CS:" << *callsign << " DMRID:" << callsign->GetDmrid() << std::endl;
+			CLogLine(ELogLevel::warning, "mmdvm-invalid-callsign") << "Invalid callsign in DMRmmdvm RPTK packet from IP: " << Ip << " CS:" << *callsign << " DMRID:" << callsign->GetDmrid();
 		}
 
 	}
 	return valid;
 }
 
-bool CDmrmmdvmProtocol::IsValidDisconnectPacket(const CBuffer &Buffer, CCallsign *callsign)
+bool CDmrmmdvmProtocol::IsValidDisconnectPacket(const CBufferView &Buffer, CCallsign *callsign)
 {
 	uint8_t tag[] = { 'R','P','T','C','L' };
 
@@ -528,7 +552,7 @@ bool CDmrmmdvmProtocol::IsValidDisconnectPacket(const CBuffer &Buffer, CCallsign
 	return valid;
 }
 
-bool CDmrmmdvmProtocol::IsValidConfigPacket(const CBuffer &Buffer, CCallsign *callsign, const CIp &Ip)
+bool CDmrmmdvmProtocol::IsValidConfigPacket(const CBufferView &Buffer, CCallsign *callsign, const CIp &Ip)
 {
 	uint8_t tag[] = { 'R','P','T','C' };
 
@@ -541,14 +565,14 @@ bool CDmrmmdvmProtocol::IsValidConfigPacket(const CBuffer &Buffer, CCallsign *ca
 		valid = callsign->IsValid();
 		if ( !valid)
 		{
-			std::cout << "Invalid callsign in DMRmmdvm RPTC packet from IP: " << Ip << " CS:" << *callsign << " DMRID:" << callsign->GetDmrid() << std::endl;
+			CLogLine(ELogLevel::warning, "mmdvm-invalid-callsign") << "Invalid callsign in DMRmmdvm RPTC packet from IP: " << Ip << " CS:" << *callsign << " DMRID:" << callsign->GetDmrid();
 		}
 
 	}
 	return valid;
 }
 
-bool CDmrmmdvmProtocol::IsValidOptionPacket(const CBuffer &Buffer, CCallsign *callsign)
+bool CDmrmmdvmProtocol::IsValidOptionPacket(const CBufferView &Buffer, CCallsign *callsign)
 {
 	uint8_t tag[] = { 'R','P','T','O' };
 
@@ -563,7 +587,7 @@ bool CDmrmmdvmProtocol::IsValidOptionPacket(const CBuffer &Buffer, CCallsign *ca
 	return valid;
 }
 
-bool CDmrmmdvmProtocol::IsValidRssiPacket(const CBuffer &Buffer, CCallsign *callsign, int *rssi)
+bool CDmrmmdvmProtocol::IsValidRssiPacket(const CBufferView &Buffer, CCallsign *callsign, int *rssi)
 {
 	uint8_t tag[] = { 'R','P','T','I','N','T','R' };
 
@@ -578,7 +602,7 @@ bool CDmrmmdvmProtocol::IsValidRssiPacket(const CBuffer &Buffer, CCallsign *call
 	return valid;
 }
 
-bool CDmrmmdvmProtocol::IsValidDvHeaderPacket(const CBuffer &Buffer, std::unique_ptr<CDvHeaderPacket> &header, uint8_t *cmd, uint8_t *CallType)
+bool CDmrmmdvmProtocol::IsValidDvHeaderPacket(const CBufferView &Buffer, std::unique_ptr<CDvHeaderPacket> &header, uint8_t *cmd, uint8_t *CallType)
 {
 	uint8_t tag[] = { 'D','M','R','D' };
 
@@ -652,7 +676,7 @@ bool CDmrmmdvmProtocol::IsValidDvHeaderPacket(const CBuffer &Buffer, std::unique
 	return false;
 }
 
-bool CDmrmmdvmProtocol::IsValidDvFramePacket(const CIp &Ip, const CBuffer &Buffer, std::unique_ptr<CDvHeaderPacket> &header, std::array<std::unique_ptr<CDvFramePacket>, 3> &frames)
+bool CDmrmmdvmProtocol::IsValidDvFramePacket(const CIp &Ip, const CBufferView &Buffer, std::unique_ptr<CDvHeaderPacket> &header, std::array<std::unique_ptr<CDvFramePacket>, 3> &frames)
 {
 	uint8_t tag[] = { 'D','M','R','D' };
 
@@ -676,9 +700,7 @@ bool CDmrmmdvmProtocol::IsValidDvFramePacket(const CIp &Ip, const CBuffer &Buffe
 			auto stream = GetStream(uiStreamId, &Ip);
 			if ( !stream )
 			{
-				std::cout << std::showbase << std::hex;
-				std::cout << "Late entry DMR voice frame, creating DMR header for DMR stream ID " << ntohl(uiStreamId) << std::noshowbase << std::dec << " on " << Ip << std::endl;
-				std::cout << std::noshowbase << std::dec;
+				CLogLine(ELogLevel::info, "mmdvm-late-entry") << "Late entry DMR voice frame, creating DMR header for DMR stream ID " << std::showbase << std::hex << ntohl(uiStreamId) << std::noshowbase << std::dec << " on " << Ip;
 				uint8_t cmd;
 
 				// link/unlink command ?
@@ -755,7 +777,7 @@ bool CDmrmmdvmProtocol::IsValidDvFramePacket(const CIp &Ip, const CBuffer &Buffe
 	return false;
 }
 
-bool CDmrmmdvmProtocol::IsValidDvLastFramePacket(const CBuffer &Buffer, std::unique_ptr<CDvFramePacket> &frame)
+bool CDmrmmdvmProtocol::IsValidDvLastFramePacket(const CBufferView &Buffer, std::unique_ptr<CDvFramePacket> &frame)
 {
 	uint8_t tag[] = { 'D','M','R','D' };
 
@@ -891,43 +913,40 @@ bool CDmrmmdvmProtocol::EncodeMMDVMHeaderPacket(const CDvHeaderPacket &Packet, u
 	return true;
 }
 
-void CDmrmmdvmProtocol::EncodeMMDVMPacket(const CDvHeaderPacket &Header, const CDvFramePacket &DvFrame0, const CDvFramePacket &DvFrame1, const CDvFramePacket &DvFrame2, uint8_t seqid, CBuffer *Buffer) const
+void CDmrmmdvmProtocol::EncodeMMDVMPacket(const CDmrmmdvmStreamCacheItem &Cache, const CDvFramePacket &DvFrame2, uint8_t seqid, CBuffer *Buffer) const
 {
-	uint8_t tag[] = { 'D','M','R','D' };
-	Buffer->Set(tag, sizeof(tag));
-	uint8_t cs[12];
+	const CDvFramePacket &DvFrame0 = Cache.m_dvFrame0;
+	const CDvFramePacket &DvFrame1 = Cache.m_dvFrame1;
+
+	// start with the stream's voice template
+	Buffer->Set((uint8_t *)Cache.m_Voice, MMDVM_PACKET_SIZE);
+	uint8_t *data = Buffer->data();
 
 	// DMR header
 	// uiSeqId
-	Buffer->Append((uint8_t)seqid);
-	// uiSrcId
-	uint32_t uiSrcId = Header.GetMyCallsign().GetDmrid();
-	DvFrame0.GetMyCallsign().GetCallsign(cs);
-
-    if(uiSrcId == 0){
-		uiSrcId = DvFrame0.GetMyCallsign().GetDmrid();
-	}
-	if(uiSrcId == 0){
-		uiSrcId = DvFrame1.GetMyCallsign().GetDmrid();
-	}
-	if(uiSrcId == 0){
-		uiSrcId = DvFrame2.GetMyCallsign().GetDmrid();
-	}
-	if(uiSrcId == 0){
-		uiSrcId = m_DefaultId;
+	data[4] = seqid;
+	// uiSrcId, from the frames if the header doesn't have one
+	if ( Cache.m_uiSrcId == 0 )
+	{
+		uint32_t uiSrcId = DvFrame0.GetMyCallsign().GetDmrid();
+		if(uiSrcId == 0){
+			uiSrcId = DvFrame1.GetMyCallsign().GetDmrid();
+		}
+		if(uiSrcId == 0){
+			uiSrcId = DvFrame2.GetMyCallsign().GetDmrid();
+		}
+		if(uiSrcId == 0){
+			uiSrcId = m_DefaultId;
+		}
+		data[5] = (uint8_t)LOBYTE(HIWORD(uiSrcId));
+		data[6] = (uint8_t)HIBYTE(LOWORD(uiSrcId));
+		data[7] = (uint8_t)LOBYTE(LOWORD(uiSrcId));
 	}
-
-	AppendDmrIdToBuffer(Buffer, uiSrcId);
-	// uiDstId = TG9
-	uint32_t uiDstId = 9; // ModuleToDmrDestId(Header.GetRpt2Module());
-	AppendDmrIdToBuffer(Buffer, uiDstId);
-	// uiRptrId
-	uint32_t uiRptrId = Header.GetRpt1Callsign().GetDmrid();
-	AppendDmrRptrIdToBuffer(Buffer, uiRptrId);
 	// uiBitField
+	const uint8_t uiDmrPacketId = DvFrame0.GetDmrPacketId();
 	uint8_t uiBitField =
 		((DMRMMDVM_REFLECTOR_SLOT == DMR_SLOT2) ? 0x80 : 0x00);
-	if ( DvFrame0.GetDmrPacketId() == 0 )
+	if ( uiDmrPacketId == 0 )
 	{
 		uiBitField |= (DMRMMDVM_FRAMETYPE_VOICESYNC << 4);
 	}
@@ -935,38 +954,23 @@ void CDmrmmdvmProtocol::EncodeMMDVMPacket(const CDvHeaderPacket &Header, const C
 	{
 		uiBitField |= (DMRMMDVM_FRAMETYPE_VOICE << 4);
 	}
-	uiBitField |= (DvFrame0.GetDmrPacketId() & 0x0F);
-	Buffer->Append((uint8_t)uiBitField);
-
-	// uiStreamId
-	uint32_t uiStreamId = Header.GetStreamId();
-	Buffer->Append((uint32_t)uiStreamId);
+	uiBitField |= (uiDmrPacketId & 0x0F);
+	data[15] = uiBitField;
 
 	// Payload
+	const uint8_t *frame1 = DvFrame1.GetCodecData(ECodecType::dmr);
+	const uint8_t *emb = Cache.m_Emb[(uiDmrPacketId < 5) ? uiDmrPacketId : 5];
 	// frame0
-	Buffer->ReplaceAt(20, DvFrame0.GetCodecData(ECodecType::dmr), 9);
-	// 1/2 frame1
-	Buffer->ReplaceAt(29, DvFrame1.GetCodecData(ECodecType::dmr), 5);
-	Buffer->ReplaceAt(33, (uint8_t)(Buffer->at(33) & 0xF0));
+	memcpy(data+20, DvFrame0.GetCodecData(ECodecType::dmr), 9);
+	// 1/2 frame1 and the sync or embedded signaling
+	memcpy(data+29, frame1, 4);
+	data[33] = (frame1[4] & 0xF0) | (emb[0] & 0x0F);
+	memcpy(data+34, emb+1, 5);
 	// 1/2 frame1
-	Buffer->ReplaceAt(39, DvFrame1.GetCodecData(ECodecType::dmr)+4, 5);
-	Buffer->ReplaceAt(39, (uint8_t)(Buffer->at(39) & 0x0F));
+	data[39] = (emb[6] & 0xF0) | (frame1[4] & 0x0F);
+	memcpy(data+40, frame1+5, 4);
 	// frame2
-	Buffer->ReplaceAt(44, DvFrame2.GetCodecData(ECodecType::dmr), 9);
-
-	// sync or embedded signaling
-	ReplaceEMBInBuffer(Buffer, DvFrame0.GetDmrPacketId());
-
-	// debug
-	//CBuffer dump;
-	//dump.Set(&(Buffer->data()[33]), 7);
-	//dump.DebugDump(g_Reflector.m_DebugFile);
-
-	// BER
-	Buffer->Append((uint8_t)0);
-
-	// RSSI
-	Buffer->Append((uint8_t)0);
+	memcpy(data+44, DvFrame2.GetCodecData(ECodecType::dmr), 9);
 }
 
 
@@ -1009,6 +1013,31 @@ void CDmrmmdvmProtocol::EncodeLastMMDVMPacket(const CDvHeaderPacket &Packet, uin
 }
 
 
+void CDmrmmdvmProtocol::EncodeStreamTemplates(CDmrmmdvmStreamCacheItem &Cache) const
+{
+	CBuffer buffer;
+
+	// the header and terminator only need their seqid set
+	EncodeMMDVMHeaderPacket(Cache.m_dvHeader, 0, &buffer);
+	memcpy(Cache.m_Header, buffer.data(), MMDVM_PACKET_SIZE);
+	EncodeLastMMDVMPacket(Cache.m_dvHeader, 0, &buffer);
+	memcpy(Cache.m_Terminator, buffer.data(), MMDVM_PACKET_SIZE);
+
+	// voice packets have the same ids and stream id as the header
+	Cache.m_uiSrcId = Cache.m_dvHeader.GetMyCallsign().GetDmrid();
+	memset(Cache.m_Voice, 0, MMDVM_PACKET_SIZE);
+	memcpy(Cache.m_Voice, Cache.m_Header, 20);
+
+	// the sync or EMB for each voice packet in the superframe
+	for ( uint8_t id = 0; id < 6; id++ )
+	{
+		buffer.clear();
+		buffer.resize(MMDVM_PACKET_SIZE);
+		ReplaceEMBInBuffer(&buffer, id);
+		memcpy(Cache.m_Emb[id], buffer.data()+33, MMDVM_EMB_SIZE);
+	}
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////
 // DestId to Module helper
 
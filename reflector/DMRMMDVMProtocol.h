@@ -39,6 +39,11 @@
 // DMRMMDVM Module ID
 #define MMDVM_MODULE_ID             'B'
 
+// DMRD packet
+#define MMDVM_PACKET_SIZE            55
+#define MMDVM_EMB_SIZE               7
+#define MMDVM_RPTRID_OFFSET          11
+
 ////////////////////////////////////////////////////////////////////////////////////////
 // class
 
@@ -50,6 +55,13 @@ public:
 	CDvFramePacket  m_dvFrame1;
 
 	uint8_t  m_uiSeqId;
+
+	// encoded once when the header arrives, they don't change for the life of the stream
+	uint32_t m_uiSrcId;
+	uint8_t  m_Header[MMDVM_PACKET_SIZE];
+	uint8_t  m_Voice[MMDVM_PACKET_SIZE];        // only the seqid, bitfield and payload change
+	uint8_t  m_Terminator[MMDVM_PACKET_SIZE];   // only the seqid changes
+	uint8_t  m_Emb[6][MMDVM_EMB_SIZE];          // sync or embedded signalling for voice packets A to F
 };
 
 
@@ -73,16 +85,16 @@ protected:
 	void OnDvHeaderPacketIn(std::unique_ptr<CDvHeaderPacket> &, const CIp &, uint8_t, uint8_t);
 
 	// packet decoding helpers
-	bool IsValidConnectPacket(const CBuffer &, CCallsign *, const CIp &);
-	bool IsValidAuthenticationPacket(const CBuffer &, CCallsign *, const CIp &);
-	bool IsValidDisconnectPacket(const CBuffer &, CCallsign *);
-	bool IsValidConfigPacket(const CBuffer &, CCallsign *, const CIp &);
-	bool IsValidOptionPacket(const CBuffer &, CCallsign *);
-	bool IsValidKeepAlivePacket(const CBuffer &, CCallsign *);
-	bool IsValidRssiPacket(const CBuffer &, CCallsign *, int *);
-	bool IsValidDvHeaderPacket(const CBuffer &, std::unique_ptr<CDvHeaderPacket> &, uint8_t *, uint8_t *);
-	bool IsValidDvFramePacket(const CIp &, const CBuffer &, std::unique_ptr<CDvHeaderPacket> &, std::array<std::unique_ptr<CDvFramePacket>, 3> &);
-	bool IsValidDvLastFramePacket(const CBuffer &, std::unique_ptr<CDvFramePacket> &);
+	bool IsValidConnectPacket(const CBufferView &, CCallsign *, const CIp &);
+	bool IsValidAuthenticationPacket(const CBufferView &, CCallsign *, const CIp &);
+	bool IsValidDisconnectPacket(const CBufferView &, CCallsign *);
+	bool IsValidConfigPacket(const CBufferView &, CCallsign *, const CIp &);
+	bool IsValidOptionPacket(const CBufferView &, CCallsign *);
+	bool IsValidKeepAlivePacket(const CBufferView &, CCallsign *);
+	bool IsValidRssiPacket(const CBufferView &, CCallsign *, int *);
+	bool IsValidDvHeaderPacket(const CBufferView &, std::unique_ptr<CDvHeaderPacket> &, uint8_t *, uint8_t *);
+	bool IsValidDvFramePacket(const CIp &, const CBufferView &, std::unique_ptr<CDvHeaderPacket> &, std::array<std::unique_ptr<CDvFramePacket>, 3> &);
+	bool IsValidDvLastFramePacket(const CBufferView &, std::unique_ptr<CDvFramePacket> &);
 
 	// packet encoding helpers
 	void EncodeKeepAlivePacket(CBuffer *, std::shared_ptr<CClient>);
@@ -91,8 +103,9 @@ protected:
 	void EncodeNackPacket(CBuffer *, const CCallsign &);
 	void EncodeClosePacket(CBuffer *, std::shared_ptr<CClient>);
 	bool EncodeMMDVMHeaderPacket(const CDvHeaderPacket &, uint8_t, CBuffer *) const;
-	void EncodeMMDVMPacket(const CDvHeaderPacket &, const CDvFramePacket &, const CDvFramePacket &, const CDvFramePacket &, uint8_t, CBuffer *) const;
+	void EncodeMMDVMPacket(const CDmrmmdvmStreamCacheItem &, const CDvFramePacket &, uint8_t, CBuffer *) const;
 	void EncodeLastMMDVMPacket(const CDvHeaderPacket &, uint8_t, CBuffer *) const;
+	void EncodeStreamTemplates(CDmrmmdvmStreamCacheItem &) const;
 
 	// dmr DstId to Module helper
 	char DmrDstIdToModule(uint32_t) const;
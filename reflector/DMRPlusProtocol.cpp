@@ -115,7 +115,7 @@ void CDmrplusProtocol::Task(void)
 				// client already connected ?
 				if ( client == nullptr )
 				{
-					std::cout << "DMRplus connect packet for module " << ToLinkModule << " from " << Callsign << " at " << Ip << std::endl;
+					CLogLine(ELogLevel::info, "dmrplus-connect") << "DMRplus connect packet for module " << ToLinkModule << " from " << Callsign << " at " << Ip;
 
 					// create the client and append
 					clients->AddClient(std::make_shared<CDmrplusClient>(Callsign, Ip, ToLinkModule));
@@ -137,7 +137,7 @@ void CDmrplusProtocol::Task(void)
 		}
 		else if ( IsValidDisconnectPacket(Buffer, &Callsign, &ToLinkModule) )
 		{
-			std::cout << "DMRplus disconnect packet for module " << ToLinkModule << " from " << Callsign << " at " << Ip << std::endl;
+			CLogLine(ELogLevel::info, "dmrplus-disconnect") << "DMRplus disconnect packet for module " << ToLinkModule << " from " << Callsign << " at " << Ip;
 
 			// find client & remove it
 			CClients *clients = g_Reflector.GetClients();
@@ -152,7 +152,7 @@ void CDmrplusProtocol::Task(void)
 		{
 			std::string title("Unknown DMR+ packet from ");
 			title += Ip.GetAddress();
-			Buffer.Dump(title);
+			Dump(title.c_str(), Buffer.data(), Buffer.size());
 		}
 	}
 
@@ -340,7 +340,7 @@ void CDmrplusProtocol::HandleKeepalives(void)
 			//Send(disconnect, client->GetIp());
 
 			// remove it
-			std::cout << "DMRplus client " << client->GetCallsign() << " keepalive timeout" << std::endl;
+			CLogLine(ELogLevel::info, "dmrplus-keepalive-timeout") << "DMRplus client " << client->GetCallsign() << " keepalive timeout";
 			clients->RemoveClient(client);
 		}
 
@@ -351,7 +351,7 @@ void CDmrplusProtocol::HandleKeepalives(void)
 ////////////////////////////////////////////////////////////////////////////////////////
 // packet decoding helpers
 
-bool CDmrplusProtocol::IsValidConnectPacket(const CBuffer &Buffer, CCallsign *callsign, char *reflectormodule, const CIp &Ip)
+bool CDmrplusProtocol::IsValidConnectPacket(const CBufferView &Buffer, CCallsign *callsign, char *reflectormodule, const CIp &Ip)
 {
 	bool valid = false;
 	if ( Buffer.size() == 31 )
@@ -368,13 +368,13 @@ bool CDmrplusProtocol::IsValidConnectPacket(const CBuffer &Buffer, CCallsign *ca
 		valid = (callsign->IsValid() && (std::isupper(*reflectormodule) || (*reflectormodule == ' ')) );
 		if ( !valid)
 		{
-			std::cout << "Invalid callsign in DMR+ connect packet from IP: " << Ip << " CS:" << *callsign << " DMRID:" << callsign->GetDmrid() << " ReflectorModule:" << *reflectormodule << std::endl;
+			CLogLine(ELogLevel::warning, "dmrplus-invalid-callsign") << "Invalid callsign in DMR+ connect packet from IP: " << Ip << " CS:" << *callsign << " DMRID:" << callsign->GetDmrid() << " ReflectorModule:" << *reflectormodule;
 		}
 	}
 	return valid;
 }
 
-bool CDmrplusProtocol::IsValidDisconnectPacket(const CBuffer &Buffer, CCallsign *callsign, char *reflectormodule)
+bool CDmrplusProtocol::IsValidDisconnectPacket(const CBufferView &Buffer, CCallsign *callsign, char *reflectormodule)
 {
 	bool valid = false;
 	if ( Buffer.size() == 32 )
@@ -391,7 +391,7 @@ bool CDmrplusProtocol::IsValidDisconnectPacket(const CBuffer &Buffer, CCallsign
 	return valid;
 }
 
-bool CDmrplusProtocol::IsValidDvHeaderPacket(const CIp &Ip, const CBuffer &Buffer, std::unique_ptr<CDvHeaderPacket> &Header)
+bool CDmrplusProtocol::IsValidDvHeaderPacket(const CIp &Ip, const CBufferView &Buffer, std::unique_ptr<CDvHeaderPacket> &Header)
 {
 	uint8_t uiPacketType = Buffer.data()[8];
 	if ( (Buffer.size() == 72)  && ( uiPacketType == 2 ) )
@@ -425,7 +425,7 @@ bool CDmrplusProtocol::IsValidDvHeaderPacket(const CIp &Ip, const CBuffer &Buffe
 	return false;
 }
 
-bool CDmrplusProtocol::IsValidDvFramePacket(const CIp &Ip, const CBuffer &Buffer, std::array<std::unique_ptr<CDvFramePacket>, 3> &frames)
+bool CDmrplusProtocol::IsValidDvFramePacket(const CIp &Ip, const CBufferView &Buffer, std::array<std::unique_ptr<CDvFramePacket>, 3> &frames)
 {
 	uint8_t uiPacketType = Buffer.data()[8];
 	if ( (Buffer.size() == 72)  && ((uiPacketType == 1) || (uiPacketType == 3)) )
@@ -67,10 +67,10 @@ protected:
 	void OnDvHeaderPacketIn(std::unique_ptr<CDvHeaderPacket> &, const CIp &);
 
 	// packet decoding helpers
-	bool IsValidConnectPacket(const CBuffer &, CCallsign *, char *, const CIp &);
-	bool IsValidDisconnectPacket(const CBuffer &, CCallsign *, char *);
-	bool IsValidDvHeaderPacket(const CIp &, const CBuffer &, std::unique_ptr<CDvHeaderPacket> &);
-	bool IsValidDvFramePacket(const CIp &, const CBuffer &, std::array<std::unique_ptr<CDvFramePacket>, 3> &);
+	bool IsValidConnectPacket(const CBufferView &, CCallsign *, char *, const CIp &);
+	bool IsValidDisconnectPacket(const CBufferView &, CCallsign *, char *);
+	bool IsValidDvHeaderPacket(const CIp &, const CBufferView &, std::unique_ptr<CDvHeaderPacket> &);
+	bool IsValidDvFramePacket(const CIp &, const CBufferView &, std::array<std::unique_ptr<CDvFramePacket>, 3> &);
 
 	// packet encoding helpers
 	void EncodeConnectAckPacket(CBuffer *);
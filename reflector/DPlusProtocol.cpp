@@ -35,6 +35,9 @@ bool CDplusProtocol::Initialize(const char *type, const EProtocol ptype, const u
 	// update time
 	m_LastKeepaliveTime.start();
 
+	// only send a client the streams on its module?
+	m_bSelectedModuleOnly = g_Configure.GetBoolean(g_Keys.dplus.selectedmodule);
+
 	// done
 	return true;
 }
@@ -79,14 +82,14 @@ void CDplusProtocol::Task(void)
 		}
 		else if ( IsValidConnectPacket(Buffer) )
 		{
-			std::cout << "DPlus connect request packet from " << Ip << std::endl;
+			CLogLine(ELogLevel::info, "dplus-connect") << "DPlus connect request packet from " << Ip;
 
 			// acknowledge the request
 			Send(Buffer, Ip);
 		}
 		else if ( IsValidLoginPacket(Buffer, &Callsign) )
 		{
-			std::cout << "DPlus login packet from " << Callsign << " at " << Ip << std::endl;
+			CLogLine(ELogLevel::info, "dplus-login") << "DPlus login packet from " << Callsign << " at " << Ip;
 
 			// callsign authorized?
 			if ( g_GateKeeper.MayLink(Callsign, Ip, EProtocol::dplus) )
@@ -109,7 +112,7 @@ void CDplusProtocol::Task(void)
 		}
 		else if ( IsValidDisconnectPacket(Buffer) )
 		{
-			std::cout << "DPlus disconnect packet from " << Ip << std::endl;
+			CLogLine(ELogLevel::info, "dplus-disconnect") << "DPlus disconnect packet from " << Ip;
 
 			// find client
 			CClients *clients = g_Reflector.GetClients();
@@ -142,7 +145,7 @@ void CDplusProtocol::Task(void)
 		{
 			std::string title("Unknown DPlus packet from ");
 			title += Ip.GetAddress();
-			Buffer.Dump(title);
+			Dump(title.c_str(), Buffer.data(), Buffer.size());
 		}
 	}
 
@@ -218,7 +221,7 @@ void CDplusProtocol::OnDvHeaderPacketIn(std::unique_ptr<CDvHeaderPacket> &Header
 		}
 		else
 		{
-			std::cout << "DPlus node " << rpt1 << " link attempt on non-existing module" << std::endl;
+			CLogLine(ELogLevel::warning, "dplus-link-refused") << "DPlus node " << rpt1 << " link attempt on non-existing module";
 		}
 	}
 }
@@ -248,45 +251,59 @@ void CDplusProtocol::HandleQueue(void)
 		CBuffer buffer;
 		if ( EncodeDvPacket(*packet, buffer) )
 		{
+			// is it time to insert a DVheader copy ?
+			// this is counted per module, not per client
+			bool insert = false;
+			if ( packet->IsDvFrame() )
+			{
+				insert = (m_StreamsCache[mod].m_iSeqCounter == 20);
+				m_StreamsCache[mod].m_iSeqCounter = (m_StreamsCache[mod].m_iSeqCounter + 1) % 21;
+			}
+
 			// and push it to all our clients who are not streaming in
 			// note that for dplus protocol, all stream of all modules are push to all clients
 			// it's client who decide which stream he's interrrested in
+			// unless SelectedModuleOnly is set, then a client only gets the module it last
+			// transmitted on, or every module if it hasn't transmitted yet
 			CClients *clients = g_Reflector.GetClients();
 			auto it = clients->begin();
 			std::shared_ptr<CClient>client = nullptr;
 			while ( (client = clients->FindNextClient(EProtocol::dplus, it)) != nullptr )
 			{
 				// is this client busy ?
-				if ( !client->IsAMaster() )
+				if ( client->IsAMaster() )
+					continue;
+
+				// is it listening to another module ?
+				if ( m_bSelectedModuleOnly && client->HasReflectorModule() && (client->GetReflectorModule() != mod) )
+					continue;
+
+				// check if client is a dextra dongle
+				// then replace RPT2 with XRF instead of REF
+				// if the client type is not yet known, send bothheaders
+				if ( packet->IsDvHeader() )
 				{
-					// check if client is a dextra dongle
-					// then replace RPT2 with XRF instead of REF
-					// if the client type is not yet known, send bothheaders
-					if ( packet->IsDvHeader() )
-					{
-						// sending header in Dplus is client specific
-						SendDvHeader((CDvHeaderPacket *)packet.get(), (CDplusClient *)client.get());
-					}
-					else if ( packet->IsDvFrame() )
-					{
-						// and send the DV frame
-						Send(buffer, client->GetIp());
-
-						// is it time to insert a DVheader copy ?
-						if ( (m_StreamsCache[mod].m_iSeqCounter++ % 21) == 20 )
-						{
-							// yes, clone it
-							CDvHeaderPacket packet2(m_StreamsCache[mod].m_dvHeader);
-							// and send it
-							SendDvHeader(&packet2, (CDplusClient *)client.get());
-						}
-					}
-					else
+					// sending header in Dplus is client specific
+					SendDvHeader((CDvHeaderPacket *)packet.get(), (CDplusClient *)client.get());
+				}
+				else if ( packet->IsDvFrame() )
+				{
+					// and send the DV frame
+					Send(buffer, client->GetIp());
+
+					if ( insert )
 					{
-						// otherwise, send the original packet
-						Send(buffer, client->GetIp());
+						// yes, clone it
+						CDvHeaderPacket packet2(m_StreamsCache[mod].m_dvHeader);
+						// and send it
+						SendDvHeader(&packet2, (CDplusClient *)client.get());
 					}
 				}
+				else
+				{
+					// otherwise, send the original packet
+					Send(buffer, client->GetIp());
+				}
 			}
 			g_Reflector.ReleaseClients();
 		}
@@ -364,7 +381,7 @@ void CDplusProtocol::HandleKeepalives(void)
 			Send(disconnect, client->GetIp());
 
 			// and remove it
-			std::cout << "DPlus client " << client->GetCallsign() << " keepalive timeout" << std::endl;
+			CLogLine(ELogLevel::info, "dplus-keepalive-timeout") << "DPlus client " << client->GetCallsign() << " keepalive timeout";
 			clients->RemoveClient(client);
 		}
 	}
@@ -374,13 +391,13 @@ void CDplusProtocol::HandleKeepalives(void)
 ////////////////////////////////////////////////////////////////////////////////////////
 // packet decoding helpers
 
-bool CDplusProtocol::IsValidConnectPacket(const CBuffer &Buffer)
+bool CDplusProtocol::IsValidConnectPacket(const CBufferView &Buffer)
 {
 	uint8_t tag[] = { 0x05,0x00,0x18,0x00,0x01 };
-	return (Buffer == CBuffer(tag, sizeof(tag)));
+	return ((Buffer.size() == sizeof(tag)) && Buffer.StartsWith(tag, sizeof(tag)));
 }
 
-bool CDplusProtocol::IsValidLoginPacket(const CBuffer &Buffer, CCallsign *Callsign)
+bool CDplusProtocol::IsValidLoginPacket(const CBufferView &Buffer, CCallsign *Callsign)
 {
 	uint8_t Tag[] = { 0x1C,0xC0,0x04,0x00 };
 	bool valid = false;
@@ -393,19 +410,19 @@ bool CDplusProtocol::IsValidLoginPacket(const CBuffer &Buffer, CCallsign *Callsi
 	return valid;
 }
 
-bool CDplusProtocol::IsValidDisconnectPacket(const CBuffer &Buffer)
+bool CDplusProtocol::IsValidDisconnectPacket(const CBufferView &Buffer)
 {
 	uint8_t tag[] = { 0x05,0x00,0x18,0x00,0x00 };
-	return (Buffer == CBuffer(tag, sizeof(tag)));
+	return ((Buffer.size() == sizeof(tag)) && Buffer.StartsWith(tag, sizeof(tag)));
 }
 
-bool CDplusProtocol::IsValidKeepAlivePacket(const CBuffer &Buffer)
+bool CDplusProtocol::IsValidKeepAlivePacket(const CBufferView &Buffer)
 {
 	uint8_t tag[] = { 0x03,0x60,0x00 };
-	return (Buffer == CBuffer(tag, sizeof(tag)));
+	return ((Buffer.size() == sizeof(tag)) && Buffer.StartsWith(tag, sizeof(tag)));
 }
 
-bool CDplusProtocol::IsValidDvHeaderPacket(const CBuffer &Buffer, std::unique_ptr<CDvHeaderPacket> &header)
+bool CDplusProtocol::IsValidDvHeaderPacket(const CBufferView &Buffer, std::unique_ptr<CDvHeaderPacket> &header)
 {
 	if ( 58==Buffer.size() && 0x3au==Buffer.data()[0] && 0x80u==Buffer.data()[1] && 0==memcmp(Buffer.data()+2, "DSVT", 4) && 0x10u==Buffer.data()[6] && 0x20u==Buffer.data()[10] )
 	{
@@ -417,7 +434,7 @@ bool CDplusProtocol::IsValidDvHeaderPacket(const CBuffer &Buffer, std::unique_pt
 	return false;
 }
 
-bool CDplusProtocol::IsValidDvFramePacket(const CBuffer &Buffer, std::unique_ptr<CDvFramePacket> &dvframe)
+bool CDplusProtocol::IsValidDvFramePacket(const CBufferView &Buffer, std::unique_ptr<CDvFramePacket> &dvframe)
 {
 	if (0==memcmp(Buffer.data()+2, "DSVT", 4) && 0x80u==Buffer.data()[1] && 0x20u==Buffer.data()[6] && 0x20u==Buffer.data()[10])
 	{
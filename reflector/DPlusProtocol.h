@@ -56,12 +56,12 @@ protected:
 	void OnDvHeaderPacketIn(std::unique_ptr<CDvHeaderPacket> &, const CIp &);
 
 	// packet decoding helpers
-	bool IsValidConnectPacket(const CBuffer &);
-	bool IsValidLoginPacket(const CBuffer &, CCallsign *);
-	bool IsValidDisconnectPacket(const CBuffer &);
-	bool IsValidKeepAlivePacket(const CBuffer &);
-	bool IsValidDvHeaderPacket(const CBuffer &, std::unique_ptr<CDvHeaderPacket> &);
-	bool IsValidDvFramePacket(const CBuffer &, std::unique_ptr<CDvFramePacket> &);
+	bool IsValidConnectPacket(const CBufferView &);
+	bool IsValidLoginPacket(const CBufferView &, CCallsign *);
+	bool IsValidDisconnectPacket(const CBufferView &);
+	bool IsValidKeepAlivePacket(const CBufferView &);
+	bool IsValidDvHeaderPacket(const CBufferView &, std::unique_ptr<CDvHeaderPacket> &);
+	bool IsValidDvFramePacket(const CBufferView &, std::unique_ptr<CDvFramePacket> &);
 
 	// packet encoding helpers
 	void EncodeKeepAlivePacket(CBuffer *);
@@ -77,4 +77,7 @@ protected:
 
 	// for queue header caches
 	std::unordered_map<char, CDPlusStreamCacheItem> m_StreamsCache;
+
+	// config data
+	bool m_bSelectedModuleOnly;
 };
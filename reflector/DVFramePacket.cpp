@@ -172,7 +172,7 @@ std::unique_ptr<CPacket> CDvFramePacket::Copy(void)
 	return std::unique_ptr<CPacket>(new CDvFramePacket(*this));
 }
 
-CDvFramePacket::CDvFramePacket(const CBuffer &buf) : CPacket(buf)
+CDvFramePacket::CDvFramePacket(const CBufferView &buf) : CPacket(buf)
 {
 	if (buf.size() >= GetNetworkSize())
 	{
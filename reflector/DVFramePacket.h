@@ -59,7 +59,7 @@ public:
 	// USRP Frame
 	CDvFramePacket(const int16_t *usrp, uint16_t streamid, bool islast);
 	// URF Network
-	CDvFramePacket(const CBuffer &buf);
+	CDvFramePacket(const CBufferView &buf);
 
 	static constexpr unsigned GetNetworkSize() noexcept
 	{
@@ -35,7 +35,7 @@ CDvHeaderPacket::CDvHeaderPacket()
 }
 
 // network
-CDvHeaderPacket::CDvHeaderPacket(const CBuffer &buf) : CPacket(buf)
+CDvHeaderPacket::CDvHeaderPacket(const CBufferView &buf) : CPacket(buf)
 {
 	if (buf.size() >= GetNetworkSize())
 	{
@@ -61,7 +61,7 @@ public:
 	CDvHeaderPacket(const CM17Packet &);
 
 	// network
-	CDvHeaderPacket(const CBuffer &buf);
+	CDvHeaderPacket(const CBufferView &buf);
 	static unsigned int GetNetworkSize();
 	void EncodeInterlinkPacket(CBuffer &buf) const;
 
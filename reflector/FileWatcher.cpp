@@ -0,0 +1,210 @@
+// urfd -- The universal reflector
+// Copyright © 2024 Thomas A. Early N7TAE
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include <iostream>
+#include <cstring>
+#include <cerrno>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/inotify.h>
+#include <sys/stat.h>
+
+#include "FileWatcher.h"
+
+CFileWatcher::CFileWatcher() : m_fd(-1), m_NextHandle(0), m_LastPoll(0), keep_running(false) {}
+
+CFileWatcher::~CFileWatcher()
+{
+	Stop();
+}
+
+bool CFileWatcher::Start(void)
+{
+	m_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+	if (m_fd < 0)
+		std::cerr << "File watcher can't use inotify, files will be polled: " << strerror(errno) << std::endl;
+
+	// anything watched before the start
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		for (auto &w : m_Watches)
+			AddWatch(w);
+	}
+
+	keep_running = true;
+	try
+	{
+		m_Future = std::async(std::launch::async, &CFileWatcher::Thread, this);
+	}
+	catch (const std::exception &e)
+	{
+		std::cerr << "Cannot start the file watcher thread: " << e.what() << std::endl;
+		keep_running = false;
+		return true;
+	}
+	return false;
+}
+
+void CFileWatcher::Stop(void)
+{
+	keep_running = false;
+	if (m_Future.valid())
+		m_Future.get();
+	if (m_fd >= 0)
+	{
+		close(m_fd);
+		m_fd = -1;
+	}
+}
+
+int CFileWatcher::Watch(const std::string &path, std::function<void()> callback)
+{
+	SWatch w;
+	w.wd = -1;
+	w.path = path;
+	auto slash = path.rfind('/');
+	w.name = (std::string::npos == slash) ? path : path.substr(slash + 1);
+	w.mtime = GetModTime(path);
+	w.callback = callback;
+
+	std::lock_guard<std::mutex> lock(m_Mutex);
+	w.handle = ++m_NextHandle;
+	if (m_fd >= 0)
+		AddWatch(w);
+	m_Watches.push_back(w);
+	return w.handle;
+}
+
+void CFileWatcher::Unwatch(int handle)
+{
+	std::lock_guard<std::mutex> lock(m_Mutex);
+	for (auto it = m_Watches.begin(); it != m_Watches.end(); it++)
+	{
+		if (handle == it->handle)
+		{
+			// the directory may be watched for another file, so its watch is left alone
+			m_Watches.erase(it);
+			return;
+		}
+	}
+}
+
+// with m_Mutex locked
+void CFileWatcher::AddWatch(SWatch &w)
+{
+	if (m_fd < 0 || w.wd >= 0)
+		return;
+	// writing a link's target doesn't touch the link's directory, and the target may be anywhere
+	struct stat sb;
+	if (0 == lstat(w.path.c_str(), &sb) && S_ISLNK(sb.st_mode))
+	{
+		std::cout << "File watcher: " << w.path << " is a symbolic link, it will be polled" << std::endl;
+		return;
+	}
+	auto slash = w.path.rfind('/');
+	const std::string dir = (std::string::npos == slash) ? "." : ((0 == slash) ? "/" : w.path.substr(0, slash));
+	// inotify gives back the same watch for a directory that's already watched
+	w.wd = inotify_add_watch(m_fd, dir.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO);
+	if (w.wd < 0)
+		std::cerr << "File watcher can't watch " << dir << ", " << w.path << " will be polled: " << strerror(errno) << std::endl;
+}
+
+void CFileWatcher::Thread(void)
+{
+	while (keep_running)
+	{
+		if (m_fd >= 0)
+		{
+			struct pollfd pfd = { m_fd, POLLIN, 0 };
+			if (0 < poll(&pfd, 1, FILEWATCH_WAKE_MS))
+				ReadEvents();
+		}
+		else
+		{
+			usleep(FILEWATCH_WAKE_MS * 1000);
+		}
+		Poll();
+	}
+}
+
+void CFileWatcher::ReadEvents(void)
+{
+	alignas(struct inotify_event) char buf[4096];
+	while (true)
+	{
+		auto len = read(m_fd, buf, sizeof(buf));
+		if (len <= 0)
+			return;
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		for (char *p = buf; p < buf + len; )
+		{
+			auto ev = reinterpret_cast<const struct inotify_event *>(p);
+			p += sizeof(struct inotify_event) + ev->len;
+			if (ev->mask & IN_IGNORED)
+			{
+				// the directory was removed or unmounted, and its watch with it
+				for (auto &w : m_Watches)
+				{
+					if (ev->wd == w.wd)
+					{
+						std::cout << "File watcher lost the directory of " << w.path << ", it will be polled" << std::endl;
+						w.wd = -1;
+						w.mtime = GetModTime(w.path);
+					}
+				}
+				continue;
+			}
+			if (0 == ev->len)
+				continue;
+			for (auto &w : m_Watches)
+			{
+				if (ev->wd == w.wd && 0 == w.name.compare(ev->name))
+					w.callback();
+			}
+		}
+	}
+}
+
+// the files inotify couldn't watch, or that it stopped watching
+void CFileWatcher::Poll(void)
+{
+	const auto now = time(nullptr);
+	if (now - m_LastPoll < FILEWATCH_POLL_SECONDS)
+		return;
+	m_LastPoll = now;
+
+	std::lock_guard<std::mutex> lock(m_Mutex);
+	for (auto &w : m_Watches)
+	{
+		if (w.wd >= 0)
+			continue;
+		const auto mtime = GetModTime(w.path);
+		if (mtime != w.mtime)
+		{
+			w.mtime = mtime;
+			if (mtime)
+				w.callback();
+		}
+	}
+}
+
+std::time_t CFileWatcher::GetModTime(const std::string &path)
+{
+	struct stat fileStat;
+	if (0 == stat(path.c_str(), &fileStat))
+		return fileStat.st_mtime;
+	return 0;
+}
@@ -0,0 +1,77 @@
+// urfd -- The universal reflector
+// Copyright © 2024 Thomas A. Early N7TAE
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <atomic>
+#include <ctime>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#define FILEWATCH_WAKE_MS       1000    // how often the thread looks at keep_running
+#define FILEWATCH_POLL_SECONDS  10      // how often a file is stat()ed if inotify can't watch it
+
+////////////////////////////////////////////////////////////////////////////////////////
+// One thread that tells the rest of the reflector when one of its files has changed.
+// It watches each file's directory with inotify, so a file that's written in place
+// and one that's replaced by a rename, the way editors and dbutil save, are both
+// seen the moment they're closed. A file whose directory can't be watched, one that's
+// a symbolic link, and one whose directory goes away, is stat()ed every
+// FILEWATCH_POLL_SECONDS instead. The callbacks run on the watcher's thread,
+// with the watch list locked, so one that returns from Unwatch() will never run again.
+// A callback should be quick, or hand the work to its owner's thread.
+
+class CFileWatcher
+{
+public:
+	CFileWatcher();
+	~CFileWatcher();
+
+	bool Start(void);
+	void Stop(void);
+
+	// returns a handle for Unwatch()
+	int Watch(const std::string &path, std::function<void()> callback);
+	void Unwatch(int handle);
+
+protected:
+	struct SWatch
+	{
+		int handle;
+		int wd;				// the directory's inotify watch, -1 if it's polled
+		std::string path, name;
+		std::time_t mtime;	// for polling
+		std::function<void()> callback;
+	};
+
+	void Thread(void);
+	void AddWatch(SWatch &w);
+	void ReadEvents(void);
+	void Poll(void);
+	static std::time_t GetModTime(const std::string &path);
+
+	int m_fd;
+	int m_NextHandle;
+	std::mutex m_Mutex;
+	std::vector<SWatch> m_Watches;
+	std::time_t m_LastPoll;
+
+	std::atomic<bool> keep_running;
+	std::future<void> m_Future;
+};
@@ -19,7 +19,6 @@
 #include <netinet/ip.h>
 #include <netinet/ip_icmp.h>
 #include <string.h>
-#include <sys/stat.h>
 
 #include "Global.h"
 #include "G3Client.h"
@@ -37,6 +36,7 @@ bool CG3Protocol::Initialize(const char */*type*/, const EProtocol /*type*/, con
 	const std::string ipv4address(g_Configure.GetString(g_Keys.ip.ipv4bind));
 
 	ReadOptions();
+	m_WatchHandle = g_FileWatcher.Watch(m_TerminalPath, [this]() { m_TerminalChanged = true; });
 
 	// init reflector apparent callsign
 	m_ReflectorCallsign = g_Reflector.GetCallsign();
@@ -44,6 +44,12 @@ bool CG3Protocol::Initialize(const char */*type*/, const EProtocol /*type*/, con
 	// reset stop flag
 	keep_running = true;
 
+	// flood protection, the same limit on all three sockets
+	m_Port = G3_DV_PORT;
+	ConfigureRateLimiter(m_RateLimiter, EProtocol::g3);
+	ConfigureRateLimiter(m_PresenceLimiter, EProtocol::g3);
+	ConfigureRateLimiter(m_ConfigLimiter, EProtocol::g3);
+
 	// update the reflector callsign
 	//m_ReflectorCallsign.PatchCallsign(0, "XLX", 3);
 
@@ -95,6 +101,12 @@ bool CG3Protocol::Initialize(const char */*type*/, const EProtocol /*type*/, con
 
 void CG3Protocol::Close(void)
 {
+	if (m_WatchHandle)
+	{
+		g_FileWatcher.Unwatch(m_WatchHandle);
+		m_WatchHandle = 0;
+	}
+
 	if (m_PresenceFuture.valid())
 	{
 		m_PresenceFuture.get();
@@ -109,6 +121,11 @@ void CG3Protocol::Close(void)
 	{
 		m_IcmpFuture.get();
 	}
+
+	if (m_PresenceLimiter.IsEnabled())
+		m_PresenceLimiter.Report(G3_PRESENCE_PORT, std::cout);
+	if (m_ConfigLimiter.IsEnabled())
+		m_ConfigLimiter.Report(G3_CONFIG_PORT, std::cout);
 }
 
 
@@ -152,7 +169,7 @@ void CG3Protocol::PresenceTask(void)
 	CCallsign           Terminal;
 
 
-	if ( m_PresenceSocket.Receive(Buffer, ReqIp, 20) )
+	if ( m_PresenceSocket.Receive(Buffer, ReqIp, 20) && g_GateKeeper.MayReceive(ReqIp) && m_PresenceLimiter.Admit(ReqIp) )
 	{
 
 		CIp Ip(ReqIp);
@@ -239,7 +256,7 @@ void CG3Protocol::ConfigTask(void)
 	CCallsign           Call;
 	bool                isRepeaterCall;
 
-	if ( m_ConfigSocket.Receive(&Buffer, &Ip, 20) != -1 )
+	if ( m_ConfigSocket.Receive(&Buffer, &Ip, 20) != -1 && g_GateKeeper.MayReceive(Ip) && m_ConfigLimiter.Admit(Ip) )
 	{
 		if (Buffer.size() == 16)
 		{
@@ -376,7 +393,7 @@ void CG3Protocol::Task(void)
 	std::unique_ptr<CDvFramePacket>     Frame;
 
 	// any incoming packet ?
-	if ( m_Socket4.Receive(Buffer, Ip, 20) )
+	if ( m_Socket4.Receive(Buffer, Ip, 20) && g_GateKeeper.MayReceive(Ip) && m_RateLimiter.Admit(Ip) )
 	{
 		CIp ClIp;
 		CIp *BaseIp = nullptr;
@@ -431,10 +448,10 @@ void CG3Protocol::Task(void)
 
 		// update time
 		m_LastKeepaliveTime.start();
-
-		// reload option if needed - called once every G3_KEEPALIVE_PERIOD
-		NeedReload();
 	}
+
+	// reload options if the terminal file has changed
+	NeedReload();
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////
@@ -583,7 +600,7 @@ void CG3Protocol::OnDvHeaderPacketIn(std::unique_ptr<CDvHeaderPacket> &Header, c
 ////////////////////////////////////////////////////////////////////////////////////////
 // packet decoding helpers
 
-bool CG3Protocol::IsValidDvHeaderPacket(const CBuffer &Buffer, std::unique_ptr<CDvHeaderPacket> &header)
+bool CG3Protocol::IsValidDvHeaderPacket(const CBufferView &Buffer, std::unique_ptr<CDvHeaderPacket> &header)
 {
 	if ( 56==Buffer.size() && 0==Buffer.Compare((uint8_t *)"DSVT", 4) && 0x10U==Buffer.data()[4] && 0x20U==Buffer.data()[8] )
 	{
@@ -596,7 +613,7 @@ bool CG3Protocol::IsValidDvHeaderPacket(const CBuffer &Buffer, std::unique_ptr<C
 	return false;
 }
 
-bool CG3Protocol::IsValidDvFramePacket(const CBuffer &Buffer, std::unique_ptr<CDvFramePacket> &dvframe)
+bool CG3Protocol::IsValidDvFramePacket(const CBufferView &Buffer, std::unique_ptr<CDvFramePacket> &dvframe)
 {
 	if ( 27==Buffer.size() && 0==Buffer.Compare((uint8_t *)"DSVT", 4) && 0x20U==Buffer.data()[4] && 0x20U==Buffer.data()[8] )
 	{
@@ -670,28 +687,23 @@ char *CG3Protocol::TrimWhiteSpaces(char *str)
 
 void CG3Protocol::NeedReload(void)
 {
-	struct stat fileStat;
-
-	if (::stat(m_TerminalPath.c_str(), &fileStat) != -1)
+	if (m_TerminalChanged.exchange(false))
 	{
-		if (m_LastModTime != fileStat.st_mtime)
-		{
-			ReadOptions();
+		ReadOptions();
 
-			// we have new options - iterate on clients for potential removal
-			CClients *clients = g_Reflector.GetClients();
-			auto it = clients->begin();
-			std::shared_ptr<CClient>client = nullptr;
-			while ( (client = clients->FindNextClient(EProtocol::g3, it)) != nullptr )
+		// we have new options - iterate on clients for potential removal
+		CClients *clients = g_Reflector.GetClients();
+		auto it = clients->begin();
+		std::shared_ptr<CClient>client = nullptr;
+		while ( (client = clients->FindNextClient(EProtocol::g3, it)) != nullptr )
+		{
+			char module = client->GetReflectorModule();
+			if (!strchr(m_Modules.c_str(), module) && !strchr(m_Modules.c_str(), '*'))
 			{
-				char module = client->GetReflectorModule();
-				if (!strchr(m_Modules.c_str(), module) && !strchr(m_Modules.c_str(), '*'))
-				{
-					clients->RemoveClient(client);
-				}
+				clients->RemoveClient(client);
 			}
-			g_Reflector.ReleaseClients();
 		}
+		g_Reflector.ReleaseClients();
 	}
 }
 
@@ -744,12 +756,5 @@ void CG3Protocol::ReadOptions(void)
 		}
 		std::cout << "G3 handler loaded " << opts << " options from file " << m_TerminalPath << std::endl;
 		file.close();
-
-		struct stat fileStat;
-
-		if (::stat(m_TerminalPath.c_str(), &fileStat) != -1)
-		{
-			m_LastModTime = fileStat.st_mtime;
-		}
 	}
 }
@@ -58,7 +58,7 @@ class CG3Protocol : public CSEProtocol
 {
 public:
 	// constructor
-	CG3Protocol() : m_GwAddress(0u), m_Modules("*"), m_LastModTime(0) {}
+	CG3Protocol() : m_GwAddress(0u), m_Modules("*"), m_TerminalChanged(false), m_WatchHandle(0) {}
 
 	// initialization
 	bool Initialize(const char *type, const EProtocol ptype, const uint16_t port, const bool has_ipv4, const bool has_ipv6);
@@ -97,8 +97,8 @@ protected:
 	void OnDvHeaderPacketIn(std::unique_ptr<CDvHeaderPacket> &, const CIp &);
 
 	// packet decoding helpers
-	bool IsValidDvHeaderPacket(const CBuffer &, std::unique_ptr<CDvHeaderPacket> &);
-	bool IsValidDvFramePacket(const CBuffer &, std::unique_ptr<CDvFramePacket> &);
+	bool IsValidDvHeaderPacket(const CBufferView &, std::unique_ptr<CDvHeaderPacket> &);
+	bool IsValidDvFramePacket(const CBufferView &, std::unique_ptr<CDvFramePacket> &);
 
 	// packet encoding helpers
 	bool EncodeDvHeaderPacket(const CDvHeaderPacket &, CBuffer &) const;
@@ -115,9 +115,14 @@ protected:
 	CUdpMsgSocket       m_ConfigSocket;
 	CRawSocket          m_IcmpRawSocket;
 
+	// the helper sockets have their own threads, so each has its own limiter
+	CRateLimiter        m_PresenceLimiter;
+	CRateLimiter        m_ConfigLimiter;
+
 	// optional params
 	uint32_t              m_GwAddress;
 	std::string         m_Modules;
-	time_t              m_LastModTime;
 	std::string         m_TerminalPath;
+	std::atomic<bool>   m_TerminalChanged;	// set by the file watcher
+	int                 m_WatchHandle;
 };
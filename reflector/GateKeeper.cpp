@@ -25,7 +25,6 @@
 
 CGateKeeper::CGateKeeper()
 {
-	keep_running = true;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////
@@ -47,24 +46,27 @@ bool CGateKeeper::Init(void)
 	m_WhiteSet.LoadFromFile(g_Configure.GetString(g_Keys.files.white));
 	m_BlackSet.LoadFromFile(g_Configure.GetString(g_Keys.files.black));
 	m_InterlinkMap.LoadFromFile(g_Configure.GetString(g_Keys.files.interlink));
+	if (g_Configure.Contains(g_Keys.files.iplist))
+		m_IpList.LoadFromFile(g_Configure.GetString(g_Keys.files.iplist));
 
-	// reset run flag
-	keep_running = true;
-
-	// start  thread;
-	m_Future = std::async(std::launch::async, &CGateKeeper::Thread, this);
+	// and reload each one as soon as it's saved
+	m_Watches.push_back(g_FileWatcher.Watch(g_Configure.GetString(g_Keys.files.white), [this]() { m_WhiteSet.ReloadFromFile(); }));
+	m_Watches.push_back(g_FileWatcher.Watch(g_Configure.GetString(g_Keys.files.black), [this]() { m_BlackSet.ReloadFromFile(); }));
+	m_Watches.push_back(g_FileWatcher.Watch(g_Configure.GetString(g_Keys.files.interlink), [this]() { m_InterlinkMap.ReloadFromFile(); }));
+	if (g_Configure.Contains(g_Keys.files.iplist))
+		m_Watches.push_back(g_FileWatcher.Watch(g_Configure.GetString(g_Keys.files.iplist), [this]() { m_IpList.ReloadFromFile(); }));
 
 	return true;
 }
 
 void CGateKeeper::Close(void)
 {
-	// kill threads
-	keep_running = false;
-	if ( m_Future.valid() )
-	{
-		m_Future.get();
-	}
+	// stop reloading
+	for (auto handle : m_Watches)
+		g_FileWatcher.Unwatch(handle);
+	if ( m_Watches.size() && m_IpList.GetDenied() )
+		std::cout << "Gatekeeper IP access list denied " << m_IpList.GetDenied() << " datagrams" << std::endl;
+	m_Watches.clear();
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////
@@ -90,7 +92,7 @@ bool CGateKeeper::MayLink(const CCallsign &callsign, const CIp &ip, EProtocol pr
 	case EProtocol::nxdn:
 	case EProtocol::g3:
 		// is callsign listed OK
-		ok = IsNodeListedOk(base);
+		ok = IsNodeListedOk(base, ip);
 		break;
 
 	// URF and BM interlinks
@@ -108,7 +110,7 @@ bool CGateKeeper::MayLink(const CCallsign &callsign, const CIp &ip, EProtocol pr
 	// report
 	if ( ! ok )
 	{
-		std::cout << "Gatekeeper blocking linking of " << callsign << " @ " << ip << " using protocol " << ProtocolName(protocol) << std::endl;
+		CLogLine(ELogLevel::warning, "gatekeeper-link") << "Gatekeeper blocking linking" << Field("callsign", callsign) << Field("ip", ip) << Field("protocol", ProtocolName(protocol));
 	}
 
 	// done
@@ -137,14 +139,14 @@ bool CGateKeeper::MayTransmit(const CCallsign &callsign, const CIp &ip, const EP
 	case EProtocol::usrp:
 	case EProtocol::g3:
 		// first check is IP & callsigned listed OK
-		ok = IsNodeListedOk(base);
+		ok = IsNodeListedOk(base, ip);
 		// todo: then apply any protocol specific authorisation for the operation
 		break;
 
 	// URF interlinks
 	case EProtocol::urf:
 	case EProtocol::bm:
-		ok = IsPeerListedOk(base, module);
+		ok = IsPeerListedOk(base, ip, module);
 		break;
 
 	// unsupported
@@ -157,65 +159,35 @@ bool CGateKeeper::MayTransmit(const CCallsign &callsign, const CIp &ip, const EP
 	// report
 	if ( !ok )
 	{
-		std::cout << "Gatekeeper blocking transmitting of " << callsign << " @ " << ip << " using protocol " << ProtocolName(protocol) << std::endl;
+		CLogLine(ELogLevel::warning, "gatekeeper-transmit") << "Gatekeeper blocking transmitting" << Field("callsign", callsign) << Field("ip", ip) << Field("protocol", ProtocolName(protocol));
 	}
 
 	// done
 	return ok;
 }
 
-////////////////////////////////////////////////////////////////////////////////////////
-// thread
-
-void CGateKeeper::Thread()
-{
-	while (keep_running)
-	{
-		// Wait 30 seconds
-		for (int i=0; i<15 && keep_running; i++)
-			std::this_thread::sleep_for(std::chrono::milliseconds(2000));
-
-		// have lists files changed ?
-		if ( m_WhiteSet.NeedReload() )
-		{
-			m_WhiteSet.ReloadFromFile();
-		}
-		if ( m_BlackSet.NeedReload() )
-		{
-			m_BlackSet.ReloadFromFile();
-		}
-		if ( m_InterlinkMap.NeedReload() )
-		{
-			m_InterlinkMap.ReloadFromFile();
-		}
-	}
-}
-
 ////////////////////////////////////////////////////////////////////////////////////////
 // operation helpers
 
-bool CGateKeeper::IsNodeListedOk(const std::string &callsign) const
+bool CGateKeeper::IsNodeListedOk(const std::string &callsign, const CIp &ip) const
 {
-	bool ok = true;
+	// first check IP
+	bool ok = m_IpList.IsAllowed(ip);
 
 	// next, check callsign
 	if ( ok )
 	{
 		// first check if callsign is in white list
 		// note if white list is empty, everybody is authorized
-		m_WhiteSet.Lock();
 		if ( ! m_WhiteSet.empty() )
 		{
 			ok = m_WhiteSet.IsMatched(callsign);
 		}
-		m_WhiteSet.Unlock();
 
 		// then check if not blacklisted
 		if (ok)
 		{
-			m_BlackSet.Lock();
 			ok = ! m_BlackSet.IsMatched(callsign);
-			m_BlackSet.Unlock();
 		}
 	}
 
@@ -224,11 +196,10 @@ bool CGateKeeper::IsNodeListedOk(const std::string &callsign) const
 
 }
 
-bool CGateKeeper::IsPeerListedOk(const std::string &callsign, char module) const
+bool CGateKeeper::IsPeerListedOk(const std::string &callsign, const CIp &ip, char module) const
 {
-	bool ok = true;
-
 	// first check IP
+	bool ok = m_IpList.IsAllowed(ip);
 
 	// next, check callsign
 	if ( ok )
@@ -248,9 +219,8 @@ bool CGateKeeper::IsPeerListedOk(const std::string &callsign, char module) const
 
 bool CGateKeeper::IsPeerListedOk(const std::string &callsign, const CIp &ip, char *modules) const
 {
-	bool ok = true;
-
 	// first check IP
+	bool ok = m_IpList.IsAllowed(ip);
 
 	// next, check callsign
 	if ( ok )
@@ -23,6 +23,7 @@
 #include "Callsign.h"
 #include "IP.h"
 #include "BlackWhiteSet.h"
+#include "IpAccessList.h"
 #include "InterlinkMap.h"
 
 ////////////////////////////////////////////////////////////////////////////////////////
@@ -48,22 +49,22 @@ public:
 	bool MayLink(const CCallsign &, const CIp &, const EProtocol, char * = nullptr) const;
 	bool MayTransmit(const CCallsign &, const CIp &, EProtocol = EProtocol::any, char = ' ') const;
 
-protected:
-	// thread
-	void Thread();
+	// checked on every datagram, before it's parsed
+	bool MayReceive(const CIp &Ip) const { return m_IpList.IsAllowed(Ip); }
 
+protected:
 	// operation helpers
-	bool IsNodeListedOk(const std::string &) const;
-	bool IsPeerListedOk(const std::string &, char) const;
+	bool IsNodeListedOk(const std::string &, const CIp &) const;
+	bool IsPeerListedOk(const std::string &, const CIp &, char) const;
 	bool IsPeerListedOk(const std::string &, const CIp &, char *) const;
 	const std::string ProtocolName(EProtocol) const;
 
 protected:
 	// data
 	CBlackWhiteSet m_WhiteSet, m_BlackSet;
+	CIpAccessList  m_IpList;
 	CInterlinkMap  m_InterlinkMap;
 
-	// thread
-	std::atomic<bool> keep_running;
-	std::future<void> m_Future;
+	// file watcher handles
+	std::vector<int> m_Watches;
 };
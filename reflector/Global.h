@@ -23,6 +23,8 @@
 #include "LookupYsf.h"
 #include "TCSocket.h"
 #include "JsonKeys.h"
+#include "Log.h"
+#include "FileWatcher.h"
 
 extern CReflector  g_Reflector;
 extern CGateKeeper g_GateKeeper;
@@ -33,3 +35,4 @@ extern CLookupNxdn g_LNid;
 extern CLookupYsf  g_LYtr;
 extern SJsonKeys   g_Keys;
 extern CTCServer   g_TCServer;
+extern CFileWatcher g_FileWatcher;
@@ -230,6 +230,24 @@ std::ostream &operator<<(std::ostream &stream, const CIp &Ip)
 	return stream;
 }
 
+// 127.0.0.0/8, ::1 and ::ffff:127.0.0.0/104
+bool CIp::IsLoopback() const
+{
+	if (AF_INET == addr.ss_family)
+	{
+		auto addr4 = (struct sockaddr_in *)&addr;
+		return (ntohl(addr4->sin_addr.s_addr) >> 24) == 127U;
+	}
+	else if (AF_INET6 == addr.ss_family)
+	{
+		auto addr6 = (struct sockaddr_in6 *)&addr;
+		if (IN6_IS_ADDR_LOOPBACK(&addr6->sin6_addr))
+			return true;
+		return IN6_IS_ADDR_V4MAPPED(&addr6->sin6_addr) && 127U == addr6->sin6_addr.s6_addr[12];
+	}
+	return false;
+}
+
 uint32_t CIp::GetAddr() const
 {
 	if (AF_INET6 == addr.ss_family)
@@ -47,6 +47,7 @@ public:
 	// state methods
 	bool IsSet() const { return is_set; }
 	bool AddressIsZero() const;
+	bool IsLoopback() const;
 	void ClearAddress();
 	const char *GetAddress() const;
 	operator const char *() const { return GetAddress(); }
@@ -0,0 +1,91 @@
+// urfd -- The universal reflector
+// Copyright © 2024 Thomas A. Early N7TAE
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <cstdint>
+
+#define ID_CACHE_SIZE       32      // resolutions remembered by each thread, for each direction
+
+////////////////////////////////////////////////////////////////////////////////////////
+// The last few lookups one thread made in an ID database. It's small enough that a
+// linear search of its keys is quicker than hashing, and when it's full the least
+// recently used entry is replaced. Each cache belongs to one thread, so nothing here
+// is synchronized. The cache remembers which generation of the database its answers
+// came from, and forgets them all when a new one is published.
+
+template <typename K, typename V> class CIdCache
+{
+public:
+	CIdCache() : m_generation(0), m_count(0), m_clock(0) {}
+
+	// empty the cache if the database has changed since it was filled
+	void Validate(uint32_t generation)
+	{
+		if (generation != m_generation)
+		{
+			m_generation = generation;
+			m_count = 0;
+		}
+	}
+
+	bool Find(const K &key, V &value)
+	{
+		for (unsigned i = 0; i < m_count; i++)
+		{
+			if (m_entries[i].key == key)
+			{
+				m_entries[i].used = ++m_clock;
+				value = m_entries[i].value;
+				return true;
+			}
+		}
+		return false;
+	}
+
+	void Insert(const K &key, const V &value)
+	{
+		unsigned i = m_count;
+		if (ID_CACHE_SIZE == m_count)
+		{
+			// replace the least recently used
+			i = 0;
+			for (unsigned j = 1; j < ID_CACHE_SIZE; j++)
+			{
+				if (m_entries[j].used < m_entries[i].used)
+					i = j;
+			}
+		}
+		else
+			m_count++;
+		m_entries[i].key = key;
+		m_entries[i].value = value;
+		m_entries[i].used = ++m_clock;
+	}
+
+private:
+	struct SEntry
+	{
+		K key;
+		V value;
+		uint32_t used;
+	};
+
+	uint32_t m_generation;
+	unsigned m_count;
+	uint32_t m_clock;
+	SEntry m_entries[ID_CACHE_SIZE];
+};
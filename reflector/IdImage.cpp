@@ -0,0 +1,171 @@
+// urfd -- The universal reflector
+// Copyright © 2024 Thomas A. Early N7TAE
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <utility>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "IdImage.h"
+
+static_assert(sizeof(UCallsign) == sizeof(uint64_t), "a callsign key must fit in a uint64_t");
+
+CIdImage::~CIdImage()
+{
+	if (m_base)
+		munmap(m_base, m_size);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////
+// reading
+
+bool CIdImage::IsImage(const std::string &path)
+{
+	char magic[8] = { 0 };
+	std::ifstream file(path, std::ios::binary);
+	if (file)
+		file.read(magic, sizeof(magic));
+	return 0 == memcmp(magic, IDIMAGE_MAGIC, sizeof(magic));
+}
+
+bool CIdImage::Open(const std::string &path)
+{
+	auto fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+	if (fd < 0)
+	{
+		std::cerr << "Can't open ID image " << path << ": " << strerror(errno) << std::endl;
+		return false;
+	}
+	struct stat st;
+	if (fstat(fd, &st) || size_t(st.st_size) < sizeof(SHeader))
+	{
+		std::cerr << "ID image " << path << " is too short" << std::endl;
+		close(fd);
+		return false;
+	}
+	auto base = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);	// the mapping holds its own reference
+	if (MAP_FAILED == base)
+	{
+		std::cerr << "Can't map ID image " << path << ": " << strerror(errno) << std::endl;
+		return false;
+	}
+
+	auto hdr = (const SHeader *)base;
+	const size_t expected = sizeof(SHeader) + 12 * size_t(hdr->ncalls) + 12 * size_t(hdr->nids);
+	if (memcmp(hdr->magic, IDIMAGE_MAGIC, sizeof(hdr->magic)) || IDIMAGE_VERSION != hdr->version || size_t(st.st_size) != expected)
+	{
+		std::cerr << "ID image " << path << " is not valid, recompile it with dbutil" << std::endl;
+		munmap(base, st.st_size);
+		return false;
+	}
+
+	m_base = base;
+	m_size = st.st_size;
+	m_ncalls = hdr->ncalls;
+	m_nids = hdr->nids;
+	m_keys = (const uint64_t *)(hdr + 1);
+	m_callsigns = m_keys + m_ncalls;
+	m_keyids = (const uint32_t *)(m_callsigns + m_nids);
+	m_ids = m_keyids + m_ncalls;
+	return true;
+}
+
+bool CIdImage::FindId(const UCallsign &ucs, uint32_t &id) const
+{
+	auto end = m_keys + m_ncalls;
+	auto found = std::lower_bound(m_keys, end, ucs.l);
+	if (found == end || *found != ucs.l)
+		return false;
+	id = m_keyids[found - m_keys];
+	return true;
+}
+
+bool CIdImage::FindCallsign(uint32_t id, UCallsign &ucs) const
+{
+	auto end = m_ids + m_nids;
+	auto found = std::lower_bound(m_ids, end, id);
+	if (found == end || *found != id)
+		return false;
+	ucs.l = m_callsigns[found - m_ids];
+	return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////
+// writing
+
+bool CIdImage::Write(const std::string &path, const std::unordered_map<uint32_t, UCallsign> &callsigns, const std::unordered_map<UCallsign, uint32_t, CCallsignHash, CCallsignEqual> &ids)
+{
+	std::vector<std::pair<uint64_t, uint32_t>> bycall;
+	bycall.reserve(ids.size());
+	for (const auto &item : ids)
+		bycall.emplace_back(item.first.l, item.second);
+	std::sort(bycall.begin(), bycall.end());
+
+	std::vector<std::pair<uint32_t, uint64_t>> byid;
+	byid.reserve(callsigns.size());
+	for (const auto &item : callsigns)
+		byid.emplace_back(item.first, item.second.l);
+	std::sort(byid.begin(), byid.end());
+
+	SHeader hdr;
+	memset(&hdr, 0, sizeof(hdr));
+	memcpy(hdr.magic, IDIMAGE_MAGIC, sizeof(hdr.magic));
+	hdr.version = IDIMAGE_VERSION;
+	hdr.ncalls = uint32_t(bycall.size());
+	hdr.nids = uint32_t(byid.size());
+
+	const std::string tmp(path + ".tmp");
+	std::ofstream file(tmp, std::ios::binary | std::ios::trunc);
+	if (! file)
+	{
+		std::cerr << "Can't create " << tmp << ": " << strerror(errno) << std::endl;
+		return false;
+	}
+	file.write((const char *)&hdr, sizeof(hdr));
+	for (const auto &item : bycall)
+		file.write((const char *)&item.first, sizeof(item.first));
+	for (const auto &item : byid)
+		file.write((const char *)&item.second, sizeof(item.second));
+	for (const auto &item : bycall)
+		file.write((const char *)&item.second, sizeof(item.second));
+	for (const auto &item : byid)
+		file.write((const char *)&item.first, sizeof(item.first));
+	file.close();
+	if (file.fail())
+	{
+		std::cerr << "Can't write " << tmp << std::endl;
+		remove(tmp.c_str());
+		return false;
+	}
+
+	if (rename(tmp.c_str(), path.c_str()))
+	{
+		std::cerr << "Can't rename " << tmp << " to " << path << ": " << strerror(errno) << std::endl;
+		remove(tmp.c_str());
+		return false;
+	}
+	std::cout << "Compiled " << hdr.ncalls << " callsigns and " << hdr.nids << " ids to " << path << std::endl;
+	return true;
+}
@@ -0,0 +1,74 @@
+// urfd -- The universal reflector
+// Copyright © 2024 Thomas A. Early N7TAE
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+#include "Callsign.h"
+
+#define IDIMAGE_MAGIC   "URFDIDB"   // seven characters and the nul
+#define IDIMAGE_VERSION 1
+
+////////////////////////////////////////////////////////////////////////////////////////
+// A compiled ID <==> Callsign database. dbutil writes it from the CSV and urfd maps it
+// read only, so there is nothing to parse at startup and every reflector on the host
+// shares the same pages. The file is a header followed by four arrays:
+//
+//   uint64_t callsign keys, sorted     uint64_t callsign of each id
+//   uint32_t id of each callsign key   uint32_t ids, sorted
+//
+// and both directions are a binary search. The numbers are in host byte order: the
+// file is meant to be compiled on the machine that uses it.
+
+class CIdImage
+{
+public:
+	CIdImage() : m_base(nullptr), m_size(0), m_ncalls(0), m_nids(0), m_keys(nullptr), m_callsigns(nullptr), m_keyids(nullptr), m_ids(nullptr) {}
+	~CIdImage();
+	CIdImage(const CIdImage &) = delete;
+	CIdImage &operator=(const CIdImage &) = delete;
+
+	// map a compiled file, false if it can't be read or isn't one
+	bool Open(const std::string &path);
+	static bool IsImage(const std::string &path);
+
+	// compile maps to a file, replacing it with a rename so a reflector that has the
+	// old file mapped keeps reading the old file
+	static bool Write(const std::string &path, const std::unordered_map<uint32_t, UCallsign> &callsigns, const std::unordered_map<UCallsign, uint32_t, CCallsignHash, CCallsignEqual> &ids);
+
+	bool FindId(const UCallsign &ucs, uint32_t &id) const;
+	bool FindCallsign(uint32_t id, UCallsign &ucs) const;
+	uint32_t Size(void) const { return m_ncalls; }
+
+private:
+	struct SHeader
+	{
+		char     magic[8];
+		uint32_t version;
+		uint32_t ncalls;
+		uint32_t nids;
+		uint32_t reserved;
+	};
+
+	void *m_base;
+	size_t m_size;
+	uint32_t m_ncalls, m_nids;
+	const uint64_t *m_keys, *m_callsigns;
+	const uint32_t *m_keyids, *m_ids;
+};
@@ -26,7 +26,6 @@
 #include <fstream>
 #include <string.h>
 #include <fcntl.h>
-#include <sys/stat.h>
 
 #include "Global.h"
 #include "InterlinkMap.h"
@@ -34,7 +33,6 @@
 CInterlinkMap::CInterlinkMap()
 {
 	m_Filename.clear();
-	::memset(&m_LastModTime, 0, sizeof(time_t));
 }
 
 bool CInterlinkMap::LoadFromFile(const std::string &filename)
@@ -120,9 +118,6 @@ bool CInterlinkMap::LoadFromFile(const std::string &filename)
 		// keep file path
 		m_Filename.assign(filename);
 
-		// update time
-		GetLastModTime(&m_LastModTime);
-
 		// and done
 		Unlock();
 		ok = true;
@@ -147,18 +142,6 @@ bool CInterlinkMap::ReloadFromFile(void)
 	return ok;
 }
 
-bool CInterlinkMap::NeedReload(void)
-{
-	bool needReload = false;
-
-	time_t time;
-	if ( GetLastModTime(&time) )
-	{
-		needReload = time != m_LastModTime;
-	}
-	return needReload;
-}
-
 bool CInterlinkMap::IsCallsignListed(const std::string &callsign, char module) const
 {
 	const auto item = m_InterlinkMap.find(callsign);
@@ -218,22 +201,6 @@ char *CInterlinkMap::TrimWhiteSpaces(char *str)
 	return str;
 }
 
-bool CInterlinkMap::GetLastModTime(time_t *time)
-{
-	bool ok = false;
-
-	if ( ! m_Filename.empty() )
-	{
-		struct stat fileStat;
-		if( ::stat(m_Filename.c_str(), &fileStat) != -1 )
-		{
-			*time = fileStat.st_mtime;
-			ok = true;
-		}
-	}
-	return ok;
-}
-
 char *CInterlinkMap::ToUpper(char *str)
 {
 	constexpr auto diff = 'a' - 'A';
@@ -46,7 +46,6 @@ public:
 	// file io
 	virtual bool LoadFromFile(const std::string &filename);
 	bool ReloadFromFile(void);
-	bool NeedReload(void);
 
 #ifndef NO_DHT
 	void Update(const std::string &cs, const std::string &mods, const std::string &ipv4, const std::string &ipv6, uint16_t port, const std::string &tcmods);
@@ -67,13 +66,11 @@ public:
 	CInterlinkMapItem *FindMapItem(const std::string &);
 
 protected:
-	bool GetLastModTime(time_t *);
 	char *TrimWhiteSpaces(char *);
 	char *ToUpper(char *str);
 
 	// data
 	mutable std::mutex m_Mutex;
 	std::string m_Filename;
-	time_t m_LastModTime;
 	std::map<std::string, CInterlinkMapItem> m_InterlinkMap;
 };
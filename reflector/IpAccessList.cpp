@@ -0,0 +1,275 @@
+// urfd -- The universal reflector
+// Copyright © 2024 Thomas A. Early N7TAE
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <cstring>
+
+#include "IpAccessList.h"
+
+static inline unsigned Bit(const uint8_t *addr, unsigned i)
+{
+	return (addr[i >> 3] >> (7 - (i & 7))) & 1u;
+}
+
+// how many leading bits a and b share, up to max
+static unsigned CommonBits(const uint8_t *a, const uint8_t *b, unsigned max)
+{
+	unsigned n = 0;
+	while (n + 8 <= max && a[n >> 3] == b[n >> 3])
+		n += 8;
+	while (n < max && Bit(a, n) == Bit(b, n))
+		n++;
+	return n;
+}
+
+// zero the bits past len
+static void Mask(uint8_t *addr, unsigned len)
+{
+	for (unsigned i = len; i < 128; i++)
+		addr[i >> 3] &= ~(0x80u >> (i & 7));
+}
+
+////////////////////////////////////////////////////////////////////////////////////////
+// file io
+
+bool CIpAccessList::LoadFromFile(const std::string &filename)
+{
+	std::ifstream file(filename);
+	if (! file.is_open())
+	{
+		std::cout << "Gatekeeper cannot find " << filename << std::endl;
+		return false;
+	}
+
+	// compile a new list off to the side
+	auto trie = std::make_shared<STrie>();
+	std::string line;
+	unsigned count = 0;
+	while (std::getline(file, line))
+	{
+		count++;
+		auto hash = line.find('#');
+		if (std::string::npos != hash)
+			line.resize(hash);
+		std::istringstream iss(line);
+		std::string word, block;
+		if (! (iss >> word))
+			continue;
+		iss >> block;
+
+		EAccess access = EAccess::none;
+		if (0 == word.compare("allow"))
+			access = EAccess::allow;
+		else if (0 == word.compare("deny"))
+			access = EAccess::deny;
+
+		uint8_t addr[16];
+		unsigned len;
+		if (EAccess::none == access || ! ParseBlock(block, addr, len))
+		{
+			std::cerr << "Line #" << count << " of " << filename << " isn't 'allow' or 'deny' and an address or CIDR block, it will be ignored" << std::endl;
+			continue;
+		}
+		trie->Insert(addr, len, access);
+	}
+	file.close();
+
+	m_Filename = filename;
+
+	// publish, and then tell the protocol threads to pick it up
+	std::atomic_store(&m_Trie, std::shared_ptr<const STrie>(std::move(trie)));
+	m_Generation.fetch_add(1, std::memory_order_release);
+	std::cout << "Gatekeeper loaded " << std::atomic_load(&m_Trie)->blocks << " IP blocks from " << filename << std::endl;
+	return true;
+}
+
+bool CIpAccessList::ReloadFromFile(void)
+{
+	if (m_Filename.empty())
+		return false;
+	return LoadFromFile(m_Filename);
+}
+
+// an address, or an address and a prefix length after a '/'
+bool CIpAccessList::ParseBlock(const std::string &text, uint8_t *addr, unsigned &len)
+{
+	auto slash = text.find('/');
+	const std::string a(text.substr(0, slash));
+	memset(addr, 0, 16);
+	unsigned max;
+	if (std::string::npos == a.find(':'))
+	{
+		// IPv4, as ::ffff:a.b.c.d
+		addr[10] = addr[11] = 0xffu;
+		if (1 != inet_pton(AF_INET, a.c_str(), addr + 12))
+			return false;
+		max = 32;
+	}
+	else
+	{
+		if (1 != inet_pton(AF_INET6, a.c_str(), addr))
+			return false;
+		max = 128;
+	}
+
+	len = max;
+	if (std::string::npos != slash)
+	{
+		const std::string l(text.substr(slash + 1));
+		if (l.empty() || l.size() > 3 || std::string::npos != l.find_first_not_of("0123456789"))
+			return false;
+		len = unsigned(std::stoul(l));
+		if (len > max)
+			return false;
+	}
+	if (32 == max)
+		len += 96;
+	Mask(addr, len);
+	return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////
+// check
+
+bool CIpAccessList::IsAllowed(const CIp &Ip) const
+{
+	// this thread's reference to the list, refreshed when a new one is published
+	static thread_local struct
+	{
+		const CIpAccessList *owner = nullptr;
+		uint32_t generation = 0;
+		std::shared_ptr<const STrie> trie;
+	} t_Snapshot;
+
+	const auto generation = m_Generation.load(std::memory_order_acquire);
+	if (this != t_Snapshot.owner || generation != t_Snapshot.generation)
+	{
+		t_Snapshot.owner = this;
+		t_Snapshot.generation = generation;
+		t_Snapshot.trie = std::atomic_load(&m_Trie);
+	}
+	if (! t_Snapshot.trie)
+		return true;
+
+	uint8_t addr[16];
+	if (AF_INET6 == Ip.GetFamily())
+	{
+		memcpy(addr, reinterpret_cast<const struct sockaddr_in6 *>(Ip.GetCPointer())->sin6_addr.s6_addr, 16);
+	}
+	else
+	{
+		memset(addr, 0, 10);
+		addr[10] = addr[11] = 0xffu;
+		memcpy(addr + 12, &reinterpret_cast<const struct sockaddr_in *>(Ip.GetCPointer())->sin_addr.s_addr, 4);
+	}
+
+	if (EAccess::deny == t_Snapshot.trie->Find(addr))
+	{
+		m_Denied.fetch_add(1, std::memory_order_relaxed);
+		return false;
+	}
+	return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////
+// the compiled list
+
+CIpAccessList::STrie::STrie() : blocks(0)
+{
+	nodes.push_back(SNode{});	// the root, ::/0, with no access of its own unless it's listed
+}
+
+void CIpAccessList::STrie::Insert(const uint8_t *addr, unsigned len, EAccess access)
+{
+	// nodes may move as the vector grows, so they're always reached by index
+	uint32_t n = 0;
+	while (true)
+	{
+		if (nodes[n].len == len)
+		{
+			if (EAccess::none == nodes[n].access)
+				blocks++;
+			nodes[n].access = access;	// a repeated block, the last one wins
+			return;
+		}
+
+		const unsigned b = Bit(addr, nodes[n].len);
+		const uint32_t c = nodes[n].child[b];
+		if (0 == c)
+		{
+			SNode leaf{};
+			memcpy(leaf.addr, addr, 16);
+			leaf.len = len;
+			leaf.access = access;
+			nodes[n].child[b] = uint32_t(nodes.size());
+			nodes.push_back(leaf);
+			blocks++;
+			return;
+		}
+
+		const unsigned clen = nodes[c].len;
+		const unsigned common = CommonBits(addr, nodes[c].addr, (len < clen) ? len : clen);
+		if (common == clen)
+		{
+			// the child's block holds this one, go down
+			n = c;
+			continue;
+		}
+
+		// split the edge with a node for the bits they share
+		SNode split{};
+		memcpy(split.addr, addr, 16);
+		Mask(split.addr, common);
+		split.len = common;
+		split.child[Bit(nodes[c].addr, common)] = c;
+		const uint32_t s = uint32_t(nodes.size());
+		nodes.push_back(split);
+		nodes[n].child[b] = s;
+		if (common == len)
+		{
+			nodes[s].access = access;
+			blocks++;
+			return;
+		}
+		SNode leaf{};
+		memcpy(leaf.addr, addr, 16);
+		leaf.len = len;
+		leaf.access = access;
+		nodes[s].child[Bit(addr, common)] = uint32_t(nodes.size());
+		nodes.push_back(leaf);
+		blocks++;
+		return;
+	}
+}
+
+// the access of the longest block that holds addr
+CIpAccessList::EAccess CIpAccessList::STrie::Find(const uint8_t *addr) const
+{
+	EAccess found = nodes[0].access;
+	uint32_t n = 0;
+	while (nodes[n].len < 128)
+	{
+		const uint32_t c = nodes[n].child[Bit(addr, nodes[n].len)];
+		if (0 == c || CommonBits(addr, nodes[c].addr, nodes[c].len) < nodes[c].len)
+			break;
+		n = c;
+		if (EAccess::none != nodes[n].access)
+			found = nodes[n].access;
+	}
+	return found;
+}
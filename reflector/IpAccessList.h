@@ -0,0 +1,83 @@
+// urfd -- The universal reflector
+// Copyright © 2024 Thomas A. Early N7TAE
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "IP.h"
+
+////////////////////////////////////////////////////////////////////////////////////////
+// The IP access list, a file of "allow" and "deny" lines, each with an address or a
+// CIDR block, IPv4 or IPv6:
+//
+//   deny  203.0.113.0/24
+//   allow 203.0.113.7
+//   deny  2001:db8::/32
+//
+// The longest block that holds an address decides, and an address that isn't in any
+// block is allowed. An IPv4 address is kept as its IPv4-mapped IPv6 address, so
+// ::/0 covers both families and 0.0.0.0/0 just IPv4. The blocks are compiled into a
+// path compressed binary trie, so a check is at most 128 bit tests, however long the
+// list. The compiled list is published with an atomic swap, and each thread keeps its
+// own reference to it until the list's generation changes, so a check takes no lock.
+
+class CIpAccessList
+{
+public:
+	CIpAccessList() : m_Generation(0), m_Denied(0) {}
+
+	// file io, only from one thread at a time
+	bool LoadFromFile(const std::string &filename);
+	bool ReloadFromFile(void);
+
+	// false if datagrams from this address are to be dropped
+	bool IsAllowed(const CIp &Ip) const;
+
+	uint64_t GetDenied(void) const { return m_Denied.load(std::memory_order_relaxed); }
+
+protected:
+	enum class EAccess : int8_t { none, allow, deny };
+
+	struct SNode
+	{
+		uint8_t  addr[16];	// the block, network order, bits past len are zero
+		uint8_t  len;
+		EAccess  access;
+		uint32_t child[2];	// by the bit after len, 0 is no child, the root is never one
+	};
+
+	struct STrie
+	{
+		STrie();
+		void Insert(const uint8_t *addr, unsigned len, EAccess access);
+		EAccess Find(const uint8_t *addr) const;
+
+		std::vector<SNode> nodes;
+		std::size_t blocks;
+	};
+
+	static bool ParseBlock(const std::string &text, uint8_t *addr, unsigned &len);
+
+	std::string m_Filename;
+	std::shared_ptr<const STrie> m_Trie;	// only touched with std::atomic_load/store
+	std::atomic<uint32_t> m_Generation;
+	mutable std::atomic<uint64_t> m_Denied;
+};
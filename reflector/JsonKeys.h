@@ -26,10 +26,12 @@ struct SJsonKeys {
 	dcs { "DCSPort" },
 	dextra { "DExtraPort" },
 	dmrplus { "DMRPlusPort" },
-	dplus { "DPlusPort" },
 	m17 { "M17Port" },
 	urf { "URFPort" };
 
+	struct DPLUS { const std::string port, selectedmodule; }
+	dplus { "DPlusPort", "DPlusSelectedModuleOnly" };
+
 	struct G3 { const std::string enable; }
 	g3 { "G3Enable" };
 
@@ -69,6 +71,12 @@ struct SJsonKeys {
 	nxdniddb  { "nxdnIdDbUrl", "nxdnIdDbMode", "nxdnIdDbRefresh", "nxdnIdDbFilePath" },
 	ysftxrxdb {  "ysfIdDbUrl",  "ysfIdDbMode",  "ysfIdDbRefresh",  "ysfIdDbFilePath" };
 
-	struct FILES { const std::string pid, xml, json, white, black, interlink, terminal; }
-	files { "pidFilePath", "xmlFilePath", "jsonFilePath", "whitelistFilePath", "blacklistFilePath", "interlinkFilePath", "g3TerminalFilePath" };
+	struct RATELIMIT { const std::string filter, burst, ban, bm, dcs, dextra, dmrplus, dplus, g3, m17, mmdvm, nxdn, p25, urf, usrp, ysf; }
+	ratelimit { "rateSocketFilter", "rateBurstSeconds", "rateBanSeconds", "rateBM", "rateDCS", "rateDExtra", "rateDMRPlus", "rateDPlus", "rateG3", "rateM17", "rateMMDVM", "rateNXDN", "rateP25", "rateURF", "rateUSRP", "rateYSF" };
+
+	struct STATUS { const std::string enable, port, bind; }
+	status { "statusEnable", "statusPort", "statusBind" };
+
+	struct FILES { const std::string pid, xml, json, events, white, black, interlink, terminal, iplist; }
+	files { "pidFilePath", "xmlFilePath", "jsonFilePath", "eventsFilePath", "whitelistFilePath", "blacklistFilePath", "interlinkFilePath", "g3TerminalFilePath", "ipListFilePath" };
 };
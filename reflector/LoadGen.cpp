@@ -0,0 +1,1189 @@
+// urfd -- The universal reflector
+// Copyright © 2024 Thomas A. Early N7TAE
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+// A load generator for a running reflector. It creates a number of
+// simulated clients of one protocol, each with its own UDP socket, links
+// them to the chosen modules and then keys up one talker on each module.
+// Every 20 ms voice unit sent by a talker carries a sequence number in
+// its codec data, so each listener can measure the delivery latency, loss,
+// duplication and reordering of the stream. The test is repeated for each
+// requested client count and a scaling report is printed at the end.
+//
+// Every client sends from this host's address, so to the reflector's rate
+// limiter they are one source. The keepalives are spread over their period
+// so they don't arrive as a burst. A reflector on another host still needs
+// the tested protocol's [Rate Limits] set to 0, loopback is never limited.
+// If every listener goes silent at the same moment while the talkers are
+// still going, the step is reported as cut off, not as lost frames.
+//
+// The M17, DExtra, YSF and DMR packets are put together here, by hand, and
+// not by the reflector's own encoders. Those are members of the protocol
+// classes, which can't be built without CReflector, the gatekeeper and the
+// stream code, and they encode from the packet classes, which have no room
+// for the sequence numbers. The shared pieces under them, the callsign coding,
+// the M17 CRC, the YSF FICH and payload coding and the AMBE+2 handling, are
+// the same objects the reflector uses. Being written apart from the protocol
+// classes is also what lets loadgen catch a bug in them, but it means a change
+// to one of these wire formats has to be made here too.
+
+#include <poll.h>
+
+#include "Defines.h"
+#include "Global.h"
+#include "UDPSocket.h"
+#include "M17Packet.h"
+#include "M17CRC.h"
+#include "DVHeaderPacket.h"
+#include "YSFDefines.h"
+#include "YSFFich.h"
+#include "YSFPayload.h"
+#include "YSFUtils.h"
+#include "DMRAmbe.h"
+
+////////////////////////////////////////////////////////////////////////////////////////
+// global objects needed by CCallsign
+
+SJsonKeys   g_Keys;
+CConfigure  g_Configure;
+CLookupDmr  g_LDid;
+CLookupNxdn g_LNid;
+CLookupYsf  g_LYtr;
+CFileWatcher g_FileWatcher;
+
+////////////////////////////////////////////////////////////////////////////////////////
+// defines
+
+#define LOADGEN_KEEPALIVE_PERIOD    2000    // in ms
+#define LOADGEN_LINK_TIMEOUT        10000   // in ms
+#define LOADGEN_DRAIN_TIME          1500    // in ms, wait for stragglers after the last frame
+#define LOADGEN_SILENCE_TIME        1000    // in ms, a listener this quiet before the talkers stopped was cut off
+#define LOADGEN_CUTOFF_SPREAD       500     // in ms, if all were cut off within this of each other, so was the step
+#define LOADGEN_UNITS_PER_SECOND    50      // a voice unit is 20 ms
+#define LOADGEN_SEQ_MARK            0x1A5A5A5U
+
+enum class ELoadProtocol { none, m17, dextra, ysf, dmr };
+
+enum class EClientState { idle, login, auth, config, linking, linked, refused };
+
+using LoadClock = std::chrono::steady_clock;
+
+static uint8_t g_DmrSyncBSVoice[] = { 0x07,0x55,0xFD,0x7D,0xF7,0x5F,0x70 };
+static uint8_t g_DmrSyncBSData[]  = { 0x0D,0xFF,0x57,0xD7,0x5D,0xF5,0xD0 };
+
+////////////////////////////////////////////////////////////////////////////////////////
+// options
+
+struct SLoadOptions
+{
+	ELoadProtocol protocol = ELoadProtocol::none;
+	std::string host = "127.0.0.1";
+	uint16_t port = 0;
+	std::string modules = "A";
+	std::vector<unsigned> counts = { 10, 50, 100 };
+	unsigned talk = 10;
+	std::string reflector = "URF000";
+	uint32_t dmrid = 3100001;
+};
+
+static SLoadOptions g_Opt;
+
+////////////////////////////////////////////////////////////////////////////////////////
+// voice unit sequence numbers
+//
+// The sequence number is carried in the 49 AMBE parameter bits of a DMR
+// style AMBE+2 frame: 12 bits in the A word and 12 bits in the B word,
+// with a fixed marker in the C word. This survives the YSF VCH round trip
+// through CYsfUtils, and is passed unchanged by the D-Star and DMR paths.
+
+static uint32_t MakeSeq(unsigned talker, unsigned unit)
+{
+	return ((talker & 0xFFU) << 16) | (unit & 0xFFFFU);
+}
+
+static void SeqToAmbe(uint32_t seq, uint8_t *ambe)
+{
+	CDmrAmbe::Encode((seq >> 12) & 0xFFFU, seq & 0xFFFU, LOADGEN_SEQ_MARK, ambe);
+}
+
+static bool AmbeToSeq(const uint8_t *ambe, uint32_t &seq)
+{
+	unsigned int dat_a, dat_b, dat_c;
+	CDmrAmbe::Decode(ambe, dat_a, dat_b, dat_c);
+	if (LOADGEN_SEQ_MARK != dat_c)
+		return false;
+	seq = (dat_a << 12) | dat_b;
+	return true;
+}
+
+// an M17 payload has two 8 byte codec2 3200 halves
+static void SeqToM17Half(uint32_t seq, uint8_t *half)
+{
+	half[0] = 'L';
+	half[1] = 'G';
+	half[2] = (seq >> 24) & 0xFFU;
+	half[3] = (seq >> 16) & 0xFFU;
+	half[4] = (seq >> 8) & 0xFFU;
+	half[5] = seq & 0xFFU;
+	half[6] = half[7] = 0;
+}
+
+static bool M17HalfToSeq(const uint8_t *half, uint32_t &seq)
+{
+	if ('L' != half[0] || 'G' != half[1])
+		return false;
+	seq = (uint32_t(half[2]) << 24) | (uint32_t(half[3]) << 16) | (uint32_t(half[4]) << 8) | half[5];
+	return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////
+// per listener statistics
+
+class CLoadStats
+{
+public:
+	void Reset(unsigned talkers, unsigned units)
+	{
+		m_Seen.assign(talkers, std::vector<bool>(units, false));
+		m_Last.assign(talkers, -1);
+		m_Latency.clear();
+		m_Received = m_Duplicate = m_Reordered = m_Foreign = 0;
+		m_LastUnit = 0;
+	}
+
+	void Unit(uint32_t seq, double latency_ms)
+	{
+		const unsigned talker = seq >> 16;
+		const unsigned unit = seq & 0xFFFFU;
+		if (talker >= m_Seen.size() || unit >= m_Seen[talker].size())
+		{
+			m_Foreign++;
+			return;
+		}
+		if (m_Seen[talker][unit])
+		{
+			m_Duplicate++;
+			return;
+		}
+		m_Seen[talker][unit] = true;
+		m_Received++;
+		if (int(unit) < m_Last[talker])
+			m_Reordered++;
+		else
+			m_Last[talker] = int(unit);
+		m_Latency.push_back(latency_ms);
+	}
+
+	std::vector<std::vector<bool>> m_Seen;
+	std::vector<int> m_Last;
+	std::vector<double> m_Latency;
+	unsigned m_Received, m_Duplicate, m_Reordered, m_Foreign;
+	int64_t m_LastUnit;   // in us, when the last voice unit arrived, 0 for never
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
+// a simulated client
+
+class CLoadClient
+{
+public:
+	CLoadClient(unsigned index, char module) : m_Index(index), m_Module(module), m_State(EClientState::idle)
+	{
+		// a unique, syntactically valid callsign: LG + digit + 3 letters
+		char cs[7];
+		cs[0] = 'L';
+		cs[1] = 'G';
+		cs[2] = '0' + (index % 10);
+		unsigned n = index / 10;
+		for (int i=5; i>2; i--)
+		{
+			cs[i] = 'A' + (n % 26);
+			n /= 26;
+		}
+		cs[6] = 0;
+		m_Callsign.assign(cs);
+		m_DmrId = g_Opt.dmrid + index;
+	}
+
+	bool Open(const CIp &local)
+	{
+		return m_Socket.Open(local);
+	}
+
+	unsigned m_Index;
+	char m_Module;
+	std::string m_Callsign;
+	uint32_t m_DmrId;
+	CUdpSocket m_Socket;
+	std::atomic<EClientState> m_State;
+	CLoadStats m_Stats;   // only touched by the receive thread while a step is running
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
+// the load generator
+
+class CLoadGen
+{
+public:
+	CLoadGen() : m_Port(0), m_Running(false), m_Talkers(0), m_Units(0) {}
+
+	bool Setup();
+	void Step(unsigned count);
+	void Report() const;
+	static void PrintDmrDb();
+
+protected:
+	struct SStepResult
+	{
+		unsigned clients, linked, talkers, listeners;
+		uint64_t expected, received, duplicate, reordered;
+		double worst;
+		double avg, p50, p99, max;
+		double cutoff;   // in seconds from the start of the talk, < 0 if the step wasn't cut off
+	};
+
+	// protocol packets
+	void SendConnect(CLoadClient &c);
+	void SendKeepalive(CLoadClient &c);
+	void SendDisconnect(CLoadClient &c);
+	void SendLink(CLoadClient &c);
+	void Transmit(CLoadClient &c, unsigned talker);
+
+	// encoders
+	void EncodeM17(CBuffer &buf, const CLoadClient &c, uint16_t sid, uint16_t fn, uint32_t seq0, uint32_t seq1, bool last) const;
+	void EncodeDextraHeader(CBuffer &buf, const CLoadClient &c, uint16_t sid) const;
+	void EncodeDextraFrame(CBuffer &buf, uint16_t sid, uint8_t pid, uint32_t seq, bool last) const;
+	void EncodeYsf(CBuffer &buf, const CLoadClient &c, uint8_t fi, uint8_t fn, uint8_t counter, const uint32_t *seqs) const;
+	void EncodeDmr(CBuffer &buf, const CLoadClient &c, uint32_t dst, uint32_t sid, uint8_t seqno, uint8_t bits, const uint32_t *seqs) const;
+
+	// receiving
+	void ReceiveThread();
+	void OnPacket(CLoadClient &c, const CBuffer &buf, int64_t now_us);
+	void OnUnit(CLoadClient &c, uint32_t seq, int64_t now_us);
+
+	static int64_t Now();
+
+	CIp m_Reflector;
+	uint16_t m_Port;
+	CM17CRC m_M17CRC;
+	std::vector<std::unique_ptr<CLoadClient>> m_Clients;
+	std::atomic<bool> m_Running;
+	std::future<void> m_Future;
+	unsigned m_Talkers, m_Units;
+	std::vector<std::unique_ptr<std::atomic<int64_t>[]>> m_SendTime;
+	std::vector<SStepResult> m_Results;
+};
+
+int64_t CLoadGen::Now()
+{
+	return std::chrono::duration_cast<std::chrono::microseconds>(LoadClock::now().time_since_epoch()).count();
+}
+
+bool CLoadGen::Setup()
+{
+	switch (g_Opt.protocol)
+	{
+		case ELoadProtocol::m17:    m_Port = 17000; break;
+		case ELoadProtocol::dextra: m_Port = 30001; break;
+		case ELoadProtocol::ysf:    m_Port = 42000; break;
+		case ELoadProtocol::dmr:    m_Port = 62030; break;
+		default: return true;
+	}
+	if (g_Opt.port)
+		m_Port = g_Opt.port;
+
+	m_Reflector.Initialize(strchr(g_Opt.host.c_str(), ':') ? AF_INET6 : AF_INET, m_Port, g_Opt.host.c_str());
+	if (! m_Reflector.IsSet())
+	{
+		std::cerr << "Can't resolve reflector address " << g_Opt.host << std::endl;
+		return true;
+	}
+	return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////
+// packet encoders
+
+void CLoadGen::EncodeM17(CBuffer &buf, const CLoadClient &c, uint16_t sid, uint16_t fn, uint32_t seq0, uint32_t seq1, bool last) const
+{
+	SM17Frame frame;
+	memset(frame.magic, 0, sizeof(SM17Frame));
+	memcpy(frame.magic, "M17 ", 4);
+	frame.streamid = sid;
+	CCallsign dst(g_Opt.reflector);
+	dst.SetCSModule(c.m_Module);
+	dst.CodeOut(frame.lich.addr_dst);
+	CCallsign(c.m_Callsign).CodeOut(frame.lich.addr_src);
+	frame.lich.frametype = htons(0x5U);
+	frame.framenumber = htons(last ? (fn | 0x8000U) : fn);
+	SeqToM17Half(seq0, frame.payload);
+	SeqToM17Half(seq1, frame.payload + 8);
+	frame.crc = htons(m_M17CRC.CalcCRC(frame.magic, sizeof(SM17Frame)-2));
+	buf.Set(frame.magic, sizeof(SM17Frame));
+}
+
+void CLoadGen::EncodeDextraHeader(CBuffer &buf, const CLoadClient &c, uint16_t sid) const
+{
+	uint8_t tag[] = { 'D','S','V','T',0x10,0x00,0x00,0x00,0x20,0x00,0x01,0x02 };
+	struct dstar_header hdr;
+	memset(&hdr, ' ', sizeof(hdr));
+	hdr.Flag1 = hdr.Flag2 = hdr.Flag3 = 0;
+	CCallsign rpt2(g_Opt.reflector);
+	rpt2.SetCSModule(c.m_Module);
+	rpt2.GetCallsign(hdr.RPT2);
+	CCallsign rpt1(c.m_Callsign);
+	rpt1.SetCSModule('B');
+	rpt1.GetCallsign(hdr.RPT1);
+	memcpy(hdr.UR, "CQCQCQ  ", CALLSIGN_LEN);
+	CCallsign(c.m_Callsign).GetCallsign(hdr.MY);
+	hdr.Crc = 0;
+
+	buf.Set(tag, sizeof(tag));
+	buf.Append(sid);
+	buf.Append((uint8_t)0x80);
+	buf.Append((uint8_t *)&hdr, sizeof(hdr));
+}
+
+void CLoadGen::EncodeDextraFrame(CBuffer &buf, uint16_t sid, uint8_t pid, uint32_t seq, bool last) const
+{
+	uint8_t tag[] = { 'D','S','V','T',0x20,0x00,0x00,0x00,0x20,0x00,0x01,0x02 };
+	uint8_t ambe[9];
+	uint8_t dvdata[3] = { 0x16, 0x29, 0xF5 };
+	SeqToAmbe(seq, ambe);
+
+	buf.Set(tag, sizeof(tag));
+	buf.Append(sid);
+	buf.Append((uint8_t)(last ? (pid | 0x40U) : pid));
+	buf.Append(ambe, sizeof(ambe));
+	buf.Append(dvdata, sizeof(dvdata));
+}
+
+void CLoadGen::EncodeYsf(CBuffer &buf, const CLoadClient &c, uint8_t fi, uint8_t fn, uint8_t counter, const uint32_t *seqs) const
+{
+	uint8_t tag[]  = { 'Y','S','F','D' };
+	uint8_t dest[] = { 'A','L','L',' ',' ',' ',' ',' ',' ',' ' };
+	char sz[YSF_CALLSIGN_LENGTH+1];
+	memset(sz, ' ', YSF_CALLSIGN_LENGTH);
+	memcpy(sz, c.m_Callsign.c_str(), c.m_Callsign.size());
+
+	buf.Set(tag, sizeof(tag));
+	buf.Append((uint8_t *)sz, YSF_CALLSIGN_LENGTH);   // gateway
+	buf.Append((uint8_t *)sz, YSF_CALLSIGN_LENGTH);   // source
+	buf.Append(dest, sizeof(dest));
+	buf.Append(counter);
+
+	uint8_t frame[YSF_FRAME_LENGTH_BYTES];
+	memset(frame, 0, sizeof(frame));
+	memcpy(frame, YSF_SYNC_BYTES, YSF_SYNC_LENGTH_BYTES);
+
+	CYSFFICH fich;
+	fich.setFI(fi);
+	fich.setCS(2U);
+	fich.setFN(fn);
+	fich.setFT((YSF_FI_COMMUNICATIONS == fi) ? 6U : 7U);
+	fich.setDev(false);
+	fich.setMR(YSF_MR_BUSY);
+	fich.setDT(YSF_DT_VD_MODE2);
+	fich.setSQL(false);
+	fich.setSQ(0U);
+	fich.encode(frame + YSF_SYNC_LENGTH_BYTES);
+
+	CYSFPayload payload;
+	if (YSF_FI_COMMUNICATIONS == fi)
+	{
+		for (unsigned i=0; i<5; i++)
+		{
+			uint8_t ambe[9];
+			SeqToAmbe(seqs[i], ambe);
+			CYsfUtils::EncodeVD2Vch(ambe, frame+35+(18*i));
+		}
+		payload.writeVDMode2Data(frame, (const unsigned char *)sz);
+	}
+	else
+	{
+		unsigned char csd1[20U], csd2[20U];
+		memset(csd1, '*', YSF_CALLSIGN_LENGTH);
+		memcpy(csd1 + YSF_CALLSIGN_LENGTH, sz, YSF_CALLSIGN_LENGTH);
+		memset(csd2, ' ', YSF_CALLSIGN_LENGTH + YSF_CALLSIGN_LENGTH);
+		payload.writeHeader(frame, csd1, csd2);
+	}
+	buf.Append(frame, sizeof(frame));
+}
+
+void CLoadGen::EncodeDmr(CBuffer &buf, const CLoadClient &c, uint32_t dst, uint32_t sid, uint8_t seqno, uint8_t bits, const uint32_t *seqs) const
+{
+	uint8_t tag[] = { 'D','M','R','D' };
+	buf.Set(tag, sizeof(tag));
+	buf.Append(seqno);
+	buf.Append((uint8_t)((c.m_DmrId >> 16) & 0xFFU));
+	buf.Append((uint8_t)((c.m_DmrId >> 8) & 0xFFU));
+	buf.Append((uint8_t)(c.m_DmrId & 0xFFU));
+	buf.Append((uint8_t)((dst >> 16) & 0xFFU));
+	buf.Append((uint8_t)((dst >> 8) & 0xFFU));
+	buf.Append((uint8_t)(dst & 0xFFU));
+	buf.Append((uint8_t)((c.m_DmrId >> 24) & 0xFFU));
+	buf.Append((uint8_t)((c.m_DmrId >> 16) & 0xFFU));
+	buf.Append((uint8_t)((c.m_DmrId >> 8) & 0xFFU));
+	buf.Append((uint8_t)(c.m_DmrId & 0xFFU));
+	buf.Append(bits);
+	buf.Append(sid);
+
+	uint8_t payload[33];
+	memset(payload, 0, sizeof(payload));
+	if (seqs)
+	{
+		// three ambe frames either side of the sync or embedded signalling
+		uint8_t ambe[3][9];
+		for (int i=0; i<3; i++)
+			SeqToAmbe(seqs[i], ambe[i]);
+		memcpy(payload, ambe[0], 9);
+		memcpy(payload+9, ambe[1], 5);
+		payload[13] &= 0xF0U;
+		memcpy(payload+19, ambe[1]+4, 5);
+		payload[19] &= 0x0FU;
+		memcpy(payload+24, ambe[2], 9);
+		if (0 == (bits & 0x0FU))
+		{
+			payload[13] |= g_DmrSyncBSVoice[0] & 0x0FU;
+			memcpy(payload+14, g_DmrSyncBSVoice+1, 5);
+			payload[19] |= g_DmrSyncBSVoice[6] & 0xF0U;
+		}
+	}
+	else
+	{
+		// header or terminator, urfd only looks at the data sync
+		memcpy(payload+13, g_DmrSyncBSData, sizeof(g_DmrSyncBSData));
+	}
+	buf.Append(payload, sizeof(payload));
+	buf.Append((uint8_t)0);  // BER
+	buf.Append((uint8_t)0);  // RSSI
+}
+
+////////////////////////////////////////////////////////////////////////////////////////
+// protocol packets
+
+void CLoadGen::SendConnect(CLoadClient &c)
+{
+	CBuffer buf;
+	switch (g_Opt.protocol)
+	{
+		case ELoadProtocol::m17:
+			buf.resize(11);
+			memcpy(buf.data(), "CONN", 4);
+			CCallsign(c.m_Callsign).CodeOut(buf.data() + 4);
+			buf.data()[10] = c.m_Module;
+			c.m_State = EClientState::login;
+			break;
+		case ELoadProtocol::dextra:
+		{
+			char cs[CALLSIGN_LEN+1];
+			snprintf(cs, sizeof(cs), "%-8s", c.m_Callsign.c_str());
+			buf.Set((uint8_t *)cs, CALLSIGN_LEN);
+			buf.Append((uint8_t)'B');
+			buf.Append((uint8_t)c.m_Module);
+			buf.Append((uint8_t)11);
+			c.m_State = EClientState::login;
+			break;
+		}
+		case ELoadProtocol::ysf:
+			// the reflector links a new YSF client to its AutoLinkModule. The state is
+			// set first, the reply can arrive before SendKeepalive() returns.
+			c.m_State = EClientState::login;
+			SendKeepalive(c);
+			return;
+		case ELoadProtocol::dmr:
+		{
+			uint8_t tag[] = { 'R','P','T','L' };
+			buf.Set(tag, sizeof(tag));
+			buf.Append((uint32_t)htonl(c.m_DmrId));
+			c.m_State = EClientState::login;
+			break;
+		}
+		default:
+			return;
+	}
+	c.m_Socket.Send(buf, m_Reflector);
+}
+
+void CLoadGen::SendKeepalive(CLoadClient &c)
+{
+	CBuffer buf;
+	switch (g_Opt.protocol)
+	{
+		case ELoadProtocol::m17:
+			buf.resize(10);
+			memcpy(buf.data(), "PONG", 4);
+			CCallsign(c.m_Callsign).CodeOut(buf.data() + 4);
+			break;
+		case ELoadProtocol::dextra:
+		{
+			char cs[CALLSIGN_LEN+1];
+			snprintf(cs, sizeof(cs), "%-8s", c.m_Callsign.c_str());
+			buf.Set((uint8_t *)cs, CALLSIGN_LEN);
+			buf.Append((uint8_t)0);
+			break;
+		}
+		case ELoadProtocol::ysf:
+		{
+			char cs[YSF_CALLSIGN_LENGTH+1];
+			snprintf(cs, sizeof(cs), "%-10s", c.m_Callsign.c_str());
+			buf.Set((uint8_t *)"YSFP", 4);
+			buf.Append((uint8_t *)cs, YSF_CALLSIGN_LENGTH);
+			break;
+		}
+		case ELoadProtocol::dmr:
+		{
+			uint8_t tag[] = { 'R','P','T','P','I','N','G' };
+			buf.Set(tag, sizeof(tag));
+			buf.Append((uint32_t)htonl(c.m_DmrId));
+			break;
+		}
+		default:
+			return;
+	}
+	c.m_Socket.Send(buf, m_Reflector);
+}
+
+void CLoadGen::SendDisconnect(CLoadClient &c)
+{
+	CBuffer buf;
+	switch (g_Opt.protocol)
+	{
+		case ELoadProtocol::m17:
+			buf.resize(10);
+			memcpy(buf.data(), "DISC", 4);
+			CCallsign(c.m_Callsign).CodeOut(buf.data() + 4);
+			break;
+		case ELoadProtocol::dextra:
+		{
+			char cs[CALLSIGN_LEN+1];
+			snprintf(cs, sizeof(cs), "%-8s", c.m_Callsign.c_str());
+			buf.Set((uint8_t *)cs, CALLSIGN_LEN);
+			buf.Append((uint8_t)'B');
+			buf.Append((uint8_t)' ');
+			buf.Append((uint8_t)0);
+			break;
+		}
+		case ELoadProtocol::ysf:
+		{
+			char cs[YSF_CALLSIGN_LENGTH+1];
+			snprintf(cs, sizeof(cs), "%-10s", c.m_Callsign.c_str());
+			buf.Set((uint8_t *)"YSFU", 4);
+			buf.Append((uint8_t *)cs, YSF_CALLSIGN_LENGTH);
+			break;
+		}
+		case ELoadProtocol::dmr:
+		{
+			uint8_t tag[] = { 'R','P','T','C','L' };
+			buf.Set(tag, sizeof(tag));
+			buf.Append((uint32_t)htonl(c.m_DmrId));
+			buf.Append((uint8_t)0, 4);
+			break;
+		}
+		default:
+			return;
+	}
+	c.m_Socket.Send(buf, m_Reflector);
+	c.m_State = EClientState::idle;
+}
+
+// a DMR client links by sending a header and terminator to TG 4001+
+void CLoadGen::SendLink(CLoadClient &c)
+{
+	CBuffer buf;
+	const uint32_t tg = 4001U + (c.m_Module - 'A');
+	const uint32_t sid = (uint32_t)random();
+	const uint8_t slot2 = (DMRMMDVM_REFLECTOR_SLOT == DMR_SLOT2) ? 0x80U : 0x00U;
+	EncodeDmr(buf, c, tg, sid, 0, slot2 | 0x20U | 0x01U, nullptr);
+	c.m_Socket.Send(buf, m_Reflector);
+	EncodeDmr(buf, c, tg, sid, 1, slot2 | 0x20U | 0x02U, nullptr);
+	c.m_Socket.Send(buf, m_Reflector);
+}
+
+// key up client c as talker number talker for g_Opt.talk seconds, in real time
+void CLoadGen::Transmit(CLoadClient &c, unsigned talker)
+{
+	CBuffer buf;
+	const auto start = LoadClock::now();
+	const uint16_t sid16 = (uint16_t)(random() | 1);
+	const uint32_t sid32 = (uint32_t)(random() | 1);
+	const uint32_t tg = 4001U + (c.m_Module - 'A');
+	const uint8_t slot2 = (DMRMMDVM_REFLECTOR_SLOT == DMR_SLOT2) ? 0x80U : 0x00U;
+	auto &sendtime = m_SendTime[talker];
+
+	// the number of voice units in each packet
+	unsigned per = 1;
+	switch (g_Opt.protocol)
+	{
+		case ELoadProtocol::m17:    per = 2; break;
+		case ELoadProtocol::ysf:    per = 5; break;
+		case ELoadProtocol::dmr:    per = 3; break;
+		default: break;
+	}
+
+	// header
+	switch (g_Opt.protocol)
+	{
+		case ELoadProtocol::dextra:
+			EncodeDextraHeader(buf, c, sid16);
+			c.m_Socket.Send(buf, m_Reflector);
+			break;
+		case ELoadProtocol::ysf:
+			EncodeYsf(buf, c, YSF_FI_HEADER, 0, 0, nullptr);
+			c.m_Socket.Send(buf, m_Reflector);
+			break;
+		case ELoadProtocol::dmr:
+			EncodeDmr(buf, c, tg, sid32, 0, slot2 | 0x20U | 0x01U, nullptr);
+			c.m_Socket.Send(buf, m_Reflector);
+			break;
+		default:
+			break;
+	}
+
+	unsigned packet = 0;
+	for (unsigned unit=0; unit+per<=m_Units; unit+=per, packet++)
+	{
+		std::this_thread::sleep_until(start + std::chrono::milliseconds(20 * (unit + per)));
+
+		uint32_t seqs[5];
+		for (unsigned i=0; i<per; i++)
+			seqs[i] = MakeSeq(talker, unit+i);
+		const bool last = (unit + 2 * per > m_Units);
+
+		switch (g_Opt.protocol)
+		{
+			case ELoadProtocol::m17:
+				EncodeM17(buf, c, sid16, packet % 0x8000U, seqs[0], seqs[1], last);
+				break;
+			case ELoadProtocol::dextra:
+				EncodeDextraFrame(buf, sid16, packet % 21, seqs[0], last);
+				break;
+			case ELoadProtocol::ysf:
+				EncodeYsf(buf, c, YSF_FI_COMMUNICATIONS, packet % 8, (packet << 1) & 0xFEU, seqs);
+				break;
+			case ELoadProtocol::dmr:
+			{
+				const uint8_t voiceseq = packet % 6;
+				const uint8_t bits = slot2 | ((0 == voiceseq) ? 0x10U : 0x00U) | voiceseq;
+				EncodeDmr(buf, c, tg, sid32, (packet + 1) & 0xFFU, bits, seqs);
+				break;
+			}
+			default:
+				break;
+		}
+
+		const auto now = Now();
+		for (unsigned i=0; i<per; i++)
+			sendtime[unit+i].store(now);
+		c.m_Socket.Send(buf, m_Reflector);
+	}
+
+	// terminator
+	switch (g_Opt.protocol)
+	{
+		case ELoadProtocol::ysf:
+			EncodeYsf(buf, c, YSF_FI_TERMINATOR, 0, 0, nullptr);
+			c.m_Socket.Send(buf, m_Reflector);
+			break;
+		case ELoadProtocol::dmr:
+			EncodeDmr(buf, c, tg, sid32, (packet + 1) & 0xFFU, slot2 | 0x20U | 0x02U, nullptr);
+			c.m_Socket.Send(buf, m_Reflector);
+			break;
+		default:
+			break;
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////
+// receiving
+
+void CLoadGen::ReceiveThread()
+{
+	std::vector<struct pollfd> fds(m_Clients.size());
+	for (unsigned i=0; i<m_Clients.size(); i++)
+	{
+		fds[i].fd = m_Clients[i]->m_Socket.GetSocket();
+		fds[i].events = POLLIN;
+	}
+
+	CBuffer buf;
+	CIp from;
+	while (m_Running)
+	{
+		if (0 >= poll(fds.data(), fds.size(), 20))
+			continue;
+		const auto now = Now();
+		for (unsigned i=0; i<fds.size(); i++)
+		{
+			if (fds[i].revents & POLLIN)
+			{
+				while (m_Clients[i]->m_Socket.ReceiveFrom(buf, from))
+					OnPacket(*m_Clients[i], buf, now);
+			}
+		}
+	}
+}
+
+void CLoadGen::OnUnit(CLoadClient &c, uint32_t seq, int64_t now_us)
+{
+	const unsigned talker = seq >> 16;
+	const unsigned unit = seq & 0xFFFFU;
+	double latency = 0.0;
+	if (talker < m_Talkers && unit < m_Units)
+		latency = (now_us - m_SendTime[talker][unit].load()) / 1000.0;
+	c.m_Stats.Unit(seq, latency);
+	c.m_Stats.m_LastUnit = now_us;
+}
+
+void CLoadGen::OnPacket(CLoadClient &c, const CBuffer &buf, int64_t now_us)
+{
+	uint32_t seq;
+	switch (g_Opt.protocol)
+	{
+		case ELoadProtocol::m17:
+			if (sizeof(SM17Frame) == buf.size() && 0 == memcmp(buf.data(), "M17 ", 4))
+			{
+				const SM17Frame *frame = (const SM17Frame *)buf.data();
+				if (M17HalfToSeq(frame->payload, seq))
+					OnUnit(c, seq, now_us);
+				if (M17HalfToSeq(frame->payload + 8, seq))
+					OnUnit(c, seq, now_us);
+			}
+			else if (4 == buf.size() && 0 == memcmp(buf.data(), "ACKN", 4))
+				c.m_State = EClientState::linked;
+			else if (4 == buf.size() && 0 == memcmp(buf.data(), "NACK", 4))
+				c.m_State = EClientState::refused;
+			// the reflector PINGs every client at once, answering each would be a burst,
+			// the keepalive thread's PONGs keep the clients linked
+			break;
+
+		case ELoadProtocol::dextra:
+			if (27 == buf.size() && 0 == memcmp(buf.data(), "DSVT", 4) && 0x20U == buf.data()[4])
+			{
+				if (AmbeToSeq(buf.data() + 15, seq))
+					OnUnit(c, seq, now_us);
+			}
+			else if (14 == buf.size() && 0 == memcmp(buf.data() + 10, "ACK", 3))
+				c.m_State = EClientState::linked;
+			else if (14 == buf.size() && 0 == memcmp(buf.data() + 10, "NAK", 3))
+				c.m_State = EClientState::refused;
+			break;
+
+		case ELoadProtocol::ysf:
+			if (155 == buf.size() && 0 == memcmp(buf.data(), "YSFD", 4))
+			{
+				CYSFFICH fich;
+				if (fich.decode(buf.data() + 40) && YSF_FI_COMMUNICATIONS == fich.getFI())
+				{
+					uint8_t ambe[5][9];
+					uint8_t *ambes[5] = { ambe[0], ambe[1], ambe[2], ambe[3], ambe[4] };
+					CYsfUtils::DecodeVD2Vchs((uint8_t *)buf.data() + 35, ambes);
+					for (int i=0; i<5; i++)
+						if (AmbeToSeq(ambe[i], seq))
+							OnUnit(c, seq, now_us);
+				}
+			}
+			else if (14 == buf.size() && 0 == memcmp(buf.data(), "YSFPREFLECTOR", 13))
+				c.m_State = EClientState::linked;
+			break;
+
+		case ELoadProtocol::dmr:
+			if (55 == buf.size() && 0 == memcmp(buf.data(), "DMRD", 4))
+			{
+				const uint8_t frametype = (buf.data()[15] & 0x30U) >> 4;
+				if (2 != frametype)
+				{
+					const uint8_t *p = buf.data() + 20;
+					uint8_t ambe[9];
+					if (AmbeToSeq(p, seq))
+						OnUnit(c, seq, now_us);
+					memcpy(ambe, p+9, 5);
+					ambe[4] = (p[13] & 0xF0U) | (p[19] & 0x0FU);
+					memcpy(ambe+5, p+20, 4);
+					if (AmbeToSeq(ambe, seq))
+						OnUnit(c, seq, now_us);
+					if (AmbeToSeq(p+24, seq))
+						OnUnit(c, seq, now_us);
+				}
+			}
+			else if (10 == buf.size() && 0 == memcmp(buf.data(), "RPTACK", 6) && EClientState::login == c.m_State)
+			{
+				// any hash will do, urfd doesn't check it
+				CBuffer auth;
+				auth.Set((uint8_t *)"RPTK", 4);
+				auth.Append((uint32_t)htonl(c.m_DmrId));
+				auth.Append((uint8_t)0, 32);
+				c.m_State = EClientState::auth;
+				c.m_Socket.Send(auth, m_Reflector);
+			}
+			else if (6 == buf.size() && 0 == memcmp(buf.data(), "RPTACK", 6))
+			{
+				if (EClientState::auth == c.m_State)
+				{
+					CBuffer config;
+					config.Set((uint8_t *)"RPTC", 4);
+					config.Append((uint32_t)htonl(c.m_DmrId));
+					char cs[9];
+					snprintf(cs, sizeof(cs), "%-8s", c.m_Callsign.c_str());
+					config.Append((uint8_t *)cs, 8);
+					config.Append((uint8_t)' ', 302 - 16);
+					c.m_State = EClientState::config;
+					c.m_Socket.Send(config, m_Reflector);
+				}
+				else if (EClientState::config == c.m_State)
+				{
+					c.m_State = EClientState::linking;
+				}
+			}
+			else if (6 == buf.size() && 0 == memcmp(buf.data(), "MSTNAK", 6))
+				c.m_State = EClientState::refused;
+			break;
+
+		default:
+			break;
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////
+// a test step
+
+void CLoadGen::Step(unsigned count)
+{
+	const unsigned nmods = g_Opt.modules.size();
+	m_Talkers = std::min<unsigned>(nmods, count);
+	m_Units = g_Opt.talk * LOADGEN_UNITS_PER_SECOND;
+	if (m_Units > 0x10000U)
+		m_Units = 0x10000U;
+	m_SendTime.clear();
+	for (unsigned t=0; t<m_Talkers; t++)
+	{
+		m_SendTime.emplace_back(new std::atomic<int64_t>[m_Units]);
+		for (unsigned u=0; u<m_Units; u++)
+			m_SendTime.back()[u].store(0);
+	}
+
+	// create the clients, round-robin over the modules
+	m_Clients.clear();
+	CIp local(m_Reflector.GetFamily(), 0, (AF_INET6 == m_Reflector.GetFamily()) ? "::" : "0.0.0.0");
+	for (unsigned i=0; i<count; i++)
+	{
+		m_Clients.emplace_back(new CLoadClient(i, g_Opt.modules[i % nmods]));
+		if (! m_Clients.back()->Open(local))
+		{
+			std::cerr << "Could only open " << i << " client sockets" << std::endl;
+			m_Clients.pop_back();
+			break;
+		}
+		m_Clients.back()->m_Stats.Reset(m_Talkers, m_Units);
+	}
+
+	m_Running = true;
+	m_Future = std::async(std::launch::async, &CLoadGen::ReceiveThread, this);
+
+	// connect everybody
+	std::cout << "Step with " << m_Clients.size() << " clients: connecting" << std::flush;
+	for (auto &c : m_Clients)
+	{
+		SendConnect(*c);
+		std::this_thread::sleep_for(std::chrono::milliseconds(2));
+	}
+
+	auto until = LoadClock::now() + std::chrono::milliseconds(LOADGEN_LINK_TIMEOUT);
+	bool linked_dmr = false;
+	while (LoadClock::now() < until)
+	{
+		unsigned waiting = 0;
+		for (auto &c : m_Clients)
+			if (EClientState::linked != c->m_State && EClientState::refused != c->m_State && EClientState::linking != c->m_State)
+				waiting++;
+		if (0 == waiting)
+		{
+			if (ELoadProtocol::dmr == g_Opt.protocol && ! linked_dmr)
+			{
+				// logged in, now link each to its module
+				for (auto &c : m_Clients)
+				{
+					if (EClientState::linking == c->m_State)
+					{
+						SendLink(*c);
+						c->m_State = EClientState::linked;
+						std::this_thread::sleep_for(std::chrono::milliseconds(5));
+					}
+				}
+				linked_dmr = true;
+				std::this_thread::sleep_for(std::chrono::seconds(2));
+			}
+			break;
+		}
+		std::this_thread::sleep_for(std::chrono::milliseconds(100));
+	}
+
+	unsigned linked = 0;
+	for (auto &c : m_Clients)
+		if (EClientState::linked == c->m_State)
+			linked++;
+	std::cout << ", " << linked << " linked, talking" << std::flush;
+
+	// one talker per module, every talker in its own thread, with a keepalive thread
+	// that spreads the keepalives over their period, one client at a time
+	std::atomic<bool> talking(true);
+	auto keepalive = std::async(std::launch::async, [&]() {
+		if (m_Clients.empty())
+			return;
+		const auto gap = std::chrono::microseconds(LOADGEN_KEEPALIVE_PERIOD * 1000 / m_Clients.size());
+		auto next = LoadClock::now();
+		for (std::size_t i=0; talking; i=(i+1)%m_Clients.size())
+		{
+			if (EClientState::linked == m_Clients[i]->m_State)
+				SendKeepalive(*m_Clients[i]);
+			next += gap;
+			while (talking && LoadClock::now() < next)
+				std::this_thread::sleep_for(std::min<LoadClock::duration>(next - LoadClock::now(), std::chrono::milliseconds(100)));
+		}
+	});
+	const auto talk_start = Now();
+	std::vector<std::future<void>> talkers;
+	for (unsigned t=0; t<m_Talkers; t++)
+	{
+		if (EClientState::linked == m_Clients[t]->m_State)
+			talkers.push_back(std::async(std::launch::async, &CLoadGen::Transmit, this, std::ref(*m_Clients[t]), t));
+	}
+	for (auto &f : talkers)
+		f.get();
+	const auto talk_end = Now();
+
+	std::this_thread::sleep_for(std::chrono::milliseconds(LOADGEN_DRAIN_TIME));
+	talking = false;
+	keepalive.get();
+	m_Running = false;
+	m_Future.get();
+
+	for (auto &c : m_Clients)
+		SendDisconnect(*c);
+	std::cout << ", done" << std::endl;
+
+	// gather the results
+	SStepResult r;
+	memset(&r, 0, sizeof(r));
+	r.clients = m_Clients.size();
+	r.linked = linked;
+	r.talkers = talkers.size();
+	r.worst = 100.0;
+	r.cutoff = -1.0;
+	std::vector<double> all;
+	// a rate limit or a ban makes every listener go quiet at once, a struggling reflector doesn't
+	unsigned quiet = 0, expecting = 0;
+	int64_t first_quiet = talk_end, last_quiet = talk_start;
+	for (auto &c : m_Clients)
+	{
+		// talkers don't hear themselves
+		if (c->m_Index < m_Talkers)
+			continue;
+		r.listeners++;
+		// a listener only expects the talker on its own module
+		const unsigned talker = c->m_Index % nmods;
+		const unsigned expected = (talker < m_Talkers) ? m_Units : 0;
+		r.expected += expected;
+		r.received += c->m_Stats.m_Received;
+		r.duplicate += c->m_Stats.m_Duplicate;
+		r.reordered += c->m_Stats.m_Reordered;
+		if (expected)
+		{
+			double pct = 100.0 * c->m_Stats.m_Received / expected;
+			if (pct < r.worst)
+				r.worst = pct;
+			expecting++;
+			const int64_t last = std::max(c->m_Stats.m_LastUnit, talk_start);
+			if (last < talk_end - LOADGEN_SILENCE_TIME * 1000)
+			{
+				quiet++;
+				first_quiet = std::min(first_quiet, last);
+				last_quiet = std::max(last_quiet, last);
+			}
+		}
+		all.insert(all.end(), c->m_Stats.m_Latency.begin(), c->m_Stats.m_Latency.end());
+	}
+	if (! all.empty())
+	{
+		std::sort(all.begin(), all.end());
+		double sum = 0.0;
+		for (auto l : all)
+			sum += l;
+		r.avg = sum / all.size();
+		r.p50 = all[all.size() / 2];
+		r.p99 = all[(all.size() * 99) / 100];
+		r.max = all.back();
+	}
+	if (expecting && quiet == expecting && last_quiet - first_quiet <= LOADGEN_CUTOFF_SPREAD * 1000)
+		r.cutoff = (last_quiet - talk_start) / 1000000.0;
+	m_Results.push_back(r);
+	m_Clients.clear();
+
+	// give the reflector time to notice the disconnects before the next step
+	std::this_thread::sleep_for(std::chrono::seconds(2));
+}
+
+void CLoadGen::Report() const
+{
+	std::cout << std::endl << "Load report, " << g_Opt.talk << " second transmissions on module(s) " << g_Opt.modules << std::endl;
+	std::cout << std::string(116, '-') << std::endl;
+	std::cout << std::right
+		<< std::setw(8) << "clients" << std::setw(8) << "linked" << std::setw(8) << "talkers" << std::setw(10) << "listeners"
+		<< std::setw(12) << "delivered" << std::setw(9) << "worst" << std::setw(8) << "lost" << std::setw(8) << "dup" << std::setw(9) << "reorder"
+		<< std::setw(9) << "avg ms" << std::setw(9) << "p50 ms" << std::setw(9) << "p99 ms" << std::setw(9) << "max ms" << std::endl;
+	std::cout << std::string(116, '-') << std::endl;
+	bool cutoff = false;
+	for (const auto &r : m_Results)
+	{
+		if (r.cutoff >= 0.0)
+		{
+			std::cout << std::fixed << std::setprecision(1)
+				<< std::setw(8) << r.clients << std::setw(8) << r.linked << std::setw(8) << r.talkers << std::setw(10) << r.listeners
+				<< "   cut off after " << r.cutoff << " s, every listener went silent at once" << std::endl;
+			cutoff = true;
+			continue;
+		}
+		const double delivered = r.expected ? (100.0 * r.received / r.expected) : 0.0;
+		const uint64_t lost = (r.expected > r.received) ? (r.expected - r.received) : 0;
+		std::cout << std::fixed << std::setprecision(1)
+			<< std::setw(8) << r.clients << std::setw(8) << r.linked << std::setw(8) << r.talkers << std::setw(10) << r.listeners
+			<< std::setw(11) << delivered << '%' << std::setw(8) << r.worst << '%' << std::setw(8) << lost << std::setw(8) << r.duplicate << std::setw(9) << r.reordered
+			<< std::setw(9) << r.avg << std::setw(9) << r.p50 << std::setw(9) << r.p99 << std::setw(9) << r.max << std::endl;
+	}
+	if (cutoff)
+		std::cout << std::endl << "A cut off step isn't frame loss: the reflector stopped taking this host's packets. All the clients" << std::endl
+			<< "share one address, so on another host set the protocol's [Rate Limits] in urfd.ini to 0." << std::endl;
+}
+
+void CLoadGen::PrintDmrDb()
+{
+	unsigned max = 0;
+	for (auto n : g_Opt.counts)
+		if (n > max)
+			max = n;
+	for (unsigned i=0; i<max; i++)
+	{
+		CLoadClient c(i, 'A');
+		std::cout << c.m_DmrId << ';' << c.m_Callsign << ";\n";
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+static void usage(std::ostream &os, const char *name)
+{
+	os << "\nUsage: " << name << " PROTOCOL [OPTIONS]\n";
+	os << "PROTOCOL (choose one)\n"
+		"    m17    : M17 clients.\n"
+		"    dextra : DExtra clients.\n"
+		"    ysf    : YSF clients, linked by the reflector's YSF AutoLinkModule.\n"
+		"    dmr    : MMDVM DMR clients, their DMR ids must be in the reflector's DMR database.\n"
+		"OPTIONS\n"
+		"    --host=ADDRESS      : The reflector address (default 127.0.0.1).\n"
+		"    --port=PORT         : Use a port other than the protocol's default port.\n"
+		"    --modules=LIST      : The modules to use, with one talker on each (default A).\n"
+		"    --clients=N[,N...]  : The client counts to step through (default 10,50,100).\n"
+		"    --talk=SECS         : How long the talkers transmit in each step (default 10).\n"
+		"    --reflector=CS      : The reflector callsign, for M17 and D-Star destinations (default URF000).\n"
+		"    --dmrid=ID          : The DMR id of the first dmr client (default 3100001).\n"
+		"    --dmrdb             : Print a DMR id database for the dmr clients and exit.\n\n"
+		"Use modules that aren't transcoded. Example: " << name << " m17 --modules=MS --clients=10,100,500\n"
+		"Unless the reflector is on this host, set its [Rate Limits] for the protocol to 0.\n\n";
+}
+
+int main(int argc, char *argv[])
+{
+	bool dmrdb = false;
+
+	if (argc < 2)
+	{
+		usage(std::cerr, argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	const std::string proto(argv[1]);
+	if (0 == proto.compare("m17"))
+		g_Opt.protocol = ELoadProtocol::m17;
+	else if (0 == proto.compare("dextra"))
+		g_Opt.protocol = ELoadProtocol::dextra;
+	else if (0 == proto.compare("ysf"))
+		g_Opt.protocol = ELoadProtocol::ysf;
+	else if (0 == proto.compare("dmr"))
+		g_Opt.protocol = ELoadProtocol::dmr;
+
+	for (int i=2; i<argc; i++)
+	{
+		const std::string arg(argv[i]);
+		const auto eq = arg.find('=');
+		const std::string key(arg.substr(0, eq));
+		const std::string val((std::string::npos == eq) ? "" : arg.substr(eq+1));
+		if (0 == key.compare("--host"))
+			g_Opt.host.assign(val);
+		else if (0 == key.compare("--port"))
+			g_Opt.port = uint16_t(std::atoi(val.c_str()));
+		else if (0 == key.compare("--modules"))
+			g_Opt.modules.assign(val);
+		else if (0 == key.compare("--clients"))
+		{
+			g_Opt.counts.clear();
+			std::stringstream ss(val);
+			std::string n;
+			while (std::getline(ss, n, ','))
+				if (std::atoi(n.c_str()) > 0)
+					g_Opt.counts.push_back(unsigned(std::atoi(n.c_str())));
+		}
+		else if (0 == key.compare("--talk"))
+			g_Opt.talk = unsigned(std::atoi(val.c_str()));
+		else if (0 == key.compare("--reflector"))
+			g_Opt.reflector.assign(val);
+		else if (0 == key.compare("--dmrid"))
+			g_Opt.dmrid = uint32_t(std::atol(val.c_str()));
+		else if (0 == key.compare("--dmrdb"))
+			dmrdb = true;
+		else
+			g_Opt.protocol = ELoadProtocol::none;
+	}
+
+	bool ok = (ELoadProtocol::none != g_Opt.protocol) && ! g_Opt.modules.empty() && ! g_Opt.counts.empty() && g_Opt.talk > 0;
+	for (auto m : g_Opt.modules)
+		ok = ok && std::isupper(m);
+	if (ok && ELoadProtocol::ysf == g_Opt.protocol && 1 != g_Opt.modules.size())
+	{
+		std::cerr << "YSF clients can only use the reflector's AutoLinkModule, so specify exactly one module" << std::endl;
+		ok = false;
+	}
+	if (! ok)
+	{
+		usage(std::cerr, argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	if (dmrdb)
+	{
+		CLoadGen::PrintDmrDb();
+		return EXIT_SUCCESS;
+	}
+
+	CLoadGen loadgen;
+	if (loadgen.Setup())
+		return EXIT_FAILURE;
+
+	srandom(time(nullptr));
+	for (auto n : g_Opt.counts)
+		loadgen.Step(n);
+	loadgen.Report();
+
+	return EXIT_SUCCESS;
+}
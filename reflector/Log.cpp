@@ -0,0 +1,285 @@
+// urfd -- The universal reflector
+// Copyright © 2024 Thomas A. Early N7TAE
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+#include "Log.h"
+#include "Timer.h"
+
+static_assert(0 == (LOG_RING_SIZE & (LOG_RING_SIZE - 1)), "LOG_RING_SIZE must be a power of two");
+
+////////////////////////////////////////////////////////////////////////////////////////
+// constructor / destructor
+
+CLog::CLog() : m_enqueue(0), m_dequeue(0), m_level(ELogLevel::info), m_dropped(0), m_reported(0), m_running(false), m_journal(false)
+{
+	for (unsigned i = 0; i < LOG_RING_SIZE; i++)
+		m_ring[i].seq.store(i, std::memory_order_relaxed);
+	for (auto &r : m_rates)
+	{
+		r.event.store(nullptr, std::memory_order_relaxed);
+		r.period.store(0, std::memory_order_relaxed);
+		r.count.store(0, std::memory_order_relaxed);
+		r.suppressed.store(0, std::memory_order_relaxed);
+	}
+}
+
+CLog::~CLog()
+{
+	Stop();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////
+// start / stop
+
+void CLog::Start(ELogLevel level)
+{
+	m_level = level;
+	// under systemd, journald reads the severity from a "<N>" prefix, see sd-daemon(3)
+	m_journal = (nullptr != getenv("JOURNAL_STREAM"));
+	m_out.reserve(LOG_RING_SIZE * 64);
+	m_err.reserve(LOG_RING_SIZE * 16);
+
+	m_running = true;
+	try
+	{
+		m_future = std::async(std::launch::async, &CLog::Thread, this);
+	}
+	catch (const std::exception &e)
+	{
+		m_running = false;
+		std::cerr << "Could not start the log thread, logging directly: " << e.what() << std::endl;
+	}
+}
+
+void CLog::Stop(void)
+{
+	if ( m_future.valid() )
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_running = false;
+		}
+		m_cv.notify_one();
+		m_future.get();
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////
+// writers, any thread
+
+// each event gets a slot the first time it's seen, found by its name
+bool CLog::Allow(const char *event)
+{
+	const uint32_t now = uint32_t(std::chrono::duration_cast<std::chrono::seconds>(std::chrono::steady_clock::now().time_since_epoch()).count() / LOG_RATE_PERIOD);
+	uint32_t hash = 2166136261u;	// FNV-1a
+	for (const char *p = event; *p; p++)
+		hash = (hash ^ uint8_t(*p)) * 16777619u;
+	for (unsigned i = 0; i < LOG_RATE_SLOTS; i++)
+	{
+		auto &r = m_rates[(hash + i) % LOG_RATE_SLOTS];
+		const char *e = r.event.load(std::memory_order_acquire);
+		if ( nullptr == e && r.event.compare_exchange_strong(e, event, std::memory_order_acq_rel) )
+			e = event;
+		if ( e != event && strcmp(e, event) )
+			continue;
+
+		uint32_t period = r.period.load(std::memory_order_relaxed);
+		if ( period != now && r.period.compare_exchange_strong(period, now, std::memory_order_relaxed) )
+			r.count.store(0, std::memory_order_relaxed);
+		if ( r.count.fetch_add(1, std::memory_order_relaxed) < LOG_RATE_BURST )
+			return true;
+		r.suppressed.fetch_add(1, std::memory_order_relaxed);
+		return false;
+	}
+	return true;	// too many different events to keep track of
+}
+
+void CLog::Write(ELogLevel level, const char *line, unsigned length)
+{
+	if ( length > LOG_LINE_MAX )
+		length = LOG_LINE_MAX;
+
+	if ( ! m_running )
+	{
+		FILE *fp = (level >= ELogLevel::warning) ? stderr : stdout;
+		fwrite(line, 1, length, fp);
+		fputc('\n', fp);
+		fflush(fp);
+		return;
+	}
+
+	// claim a cell: it is free when its sequence number is the position being claimed
+	uint64_t pos = m_enqueue.load(std::memory_order_relaxed);
+	SLogEntry *cell;
+	while (true)
+	{
+		cell = &m_ring[pos & (LOG_RING_SIZE - 1)];
+		const uint64_t seq = cell->seq.load(std::memory_order_acquire);
+		const int64_t dif = int64_t(seq) - int64_t(pos);
+		if ( 0 == dif )
+		{
+			if ( m_enqueue.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed) )
+				break;
+		}
+		else if ( dif < 0 )
+		{
+			// the ring is full
+			m_dropped.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}
+		else
+			pos = m_enqueue.load(std::memory_order_relaxed);
+	}
+
+	cell->level = level;
+	cell->length = length;
+	memcpy(cell->text, line, length);
+	cell->seq.store(pos + 1, std::memory_order_release);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////
+// the drain thread
+
+void CLog::Thread(void)
+{
+	CTimer report;
+	while (m_running)
+	{
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_cv.wait_for(lock, std::chrono::milliseconds(LOG_DRAIN_MS), [this]{ return ! m_running; });
+		}
+		Drain();
+		if ( report.time() >= LOG_RATE_PERIOD )
+		{
+			ReportSuppressed();
+			report.start();
+		}
+	}
+	// whatever was written before Stop()
+	Drain();
+	ReportSuppressed();
+}
+
+void CLog::Drain(void)
+{
+	bool any = false;
+	while (true)
+	{
+		SLogEntry &cell = m_ring[m_dequeue & (LOG_RING_SIZE - 1)];
+		if ( cell.seq.load(std::memory_order_acquire) != m_dequeue + 1 )
+			break;
+		Output(cell.level, cell.text, cell.length);
+		cell.seq.store(m_dequeue + LOG_RING_SIZE, std::memory_order_release);
+		m_dequeue++;
+		any = true;
+	}
+	if ( any )
+		Flush();
+}
+
+void CLog::Output(ELogLevel level, const char *line, unsigned length)
+{
+	if ( m_journal )
+	{
+		static const char *prefix[] = { "<7>", "<6>", "<4>", "<3>" };
+		m_out.append(prefix[int(level)]);
+		m_out.append(line, length);
+		m_out.push_back('\n');
+	}
+	else
+	{
+		std::string &s = (level >= ELogLevel::warning) ? m_err : m_out;
+		s.append(line, length);
+		s.push_back('\n');
+	}
+}
+
+void CLog::Flush(void)
+{
+	if ( m_out.size() )
+	{
+		fwrite(m_out.data(), 1, m_out.size(), stdout);
+		fflush(stdout);
+		m_out.clear();
+	}
+	if ( m_err.size() )
+	{
+		fwrite(m_err.data(), 1, m_err.size(), stderr);
+		fflush(stderr);
+		m_err.clear();
+	}
+}
+
+void CLog::ReportSuppressed(void)
+{
+	char line[LOG_LINE_MAX];
+	for (auto &r : m_rates)
+	{
+		const char *event = r.event.load(std::memory_order_acquire);
+		if ( nullptr == event )
+			continue;
+		const uint32_t n = r.suppressed.exchange(0, std::memory_order_relaxed);
+		if ( n )
+		{
+			snprintf(line, sizeof(line), "Suppressed %u log lines event=%s", n, event);
+			Output(ELogLevel::warning, line, strlen(line));
+		}
+	}
+	const uint64_t dropped = GetDropped();
+	if ( dropped > m_reported )
+	{
+		snprintf(line, sizeof(line), "Dropped %llu log lines, the log ring was full", (unsigned long long)(dropped - m_reported));
+		Output(ELogLevel::warning, line, strlen(line));
+		m_reported = dropped;
+	}
+	Flush();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////
+// CLogLine
+
+CLogLine::CLogLine(ELogLevel level, const char *event)
+	: m_level(level), m_on(g_Log.IsEnabled(level) && g_Log.Allow(event)), m_buf(m_text, LOG_LINE_MAX), m_os(&m_buf) {}
+
+CLogLine::~CLogLine()
+{
+	if ( m_on )
+		g_Log.Write(m_level, m_text, m_buf.length());
+}
+
+// a field's value is trimmed, and quoted if it still has a space in it
+void CLogLine::Quote(unsigned start)
+{
+	char *b = m_buf.base();
+	unsigned end = m_buf.length();
+	while ( end > start && ' ' == b[end-1] )
+		end--;
+	m_buf.truncate(end);
+	if ( nullptr == memchr(b + start, ' ', end - start) )
+		return;
+	if ( end + 2 > LOG_LINE_MAX )
+		return;
+	memmove(b + start + 1, b + start, end - start);
+	b[start] = '"';
+	b[end + 1] = '"';
+	m_buf.truncate(end + 2);
+}
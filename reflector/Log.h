@@ -0,0 +1,186 @@
+// urfd -- The universal reflector
+// Copyright © 2024 Thomas A. Early N7TAE
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <future>
+#include <mutex>
+#include <ostream>
+#include <streambuf>
+#include <string>
+
+#define LOG_RING_SIZE      1024    // lines waiting for the drain thread, a power of two
+#define LOG_LINE_MAX       256     // longer lines are truncated
+#define LOG_DRAIN_MS       20      // how often the drain thread writes a batch
+#define LOG_RATE_SLOTS     64      // distinct events that are rate limited
+#define LOG_RATE_PERIOD    10      // seconds
+#define LOG_RATE_BURST     100     // lines of one event in each period, the rest are counted
+
+enum class ELogLevel { debug, info, warning, error };
+
+////////////////////////////////////////////////////////////////////////////////////////
+// The reflector's log. Threads hand their lines to a lock-free ring and go on with
+// their work. A background thread writes them out in batches, so the protocol and
+// codec threads never wait on the stdout lock or on journald. When the ring is full,
+// the line is dropped and counted. Each line belongs to an event, a short tag like
+// "client-add", and an event that floods is cut to LOG_RATE_BURST lines a period,
+// with a summary of what was suppressed. Until Start() is called, lines are written
+// straight out.
+
+class CLog
+{
+public:
+	CLog();
+	~CLog();
+
+	void Start(ELogLevel level = ELogLevel::info);
+	void Stop(void);
+
+	bool IsEnabled(ELogLevel level) const { return level >= m_level.load(std::memory_order_relaxed); }
+	// false if the event has used up its lines for this period
+	bool Allow(const char *event);
+	void Write(ELogLevel level, const char *line, unsigned length);
+
+	uint64_t GetDropped(void) const { return m_dropped.load(std::memory_order_relaxed); }
+
+protected:
+	struct SLogEntry
+	{
+		std::atomic<uint64_t> seq;
+		ELogLevel level;
+		uint16_t  length;
+		char      text[LOG_LINE_MAX];
+	};
+
+	struct SLogRate
+	{
+		std::atomic<const char *> event;
+		std::atomic<uint32_t> period, count, suppressed;
+	};
+
+	void Thread(void);
+	void Drain(void);
+	void Output(ELogLevel level, const char *line, unsigned length);
+	void Flush(void);
+	void ReportSuppressed(void);
+
+	// the ring, many writers and one reader
+	SLogEntry m_ring[LOG_RING_SIZE];
+	std::atomic<uint64_t> m_enqueue;
+	uint64_t m_dequeue;
+
+	SLogRate m_rates[LOG_RATE_SLOTS];
+	std::atomic<ELogLevel> m_level;
+	std::atomic<uint64_t> m_dropped;
+	uint64_t m_reported;
+
+	// the drain thread
+	std::atomic<bool> m_running;
+	bool m_journal;
+	std::mutex m_mutex;
+	std::condition_variable m_cv;
+	std::future<void> m_future;
+	std::string m_out, m_err;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
+// One log line, built on the caller's stack and handed to the log when it goes out of
+// scope. Anything with an operator<< can be written to it, and Field() appends a
+// key=value pair after the text, HexField() one with a number in hex:
+//
+//   CLogLine(ELogLevel::info, "client-add") << "New client" << Field("callsign", cs);
+//
+// A line that isn't enabled, or whose event is being rate limited, formats nothing.
+
+class CLogLine
+{
+	class CLineBuf : public std::streambuf
+	{
+	public:
+		CLineBuf(char *b, unsigned size) { setp(b, b + size); }
+		unsigned length(void) const { return pptr() - pbase(); }
+		char *base(void) const { return pbase(); }
+		void truncate(unsigned n) { setp(pbase(), epptr()); pbump(n); }
+	};
+
+public:
+	CLogLine(ELogLevel level, const char *event);
+	~CLogLine();
+
+	template <typename T> CLogLine &operator<<(const T &v)
+	{
+		if ( m_on )
+			m_os << v;
+		return *this;
+	}
+	CLogLine &operator<<(std::ios_base &(*manip)(std::ios_base &))
+	{
+		if ( m_on )
+			m_os << manip;
+		return *this;
+	}
+
+	template <typename T> struct SField
+	{
+		const char *key;
+		const T &value;
+	};
+	template <typename T> CLogLine &operator<<(const SField<T> &f)
+	{
+		if ( m_on )
+		{
+			m_os << ' ' << f.key << '=';
+			const unsigned start = m_buf.length();
+			m_os << f.value;
+			Quote(start);
+		}
+		return *this;
+	}
+
+	// a number in hex, the stream's format is left as it was
+	template <typename T> struct SHexField
+	{
+		const char *key;
+		T value;
+	};
+	template <typename T> CLogLine &operator<<(const SHexField<T> &f)
+	{
+		if ( m_on )
+		{
+			const auto flags = m_os.flags();
+			m_os << ' ' << f.key << '=' << std::showbase << std::hex << f.value;
+			m_os.flags(flags);
+		}
+		return *this;
+	}
+
+private:
+	void Quote(unsigned start);
+
+	const ELogLevel m_level;
+	const bool m_on;
+	char m_text[LOG_LINE_MAX];
+	CLineBuf m_buf;
+	std::ostream m_os;
+};
+
+template <typename T> CLogLine::SField<T> Field(const char *key, const T &value) { return { key, value }; }
+template <typename T> CLogLine::SHexField<T> HexField(const char *key, T value) { return { key, value }; }
+
+extern CLog g_Log;
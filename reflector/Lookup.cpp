@@ -16,110 +16,215 @@
 // You should have received a copy of the GNU General Public License
 // along with this program.  If not, see <https://www.gnu.org/licenses/>.
 
+#include <cstring>
 #include <fstream>
 #include <unordered_map>
 #include <thread>
-#include <sys/stat.h>
-#include "CurlGet.h"
+#include "Global.h"
+#include "IdImage.h"
 #include "Lookup.h"
 
 void CLookup::LookupClose()
 {
-	keep_running = false;
+	if (m_WatchHandle)
+	{
+		g_FileWatcher.Unwatch(m_WatchHandle);
+		m_WatchHandle = 0;
+	}
+	{
+		std::lock_guard<std::mutex> lock(m_WaitMutex);
+		keep_running = false;
+	}
+	m_WaitCV.notify_all();
 	if (m_Future.valid())
 		m_Future.get();
 }
 
-std::time_t CLookup::GetLastModTime()
+void CLookup::LookupInit()
 {
-	struct stat fileStat;
-	if(0 == stat(m_Path.c_str(), &fileStat))
+	LoadParameters();
+
+	// the file is loaded on the first pass, and then whenever it changes
+	m_FileChanged = (ERefreshType::http != m_Type);
+	if (m_FileChanged)
 	{
-		return fileStat.st_mtime;
+		m_WatchHandle = g_FileWatcher.Watch(m_Path, [this]() {
+			{
+				std::lock_guard<std::mutex> lock(m_WaitMutex);
+				m_FileChanged = true;
+			}
+			m_WaitCV.notify_all();
+		});
 	}
-	return 0;
+
+	m_Future = std::async(std::launch::async, &CLookup::Thread, this);
 }
 
-void CLookup::LookupInit()
+// until it's time, the file changes or the lookup is closed
+void CLookup::Wait(std::chrono::steady_clock::time_point until)
 {
-	LoadParameters();
-
-	m_Future = std::async(std::launch::async, &CLookup::Thread, this);
+	std::unique_lock<std::mutex> lock(m_WaitMutex);
+	m_WaitCV.wait_until(lock, until, [this]() { return m_FileChanged || ! keep_running; });
 }
 
 void CLookup::Thread()
 {
-	const unsigned long wait_cycles = m_Refresh * 6u; // the number of while loops in m_Refresh
-	unsigned long count = 0;
+	using Clock = std::chrono::steady_clock;
+	// with no URL to refresh, this only wakes when the file changes
+	const auto forever = Clock::now() + std::chrono::hours(24 * 365);
+	auto next_http = Clock::now();
 	while (keep_running)
 	{
-		std::stringstream ss;
+		// a compiled database is mapped again whenever dbutil replaces it
+		if (ERefreshType::binary == m_Type)
+		{
+			if (m_FileChanged.exchange(false) && LoadContentImage())
+				m_Generation.fetch_add(1, std::memory_order_release);
+			Wait(forever);
+			continue;
+		}
+
 		bool http_loaded = false;
 		bool file_loaded = false;
 
 		// load http section first, if configured and m_Refresh minutes have lapsed
-		// on the first pass through this while loop (count == 0)
-		if (ERefreshType::file != m_Type && 0ul == count++ % wait_cycles)
+		if (ERefreshType::file != m_Type && Clock::now() >= next_http)
 		{
+			next_http = Clock::now() + std::chrono::minutes(m_Refresh);
 			// if SIG_INT was received at this point in time,
 			// in might take a bit more than 10 seconds to soft close
-			http_loaded = LoadContentHttp(ss);
+			NewContents(false);
+			http_loaded = LoadContentHttp(Eaction::normal);
 		}
 
-		// load the file if http was loaded or if we haven't loaded since the last mod time
+		// load the file if http was loaded or if it has changed since it was last loaded
 		if (ERefreshType::http != m_Type)
 		{
-			if (http_loaded || m_LastLoadTime < GetLastModTime())
+			const bool changed = m_FileChanged.exchange(false);
+			if (http_loaded || changed)
 			{
-				file_loaded = LoadContentFile(ss);
-				time(&m_LastLoadTime);
+				// if m_Type == ERefreshType::both, and if something was deleted from the file,
+				// it won't be purged from the map(s) until http is loaded
+				// It would be a lot of work (iterating on an unordered_map) to do otherwise!
+				if (! http_loaded)
+					NewContents(ERefreshType::file != m_Type);
+				file_loaded = LoadContentFile(Eaction::normal);
 			}
 		}
 
-		// now update the map(s) if anything was loaded
+		// now publish the new map(s) if anything was loaded
 		if (http_loaded || file_loaded)
 		{
-			Lock();
-			// if m_Type == ERefreshType::both, and if something was deleted from the file,
-			// it won't be purged from the map(s) until http is loaded
-			// It would be a lot of work (iterating on an unordered_map) to do otherwise!
-			if (http_loaded || ERefreshType::file == m_Type)
-				ClearContents();
-			UpdateContent(ss, Eaction::normal);
-			Unlock();
+			PublishContents();
+			m_Generation.fetch_add(1, std::memory_order_release);
 		}
+		else
+			DiscardContents();
 
-		// now wait for 10 seconds
-		std::this_thread::sleep_for(std::chrono::seconds(10));
+		// now wait for the next refresh, or for the file to change
+		Wait((ERefreshType::file == m_Type) ? forever : next_http);
 	}
 }
 
-bool CLookup::LoadContentHttp(std::stringstream &ss)
+// true if the URL was read and has changed since the last time
+bool CLookup::LoadContentHttp(Eaction action)
 {
+	std::string partial;
+	uint64_t hash = 14695981039346656037ull;	// FNV-1a
+	auto write = [&](const char *data, size_t size) -> bool
+	{
+		for (size_t i = 0; i < size; i++)
+			hash = (hash ^ uint8_t(data[i])) * 1099511628211ull;
+		UpdateLines(data, size, partial, action);
+		return keep_running;
+	};
+
 	CCurlGet get;
-	auto code = get.GetURL(m_Url, ss);
-	return CURLE_OK == code;
+	bool unchanged;
+	// the utility always wants the whole file
+	SCurlValidators none;
+	auto code = get.GetURL(m_Url, (Eaction::normal == action) ? m_Validators : none, write, unchanged);
+	if (CURLE_OK != code || unchanged)
+		return false;
+	if (partial.size())
+		UpdateLine(partial, action);
+
+	if (Eaction::normal == action)
+	{
+		if (hash == m_HttpHash)
+			return false;
+		m_HttpHash = hash;
+	}
+	return true;
 }
 
-bool CLookup::LoadContentFile(std::stringstream &ss)
+bool CLookup::LoadContentFile(Eaction action)
 {
-	bool rval = false;
-    std::ifstream file(m_Path);
-    if ( file )
-    {
-        ss << file.rdbuf();
-        file.close();
-		rval = true;
-    }
-	return rval;
+	std::ifstream file(m_Path, std::ios::binary);
+	if (! file)
+		return false;
+	// the whole file in one buffer, and then each line is a view into it
+	std::string buffer((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+	std::string partial;
+	UpdateLines(buffer.data(), buffer.size(), partial, action);
+	if (partial.size())
+		UpdateLine(partial, action);
+	return true;
+}
+
+// hand each complete line to the parser, keeping what's left for the next chunk. A line
+// is only copied if it's split between chunks.
+void CLookup::UpdateLines(const char *data, std::size_t size, std::string &partial, Eaction action)
+{
+	const char *end = data + size;
+	while (data < end)
+	{
+		auto nl = static_cast<const char *>(memchr(data, '\n', end - data));
+		if (nullptr == nl)
+		{
+			partial.append(data, end);
+			return;
+		}
+		if (partial.empty())
+			UpdateLine(std::string_view(data, nl - data), action);
+		else
+		{
+			partial.append(data, nl);
+			UpdateLine(partial, action);
+			partial.clear();
+		}
+		data = nl + 1;
+	}
 }
 
 bool CLookup::Utility(Eaction action, Esource source)
 {
-	std::stringstream ss;
 	LoadParameters();
-	auto rval = (Esource::http == source) ? LoadContentHttp(ss) : LoadContentFile(ss);
-	if (rval)
-		UpdateContent(ss, action);
-	return rval;
+	return (Esource::http == source) ? LoadContentHttp(action) : LoadContentFile(action);
+}
+
+bool CLookup::Compile(Esource source, const std::string &path)
+{
+	LoadParameters();
+	if (Esource::file == source && (0 == path.compare(m_Path) || CIdImage::IsImage(m_Path)))
+	{
+		std::cerr << "The source, " << m_Path << ", must be a text file and can't be the output" << std::endl;
+		return false;
+	}
+	NewContents(false);
+	if (! ((Esource::http == source) ? LoadContentHttp(Eaction::normal) : LoadContentFile(Eaction::normal)))
+		return false;
+	return WriteContentImage(path);
+}
+
+bool CLookup::LoadContentImage()
+{
+	std::cerr << "This database has no compiled form, use Mode file, http or both" << std::endl;
+	return false;
+}
+
+bool CLookup::WriteContentImage(const std::string &)
+{
+	std::cerr << "This database can't be compiled" << std::endl;
+	return false;
 }
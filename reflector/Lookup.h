@@ -19,10 +19,15 @@
 #pragma once
 
 #include <atomic>
+#include <condition_variable>
 #include <future>
+#include <mutex>
 #include <iostream>
+#include <memory>
+#include <string_view>
 #include "Callsign.h"
 #include "Configure.h"
+#include "CurlGet.h"
 
 enum class Eaction { normal, parse, error_only };
 enum class Esource { http, file };
@@ -33,33 +38,54 @@ class CLookup
 {
 public:
 	// constructor
-	CLookup() : keep_running(true), m_LastLoadTime(0) {}
+	CLookup() : m_HttpHash(0), m_FileChanged(false), m_WatchHandle(0), keep_running(true), m_Generation(0) {}
 
 	void LookupInit();
 	void LookupClose();
 
-	// locks
-	void Lock(void)   { m_Mutex.lock();   }
-	void Unlock(void) { m_Mutex.unlock(); }
 	bool Utility(Eaction action, Esource source);
+	bool Compile(Esource source, const std::string &path);
+
+	// counts the databases published, so a copy of a lookup can tell it's out of date
+	uint32_t GetGeneration() const { return m_Generation.load(std::memory_order_acquire); }
 
 protected:
-	std::time_t GetLastModTime();
 	virtual void LoadParameters() = 0;
-	virtual void ClearContents()  = 0;
 	void Thread();
+	void Wait(std::chrono::steady_clock::time_point until);
 
 	// refresh
-	bool LoadContentHttp(std::stringstream &ss);
-	bool LoadContentFile(std::stringstream &ss);
-	virtual void UpdateContent(std::stringstream &ss, Eaction action) = 0;
+	// A new database is built off to the side, starting empty or as a copy of the
+	// current one, and then published all at once. Readers take their own reference
+	// to whichever database is current, so they never wait on a refresh and never
+	// see one half done. Each line is parsed as it is read, the URL's as it arrives.
+	bool LoadContentHttp(Eaction action);
+	bool LoadContentFile(Eaction action);
+	void UpdateLines(const char *data, std::size_t size, std::string &partial, Eaction action);
+	virtual void NewContents(bool keep) = 0;
+	virtual void UpdateLine(std::string_view line, Eaction action) = 0;
+	virtual void PublishContents() = 0;
+	virtual void DiscardContents() = 0;
+
+	// a database compiled by dbutil, for Mode = binary
+	virtual bool LoadContentImage();
+	virtual bool WriteContentImage(const std::string &path);
 
-	std::mutex        m_Mutex;
 	ERefreshType      m_Type;
 	unsigned          m_Refresh;
 	std::string       m_Path, m_Url;
-	std::time_t       m_LastLoadTime;
+
+	// what the URL was the last time it was read, so an unchanged one is skipped
+	SCurlValidators   m_Validators;
+	uint64_t          m_HttpHash;
+
+	// set by the file watcher when m_Path is written or replaced
+	std::atomic<bool> m_FileChanged;
+	int               m_WatchHandle;
+	std::mutex        m_WaitMutex;
+	std::condition_variable m_WaitCV;
 
 	std::atomic<bool> keep_running;
+	std::atomic<uint32_t> m_Generation;
 	std::future<void> m_Future;
 };
@@ -21,12 +21,27 @@
 #include <sys/socket.h>
 #include <netdb.h>
 
+#include "CsvLine.h"
 #include "Global.h"
 
-void CLookupDmr::ClearContents()
+void CLookupDmr::NewContents(bool keep)
 {
-	m_CallsignMap.clear();
-	m_DmridMap.clear();
+	auto current = std::atomic_load(&m_Contents);
+	m_Next = (keep && current) ? std::make_shared<SContents>(*current) : std::make_shared<SContents>();
+}
+
+void CLookupDmr::PublishContents()
+{
+	if (m_Next->Image)
+		std::cout << "DMR Id database size: " << m_Next->Image->Size() << " (compiled)" << std::endl;
+	else
+		std::cout << "DMR Id database size: " << m_Next->DmridMap.size() << std::endl;
+	std::atomic_store(&m_Contents, std::shared_ptr<const SContents>(std::move(m_Next)));
+}
+
+void CLookupDmr::DiscardContents()
+{
+	m_Next.reset();
 }
 
 void CLookupDmr::LoadParameters()
@@ -39,65 +54,82 @@ void CLookupDmr::LoadParameters()
 
 uint32_t CLookupDmr::FindDmrid(const UCallsign &ucs) const
 {
-	auto found = m_DmridMap.find(ucs);
-	if ( found != m_DmridMap.end() )
+	auto db = std::atomic_load(&m_Contents);
+	if ( db && db->Image )
 	{
-		return (found->second);
+		uint32_t id;
+		return db->Image->FindId(ucs, id) ? id : 0;
+	}
+	if ( db )
+	{
+		auto found = db->DmridMap.find(ucs);
+		if ( found != db->DmridMap.end() )
+		{
+			return (found->second);
+		}
 	}
 	return 0;
 }
 
-const UCallsign *CLookupDmr::FindCallsign(const uint32_t dmrid) const
+bool CLookupDmr::FindCallsign(const uint32_t dmrid, UCallsign &ucs) const
 {
-	auto found = m_CallsignMap.find(dmrid);
-	if ( found != m_CallsignMap.end() )
+	auto db = std::atomic_load(&m_Contents);
+	if ( db && db->Image )
+		return db->Image->FindCallsign(dmrid, ucs);
+	if ( db )
 	{
-		return &(found->second);
+		auto found = db->CallsignMap.find(dmrid);
+		if ( found != db->CallsignMap.end() )
+		{
+			ucs = found->second;
+			return true;
+		}
 	}
-	return nullptr;
+	return false;
 }
 
-void CLookupDmr::UpdateContent(std::stringstream &ss, Eaction action)
+void CLookupDmr::UpdateLine(std::string_view line, Eaction action)
 {
-	std::string line;
-	while (std::getline(ss, line))
+	bool failed = true;
+	CCsvLine csv(line, ';');
+	std::string_view id_str, cs_str;
+	unsigned long l;
+	if (csv.Next(id_str) && CCsvLine::Number(id_str, l) && 0UL < l && l <= 9999999UL)
 	{
-		bool failed = true;
-		auto l = atol(line.c_str()); // no throw guarantee
-		if (0L < l && l <= 9999999L)
+		auto id = uint32_t(l);
+		UCallsign key;
+		if (csv.Next(cs_str) && csv.More() && CCallsign::MakeKey(cs_str.data(), cs_str.size(), key))
 		{
-			auto id = uint32_t(l);
-			auto p1 = line.find(';');
-			if (std::string::npos != p1)
+			failed = false;
+			if (Eaction::normal == action)
 			{
-				auto p2 = line.find(';', ++p1);
-				if (std::string::npos != p2)
-				{
-					const auto cs_str(line.substr(p1, p2-p1));
-					CCallsign cs;
-					cs.SetCallsign(cs_str, false);
-					if (cs.IsValid())
-					{
-						failed = false;
-						if (Eaction::normal == action)
-						{
-							auto key = cs.GetKey();
-							m_DmridMap[key] = id;
-							m_CallsignMap[id] = key;
-						}
-						else if (Eaction::parse == action)
-						{
-							std::cout << id << ';' << cs_str << ";\n";
-						}
-					}
-				}
+				m_Next->DmridMap[key] = id;
+				m_Next->CallsignMap[id] = key;
+			}
+			else if (Eaction::parse == action)
+			{
+				std::cout << id << ';' << cs_str << ";\n";
 			}
 		}
-		if (Eaction::error_only == action && failed)
-		{
-			std::cout << line << '\n';
-		}
 	}
-	if (Eaction::normal == action)
-		std::cout << "DMR Id database size: " << m_DmridMap.size() << std::endl;
+	if (Eaction::error_only == action && failed)
+	{
+		std::cout << line << '\n';
+	}
+}
+
+bool CLookupDmr::LoadContentImage()
+{
+	auto image = std::make_shared<CIdImage>();
+	if (! image->Open(m_Path))
+		return false;
+	NewContents(false);
+	m_Next->Image = image;
+	PublishContents();
+	return true;
+}
+
+bool CLookupDmr::WriteContentImage(const std::string &path)
+{
+	return CIdImage::Write(path, m_Next->CallsignMap, m_Next->DmridMap);
 }
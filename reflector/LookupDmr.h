@@ -18,6 +18,7 @@
 
 #pragma once
 
+#include "IdImage.h"
 #include "Lookup.h"
 
 class CLookupDmr : public CLookup
@@ -25,14 +26,24 @@ class CLookupDmr : public CLookup
 public:
 	~CLookupDmr() {}
 	uint32_t FindDmrid(const UCallsign &ucs) const;
-	const UCallsign *FindCallsign(uint32_t dmrid) const;
+	bool FindCallsign(uint32_t dmrid, UCallsign &ucs) const;
 
 protected:
-	void ClearContents();
 	void LoadParameters();
-	void UpdateContent(std::stringstream &ss, Eaction action);
+	void NewContents(bool keep);
+	void UpdateLine(std::string_view line, Eaction action);
+	void PublishContents();
+	void DiscardContents();
+	bool LoadContentImage();
+	bool WriteContentImage(const std::string &path);
 
 private:
-	std::unordered_map<uint32_t, UCallsign> m_CallsignMap;
-	std::unordered_map<UCallsign, uint32_t, CCallsignHash, CCallsignEqual> m_DmridMap;
+	struct SContents
+	{
+		std::unordered_map<uint32_t, UCallsign> CallsignMap;
+		std::unordered_map<UCallsign, uint32_t, CCallsignHash, CCallsignEqual> DmridMap;
+		std::shared_ptr<const CIdImage> Image;	// Mode = binary, instead of the maps
+	};
+	std::shared_ptr<const SContents> m_Contents;	// only touched with std::atomic_load/store
+	std::shared_ptr<SContents> m_Next;
 };
@@ -21,12 +21,27 @@
 #include <sys/socket.h>
 #include <netdb.h>
 
+#include "CsvLine.h"
 #include "Global.h"
 
-void CLookupNxdn::ClearContents()
+void CLookupNxdn::NewContents(bool keep)
 {
-	m_CallsignMap.clear();
-	m_NxdnidMap.clear();
+	auto current = std::atomic_load(&m_Contents);
+	m_Next = (keep && current) ? std::make_shared<SContents>(*current) : std::make_shared<SContents>();
+}
+
+void CLookupNxdn::PublishContents()
+{
+	if (m_Next->Image)
+		std::cout << "NXDN Id database size: " << m_Next->Image->Size() << " (compiled)" << std::endl;
+	else
+		std::cout << "NXDN Id database size: " << m_Next->NxdnidMap.size() << std::endl;
+	std::atomic_store(&m_Contents, std::shared_ptr<const SContents>(std::move(m_Next)));
+}
+
+void CLookupNxdn::DiscardContents()
+{
+	m_Next.reset();
 }
 
 void CLookupNxdn::LoadParameters()
@@ -37,67 +52,84 @@ void CLookupNxdn::LoadParameters()
 	m_Url.assign(g_Configure.GetString(g_Keys.nxdniddb.url));
 }
 
-const UCallsign *CLookupNxdn::FindCallsign(uint16_t nxdnid) const
+bool CLookupNxdn::FindCallsign(uint16_t nxdnid, UCallsign &ucs) const
 {
-	auto found = m_CallsignMap.find(nxdnid);
-	if ( found != m_CallsignMap.end() )
+	auto db = std::atomic_load(&m_Contents);
+	if ( db && db->Image )
+		return db->Image->FindCallsign(nxdnid, ucs);
+	if ( db )
 	{
-		return &(found->second);
+		auto found = db->CallsignMap.find(nxdnid);
+		if ( found != db->CallsignMap.end() )
+		{
+			ucs = found->second;
+			return true;
+		}
 	}
-	return nullptr;
+	return false;
 }
 
 uint16_t CLookupNxdn::FindNXDNid(const UCallsign &ucs) const
 {
-	auto found = m_NxdnidMap.find(ucs);
-	if ( found != m_NxdnidMap.end() )
+	auto db = std::atomic_load(&m_Contents);
+	if ( db && db->Image )
+	{
+		uint32_t id;
+		return db->Image->FindId(ucs, id) ? uint16_t(id) : 0;
+	}
+	if ( db )
 	{
-		return found->second;
+		auto found = db->NxdnidMap.find(ucs);
+		if ( found != db->NxdnidMap.end() )
+		{
+			return found->second;
+		}
 	}
 	return 0;
 }
 
-void CLookupNxdn::UpdateContent(std::stringstream &ss, Eaction action)
+void CLookupNxdn::UpdateLine(std::string_view line, Eaction action)
 {
-	std::string line;
-	while (std::getline(ss, line))
+	bool failed = true;
+	CCsvLine csv(line, ',');
+	std::string_view id_str, cs_str;
+	unsigned long l;
+	if (csv.Next(id_str) && CCsvLine::Number(id_str, l) && 0UL < l && l < 0x10000UL)
 	{
-		bool failed = true;
-		auto l = atol(line.c_str()); // no throw guarantee
-		if (0 < l && l < 0x10000)
+		auto id = uint32_t(l);
+		UCallsign key;
+		if (csv.Next(cs_str) && csv.More() && CCallsign::MakeKey(cs_str.data(), cs_str.size(), key))
 		{
-			auto id = uint32_t(l);
-			auto p1 = line.find(',');
-			if (std::string::npos != p1)
+			failed = false;
+			if (Eaction::normal == action)
 			{
-				auto p2 = line.find(',', ++p1);
-				if (std::string::npos != p2)
-				{
-					const auto cs_str = line.substr(p1, p2-p1);
-					CCallsign cs;
-					cs.SetCallsign(cs_str, false);
-					if (cs.IsValid())
-					{
-						failed = false;
-						if (Eaction::normal == action)
-						{
-							auto key = cs.GetKey();
-							m_NxdnidMap[key] = id;
-							m_CallsignMap[id] = key;
-						}
-						else if (Eaction::parse == action)
-						{
-							std::cout << id << ',' << cs_str << ",\n";
-						}
-					}
-				}
+				m_Next->NxdnidMap[key] = id;
+				m_Next->CallsignMap[id] = key;
+			}
+			else if (Eaction::parse == action)
+			{
+				std::cout << id << ',' << cs_str << ",\n";
 			}
 		}
-		if (Eaction::error_only == action && failed)
-		{
-			std::cout << line << '\n';
-		}
 	}
-	if (Eaction::normal == action)
-		std::cout << "NXDN Id database size: " << m_NxdnidMap.size() << std::endl;
+	if (Eaction::error_only == action && failed)
+	{
+		std::cout << line << '\n';
+	}
+}
+
+bool CLookupNxdn::LoadContentImage()
+{
+	auto image = std::make_shared<CIdImage>();
+	if (! image->Open(m_Path))
+		return false;
+	NewContents(false);
+	m_Next->Image = image;
+	PublishContents();
+	return true;
+}
+
+bool CLookupNxdn::WriteContentImage(const std::string &path)
+{
+	return CIdImage::Write(path, m_Next->CallsignMap, m_Next->NxdnidMap);
 }
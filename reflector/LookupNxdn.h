@@ -18,19 +18,30 @@
 
 #pragma once
 
+#include "IdImage.h"
 #include "Lookup.h"
 
 class CLookupNxdn : public CLookup
 {
 public:
 	uint16_t FindNXDNid(const UCallsign &ucs) const;
-	const UCallsign *FindCallsign(const uint16_t id) const;
+	bool FindCallsign(const uint16_t id, UCallsign &ucs) const;
 protected:
-	void ClearContents();
 	void LoadParameters();
-	void UpdateContent(std::stringstream &ss, Eaction action);
+	void NewContents(bool keep);
+	void UpdateLine(std::string_view line, Eaction action);
+	void PublishContents();
+	void DiscardContents();
+	bool LoadContentImage();
+	bool WriteContentImage(const std::string &path);
 
 private:
-	std::unordered_map <uint32_t, UCallsign> m_CallsignMap;
-	std::unordered_map <UCallsign, uint32_t, CCallsignHash, CCallsignEqual> m_NxdnidMap;
+	struct SContents
+	{
+		std::unordered_map <uint32_t, UCallsign> CallsignMap;
+		std::unordered_map <UCallsign, uint32_t, CCallsignHash, CCallsignEqual> NxdnidMap;
+		std::shared_ptr<const CIdImage> Image;	// Mode = binary, instead of the maps
+	};
+	std::shared_ptr<const SContents> m_Contents;	// only touched with std::atomic_load/store
+	std::shared_ptr<SContents> m_Next;
 };
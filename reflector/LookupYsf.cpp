@@ -21,11 +21,24 @@
 #include <sys/socket.h>
 #include <netdb.h>
 
+#include "CsvLine.h"
 #include "Global.h"
 
-void CLookupYsf::ClearContents()
+void CLookupYsf::NewContents(bool keep)
 {
-	m_map.clear();
+	auto current = std::atomic_load(&m_map);
+	m_next = (keep && current) ? std::make_shared<CsNodeMap>(*current) : std::make_shared<CsNodeMap>();
+}
+
+void CLookupYsf::PublishContents()
+{
+	std::cout << "YSF frequency database size now is " << m_next->size() << std::endl;
+	std::atomic_store(&m_map, std::shared_ptr<const CsNodeMap>(std::move(m_next)));
+}
+
+void CLookupYsf::DiscardContents()
+{
+	m_next.reset();
 }
 
 void CLookupYsf::LoadParameters()
@@ -38,52 +51,45 @@ void CLookupYsf::LoadParameters()
 	m_DefaultRx = g_Configure.GetUnsigned(g_Keys.ysf.defaultrxfreq);
 }
 
-void CLookupYsf::UpdateContent(std::stringstream &ss, Eaction action)
+void CLookupYsf::UpdateLine(std::string_view line, Eaction action)
 {
-	std::string line;
-	while (std::getline(ss, line))
+	CCsvLine csv(line, ';');
+	std::string_view cs_str, tx_str, rx_str;
+	if (csv.Next(cs_str) && csv.Next(tx_str))
+		csv.Next(rx_str);
+	UCallsign key;
+	unsigned long long ltx = 0, lrx = 0;
+	CCsvLine::Number(tx_str, ltx);
+	CCsvLine::Number(rx_str, lrx);
+	if (ltx > 40000000 && ltx < 0x100000000 && lrx > 40000000 && lrx < 0x100000000 && CCallsign::MakeKey(cs_str.data(), cs_str.size(), key))
 	{
-		CCallsign cs;
-		std::string cs_str, tx_str, rx_str;
-		std::istringstream iss(line);
-		std::getline(iss, cs_str, ';');
-		std::getline(iss, tx_str, ';');
-		std::getline(iss, rx_str, ';');
-		cs.SetCallsign(cs_str, false);
-		auto ltx = atoll(tx_str.c_str());
-		auto lrx = atoll(rx_str.c_str());
-		unsigned x = sizeof(lrx);
-		if (ltx > 40000000 && ltx < 0x100000000 && lrx > 40000000 && lrx < 0x100000000 && cs.IsValid())
+		if (Eaction::parse == action)
 		{
-			if (Eaction::parse == action)
-			{
-				std::cout << cs_str << ';' << tx_str << ';' << rx_str << ";\n";
-			}
-			else if (Eaction::normal == action)
-			{
-				m_map[cs.GetKey()] = CYsfNode(ltx, lrx);
-			}
+			std::cout << cs_str << ';' << tx_str << ';' << rx_str << ";\n";
 		}
-		else if (Eaction::error_only == action)
+		else if (Eaction::normal == action)
 		{
-			std::cout << line << '\n';
+			(*m_next)[key] = CYsfNode(ltx, lrx);
 		}
 	}
-	if (Eaction::normal == action)
-		std::cout << "YSF frequency database size now is " << m_map.size() << std::endl;
+	else if (Eaction::error_only == action)
+	{
+		std::cout << line << '\n';
+	}
 }
 
 void CLookupYsf::FindFrequencies(const CCallsign &cs, uint32_t &txfreq, uint32_t &rxfreq)
 {
-	auto found = m_map.find(cs.GetKey());
-	if (found != m_map.end())
-	{
-		txfreq = found->second.GetTxFrequency();
-		rxfreq = found->second.GetRxFrequency();
-	}
-	else
+	txfreq = m_DefaultTx;
+	rxfreq = m_DefaultRx;
+	auto map = std::atomic_load(&m_map);
+	if (map)
 	{
-		txfreq = m_DefaultTx;
-		rxfreq = m_DefaultRx;
+		auto found = map->find(cs.GetKey());
+		if (found != map->end())
+		{
+			txfreq = found->second.GetTxFrequency();
+			rxfreq = found->second.GetRxFrequency();
+		}
 	}
 }
@@ -29,12 +29,15 @@ public:
 	void FindFrequencies(const CCallsign &, uint32_t &, uint32_t &);
 
 protected:
-	void ClearContents();
 	void LoadParameters();
-	void UpdateContent(std::stringstream &ss, Eaction action);
+	void NewContents(bool keep);
+	void UpdateLine(std::string_view line, Eaction action);
+	void PublishContents();
+	void DiscardContents();
 
 private:
-	CsNodeMap m_map;
+	std::shared_ptr<const CsNodeMap> m_map;	// only touched with std::atomic_load/store
+	std::shared_ptr<CsNodeMap> m_next;
 
 	unsigned m_DefaultTx, m_DefaultRx;
 };
@@ -26,8 +26,19 @@
 ////////////////////////////////////////////////////////////////////////////////////////
 // operation
 
+enum class EM17Packet : unsigned { unknown, dv, connect, disconnect, keepalive };
+
+static constexpr SPacketRoute M17Routes[] = {
+	{ EM17Packet::dv,         "voice",      sizeof(SM17Frame), sizeof(SM17Frame), "M17 ", true },
+	{ EM17Packet::keepalive,  "keepalive",  10, 10, "PONG" },
+	{ EM17Packet::connect,    "connect",    11, 11, "CONN" },
+	{ EM17Packet::disconnect, "disconnect", 10, 10, "DISC" },
+};
+
 bool CM17Protocol::Initialize(const char *type, const EProtocol ptype, const uint16_t port, const bool has_ipv4, const bool has_ipv6)
 {
+	m_Router.SetRoutes("M17", M17Routes);
+
 	// base class
 	if (! CProtocol::Initialize(type, ptype, port, has_ipv4, has_ipv6))
 		return false;
@@ -56,21 +67,30 @@ void CM17Protocol::Task(void)
 	// handle incoming packets
 #if M17_IPV6==true
 #if M17_IPV4==true
-	if ( ReceiveDS(Buffer, Ip, 20) )
+	const bool received = ReceiveDS(Buffer, Ip, ReceiveTimeout(20));
 #else
-	if ( Receive6(Buffer, Ip, 20) )
+	const bool received = Receive6(Buffer, Ip, ReceiveTimeout(20));
 #endif
 #else
-	if ( Receive4(Buffer, Ip, 20) )
+	const bool received = Receive4(Buffer, Ip, ReceiveTimeout(20));
 #endif
+	unsigned route;
+	if ( NextPacket(received, Buffer, Ip, route) )
 	{
 		// crack the packet
-		if ( IsValidDvPacket(Buffer, Header, Frame) )
+		const auto type = EM17Packet(route);
+		if ( EM17Packet::dv == type && IsValidDvPacket(Buffer, Ip, Header, Frame) )
 		{
 			// callsign muted?
-			if ( g_GateKeeper.MayTransmit(Header->GetMyCallsign(), Ip, EProtocol::m17, Header->GetRpt2Module()) )
+			bool ok;
+			if ( Header )
+				ok = g_GateKeeper.MayTransmit(Header->GetMyCallsign(), Ip, EProtocol::m17, Header->GetRpt2Module());
+			else
+				ok = MayTransmitOnStream(Frame->GetStreamId(), Ip, EProtocol::m17);
+			if ( ok )
 			{
-				OnDvHeaderPacketIn(Header, Ip);
+				if ( Header )
+					OnDvHeaderPacketIn(Header, Ip);
 
 				// xrf needs a voice frame every 20 ms and an M17 frame is 40 ms, so we need a duplicate
 				auto secondFrame = std::unique_ptr<CDvFramePacket>(new CDvFramePacket(*Frame.get()));
@@ -85,9 +105,9 @@ void CM17Protocol::Task(void)
 				OnDvFramePacketIn(secondFrame, &Ip); // push two packet because we need a packet every 20 ms
 			}
 		}
-		else if ( IsValidConnectPacket(Buffer, Callsign, ToLinkModule) )
+		else if ( EM17Packet::connect == type && IsValidConnectPacket(Buffer, Callsign, ToLinkModule) )
 		{
-			std::cout << "M17 connect packet for module " << ToLinkModule << " from " << Callsign << " at " << Ip << std::endl;
+			CLogLine(ELogLevel::info, "m17-connect") << "M17 connect packet for module " << ToLinkModule << " from " << Callsign << " at " << Ip;
 
 			// callsign authorized?
 			if ( g_GateKeeper.MayLink(Callsign, Ip, EProtocol::m17) && g_Reflector.IsValidModule(ToLinkModule) )
@@ -104,7 +124,7 @@ void CM17Protocol::Task(void)
 				}
 				else
 				{
-					std::cout << "M17 node " << Callsign << " connect attempt on non-existing module" << std::endl;
+					CLogLine(ELogLevel::warning, "m17-link-refused") << "M17 node " << Callsign << " connect attempt on non-existing module";
 
 					// deny the request
 					Send("NACK", Ip);
@@ -117,9 +137,9 @@ void CM17Protocol::Task(void)
 			}
 
 		}
-		else if ( IsValidDisconnectPacket(Buffer, Callsign) )
+		else if ( EM17Packet::disconnect == type && IsValidDisconnectPacket(Buffer, Callsign) )
 		{
-			std::cout << "M17 disconnect packet from " << Callsign << " at " << Ip << std::endl;
+			CLogLine(ELogLevel::info, "m17-disconnect") << "M17 disconnect packet from " << Callsign << " at " << Ip;
 
 			// find client
 			CClients *clients = g_Reflector.GetClients();
@@ -133,7 +153,7 @@ void CM17Protocol::Task(void)
 			}
 			g_Reflector.ReleaseClients();
 		}
-		else if ( IsValidKeepAlivePacket(Buffer, Callsign) )
+		else if ( EM17Packet::keepalive == type && IsValidKeepAlivePacket(Buffer, Callsign) )
 		{
 			// find all clients with that callsign & ip and keep them alive
 			CClients *clients = g_Reflector.GetClients();
@@ -150,7 +170,7 @@ void CM17Protocol::Task(void)
 			// invalid packet
 			std::string title("Unknown M17 packet from ");
 			title += Ip.GetAddress();
-			Buffer.Dump(title);
+			Dump(title.c_str(), Buffer.data(), Buffer.size());
 		}
 	}
 
@@ -302,7 +322,7 @@ void CM17Protocol::HandleKeepalives(void)
 			Send("DISC", client->GetIp());
 
 			// remove it
-			std::cout << "M17 client " << client->GetCallsign() << " keepalive timeout" << std::endl;
+			CLogLine(ELogLevel::info, "m17-keepalive-timeout") << "M17 client " << client->GetCallsign() << " keepalive timeout";
 			clients->RemoveClient(client);
 		}
 
@@ -313,7 +333,7 @@ void CM17Protocol::HandleKeepalives(void)
 ////////////////////////////////////////////////////////////////////////////////////////
 // packet decoding helpers
 
-bool CM17Protocol::IsValidConnectPacket(const CBuffer &Buffer, CCallsign &callsign, char &mod)
+bool CM17Protocol::IsValidConnectPacket(const CBufferView &Buffer, CCallsign &callsign, char &mod)
 {
 	uint8_t tag[] = { 'C', 'O', 'N', 'N' };
 	bool valid = false;
@@ -326,7 +346,7 @@ bool CM17Protocol::IsValidConnectPacket(const CBuffer &Buffer, CCallsign &callsi
 	return valid;
 }
 
-bool CM17Protocol::IsValidDisconnectPacket(const CBuffer &Buffer, CCallsign &callsign)
+bool CM17Protocol::IsValidDisconnectPacket(const CBufferView &Buffer, CCallsign &callsign)
 {
 	uint8_t tag[] = { 'D', 'I', 'S', 'C' };
 	bool valid = false;
@@ -338,7 +358,7 @@ bool CM17Protocol::IsValidDisconnectPacket(const CBuffer &Buffer, CCallsign &cal
 	return valid;
 }
 
-bool CM17Protocol::IsValidKeepAlivePacket(const CBuffer &Buffer, CCallsign &callsign)
+bool CM17Protocol::IsValidKeepAlivePacket(const CBufferView &Buffer, CCallsign &callsign)
 {
 	uint8_t tag[] = { 'P', 'O', 'N', 'G' };
 	bool valid = false;
@@ -350,7 +370,9 @@ bool CM17Protocol::IsValidKeepAlivePacket(const CBuffer &Buffer, CCallsign &call
 	return valid;
 }
 
-bool CM17Protocol::IsValidDvPacket(const CBuffer &Buffer, std::unique_ptr<CDvHeaderPacket> &header, std::unique_ptr<CDvFramePacket> &frame)
+// every M17 packet carries the stream's header, it's only decoded
+// if the packet doesn't belong to a stream that is already open
+bool CM17Protocol::IsValidDvPacket(const CBufferView &Buffer, const CIp &Ip, std::unique_ptr<CDvHeaderPacket> &header, std::unique_ptr<CDvFramePacket> &frame)
 {
 	uint8_t tag[] = { 'M', '1', '7', ' ' };
 
@@ -363,14 +385,23 @@ bool CM17Protocol::IsValidDvPacket(const CBuffer &Buffer, std::unique_ptr<CDvHea
 	{
 		// Make the M17 header
 		CM17Packet m17(Buffer.data());
-		// get the header
-		header = std::unique_ptr<CDvHeaderPacket>(new CDvHeaderPacket(m17));
 
 		// get the frame
 		frame = std::unique_ptr<CDvFramePacket>(new CDvFramePacket(m17));
+		if ( ! frame->IsValid() )
+			return false;
+
+		if ( GetStream(frame->GetStreamId(), &Ip) )
+		{
+			header.reset();
+			return true;
+		}
+
+		// get the header
+		header = std::unique_ptr<CDvHeaderPacket>(new CDvHeaderPacket(m17));
 
 		// check validity of packets
-		if ( header && header->IsValid() && frame && frame->IsValid() )
+		if ( header->IsValid() )
 			return true;
 	}
 	return false;
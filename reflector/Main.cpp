@@ -24,6 +24,7 @@
 ////////////////////////////////////////////////////////////////////////////////////////
 // global objects
 
+CLog        g_Log;		// first, so it's the last to go
 SJsonKeys   g_Keys;
 CReflector  g_Reflector;
 CGateKeeper g_GateKeeper;
@@ -33,6 +34,7 @@ CLookupDmr  g_LDid;
 CLookupNxdn g_LNid;
 CLookupYsf  g_LYtr;
 CTCServer   g_TCServer;
+CFileWatcher g_FileWatcher;
 
 ////////////////////////////////////////////////////////////////////////////////////////
 
@@ -57,6 +59,11 @@ int main(int argc, char *argv[])
 	std::cout << "Starting " << callsign << " " << g_Version << std::endl;
 
 	// and let it run
+#ifdef DEBUG
+	g_Log.Start(ELogLevel::debug);
+#else
+	g_Log.Start();
+#endif
 	if (g_Reflector.Start())
 	{
 		std::cout << "Error starting reflector" << std::endl;
@@ -73,6 +80,7 @@ int main(int argc, char *argv[])
 	pause(); // wait for any signal
 
 	g_Reflector.Stop();
+	g_Log.Stop();
 	std::cout << "Reflector stopped" << std::endl;
 
 	// done
@@ -89,10 +97,11 @@ CConfigure  g_Configure;
 CLookupDmr  g_LDid;
 CLookupNxdn g_LNid;
 CLookupYsf  g_LYtr;
+CFileWatcher g_FileWatcher;
 
 static void usage(std::ostream &os, const char *name)
 {
-	os << "\nUsage: " << name << " DATABASE SOURCE ACTION INIFILE\n";
+	os << "\nUsage: " << name << " DATABASE SOURCE ACTION INIFILE [OUTFILE]\n";
 	os << "DATABASE (choose one)\n"
 		"    dmr   : The  DmrId <==> Callsign databases.\n"
 		"    nxdn  : The NxdnId <==> Callsign databases.\n"
@@ -103,7 +112,9 @@ static void usage(std::ostream &os, const char *name)
 		"ACTION (choose one)\n"
 		"    print : Print all lines from the SOURCE that are syntactically correct.\n"
 		"    error : Print only the lines with failed syntax.\n"
-		"INIFILE   : an error-free urfd ini file (check it first with inicheck).\n\n"
+		"    compile : Compile the SOURCE to OUTFILE for Mode = binary (dmr and nxdn only).\n"
+		"INIFILE   : an error-free urfd ini file (check it first with inicheck).\n"
+		"OUTFILE   : for compile, the default is the FilePath ini parameter.\n\n"
 		"Only the first character of DATABASE, SOURCE and ACTION is read.\n"
         "Example: " << name << " y f e urfd.ini  # Check your YSF Tx/Rx database file specified in urfd.ini for syntax errors.\n\n";
 }
@@ -115,8 +126,9 @@ int main(int argc, char *argv[])
 	Edb db;
 	Eaction action;
 	Esource source;
+	bool compile = false;
 
-	if (5 != argc)
+	if (5 != argc && 6 != argc)
 	{
 		usage(std::cerr, argv[0]);
 		return EXIT_FAILURE;
@@ -174,12 +186,24 @@ int main(int argc, char *argv[])
 		action = Eaction::error_only;
 		break;
 
+		case 'c':
+		case 'C':
+		action = Eaction::normal;
+		compile = true;
+		break;
+
 		default:
 		std::cerr << "Unrecognized ACTION: " << argv[3] << std::endl;
 		db = Edb::none;
 		break;
 	}
 
+	if (6 == argc && ! compile)
+	{
+		std::cerr << "OUTFILE is only for compile" << std::endl;
+		db = Edb::none;
+	}
+
 	if (db == Edb::none)
 	{
 		usage(std::cerr, argv[0]);
@@ -189,6 +213,39 @@ int main(int argc, char *argv[])
 	if (g_Configure.ReadData(argv[4]))
 		return EXIT_FAILURE;
 
+	if (compile)
+	{
+		std::string outfile;
+		if (6 == argc)
+			outfile.assign(argv[5]);
+		else if (Edb::dmr == db)
+			outfile.assign(g_Configure.GetString(g_Keys.dmriddb.filepath));
+		else if (Edb::nxdn == db)
+			outfile.assign(g_Configure.GetString(g_Keys.nxdniddb.filepath));
+		if (outfile.empty())
+		{
+			std::cerr << "There is no OUTFILE to compile to" << std::endl;
+			return EXIT_FAILURE;
+		}
+
+		bool ok = false;
+		switch (db)
+		{
+			case Edb::dmr:
+			ok = g_LDid.Compile(source, outfile);
+			break;
+
+			case Edb::nxdn:
+			ok = g_LNid.Compile(source, outfile);
+			break;
+
+			default:
+			ok = g_LYtr.Compile(source, outfile);
+			break;
+		}
+		return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+	}
+
 	switch (db)
 	{
 		case Edb::dmr:
@@ -22,7 +22,7 @@
 #include "NXDNClient.h"
 #include "NXDNProtocol.h"
 #include "YSFDefines.h"
-#include "Golay24128.h"
+#include "DMRAmbe.h"
 #include "Global.h"
 
 const uint8_t NXDN_LICH_RFCT_RDCH			= 2U;
@@ -127,7 +127,7 @@ void CNXDNProtocol::Task(void)
 				// client already connected ?
 				if ( client == nullptr )
 				{
-					std::cout << "NXDN connect packet from " << Callsign << " at " << Ip << std::endl;
+					CLogLine(ELogLevel::info, "nxdn-connect") << "NXDN connect packet from " << Callsign << " at " << Ip;
 
 					// create the client
 					auto newclient = std::make_shared<CNXDNClient>(Callsign, Ip);
@@ -152,7 +152,7 @@ void CNXDNProtocol::Task(void)
 		}
 		else if ( IsValidDisconnectPacket(Buffer) )
 		{
-			std::cout << "NXDN disconnect packet from " << Ip << std::endl;
+			CLogLine(ELogLevel::info, "nxdn-disconnect") << "NXDN disconnect packet from " << Ip;
 
 			// find client
 			CClients *clients = g_Reflector.GetClients();
@@ -169,7 +169,7 @@ void CNXDNProtocol::Task(void)
 #ifdef DEBUG
 			std::string title("Unknown NXDN packet from ");
 			title += Ip.GetAddress();
-			Buffer.Dump(title);
+			Dump(title.c_str(), Buffer.data(), Buffer.size());
 #endif
 		}
 	}
@@ -336,7 +336,7 @@ void CNXDNProtocol::HandleKeepalives(void)
 		else if ( !client->IsAlive() )
 		{
 			// no, remove it
-			std::cout << "NXDN client " << client->GetCallsign() << " keepalive timeout" << std::endl;
+			CLogLine(ELogLevel::info, "nxdn-keepalive-timeout") << "NXDN client " << client->GetCallsign() << " keepalive timeout";
 			clients->RemoveClient(client);
 		}
 
@@ -347,7 +347,7 @@ void CNXDNProtocol::HandleKeepalives(void)
 ////////////////////////////////////////////////////////////////////////////////////////
 // DV packet decoding helpers
 
-bool CNXDNProtocol::IsValidConnectPacket(const CBuffer &Buffer, CCallsign *callsign)
+bool CNXDNProtocol::IsValidConnectPacket(const CBufferView &Buffer, CCallsign *callsign)
 {
 	uint8_t tag[] = { 'N','X','D','N','P' };
 
@@ -361,7 +361,7 @@ bool CNXDNProtocol::IsValidConnectPacket(const CBuffer &Buffer, CCallsign *calls
 	return valid;
 }
 
-bool CNXDNProtocol::IsValidDisconnectPacket(const CBuffer &Buffer)
+bool CNXDNProtocol::IsValidDisconnectPacket(const CBufferView &Buffer)
 {
 	uint8_t tag[] = { 'N','X','D','N','U' };
 
@@ -372,7 +372,7 @@ bool CNXDNProtocol::IsValidDisconnectPacket(const CBuffer &Buffer)
 	return false;
 }
 
-bool CNXDNProtocol::IsValidDvHeaderPacket(const CIp &Ip, const CBuffer &Buffer, std::unique_ptr<CDvHeaderPacket> &header)
+bool CNXDNProtocol::IsValidDvHeaderPacket(const CIp &Ip, const CBufferView &Buffer, std::unique_ptr<CDvHeaderPacket> &header)
 {
 	if(!memcmp(Buffer.data(), "NXDND", 5) && (Buffer.size() == 43) && (Buffer.data()[10] == NXDN_LICH_USC_SACCH_NS) && (Buffer.data()[9] == 1) )
 	{
@@ -393,7 +393,7 @@ bool CNXDNProtocol::IsValidDvHeaderPacket(const CIp &Ip, const CBuffer &Buffer,
 	return false;
 }
 
-bool CNXDNProtocol::IsValidDvFramePacket(const CIp &Ip, const CBuffer &Buffer, std::unique_ptr<CDvHeaderPacket> &header, std::array<std::unique_ptr<CDvFramePacket>, 4> &frames)
+bool CNXDNProtocol::IsValidDvFramePacket(const CIp &Ip, const CBufferView &Buffer, std::unique_ptr<CDvHeaderPacket> &header, std::array<std::unique_ptr<CDvFramePacket>, 4> &frames)
 {
 	if(!memcmp(Buffer.data(), "NXDND", 5) && (Buffer.size() == 43) && (Buffer.data()[10] != NXDN_LICH_USC_SACCH_NS) )
 	{
@@ -463,7 +463,7 @@ bool CNXDNProtocol::IsValidDvFramePacket(const CIp &Ip, const CBuffer &Buffer, s
 	return false;
 }
 
-bool CNXDNProtocol::IsValidDvLastFramePacket(const CIp &Ip, const CBuffer &Buffer)
+bool CNXDNProtocol::IsValidDvLastFramePacket(const CIp &Ip, const CBufferView &Buffer)
 {
 	if(!memcmp(Buffer.data(), "NXDND", 5) && (Buffer.size() == 43) && (Buffer.data()[10] == NXDN_LICH_USC_SACCH_NS) && ((Buffer.data()[9U] & 0x08) == 0x08) )
 	{
@@ -610,100 +610,28 @@ bool CNXDNProtocol::EncodeNXDNPacket(const CDvHeaderPacket &Header, uint32_t seq
 
 void CNXDNProtocol::decode(const unsigned char* in, unsigned char* out) const
 {
-	unsigned int a = 0U;
-	unsigned int MASK = 0x800000U;
-	for (unsigned int i = 0U; i < 24U; i++, MASK >>= 1) {
-		unsigned int aPos = DMR_A_TABLE[i];
-		if (READ_BIT(in, aPos))
-			a |= MASK;
-	}
-
-	unsigned int b = 0U;
-	MASK = 0x400000U;
-	for (unsigned int i = 0U; i < 23U; i++, MASK >>= 1) {
-		unsigned int bPos = DMR_B_TABLE[i];
-		if (READ_BIT(in, bPos))
-			b |= MASK;
-	}
-
-	unsigned int c = 0U;
-	MASK = 0x1000000U;
-	for (unsigned int i = 0U; i < 25U; i++, MASK >>= 1) {
-		unsigned int cPos = DMR_C_TABLE[i];
-		if (READ_BIT(in, cPos))
-			c |= MASK;
-	}
-
-	a >>= 12;
+	unsigned int a, b, c;
+	CDmrAmbe::Decode(in, a, b, c);
 
-	// The PRNG
-	b ^= (PRNG_TABLE[a] >> 1);
-	b >>= 11;
-
-	MASK = 0x000800U;
-	for (unsigned int i = 0U; i < 12U; i++, MASK >>= 1) {
-		unsigned int aPos = i + 0U;
-		unsigned int bPos = i + 12U;
-		WRITE_BIT(out, aPos, a & MASK);
-		WRITE_BIT(out, bPos, b & MASK);
-	}
-
-	MASK = 0x1000000U;
-	for (unsigned int i = 0U; i < 25U; i++, MASK >>= 1) {
-		unsigned int cPos = i + 24U;
-		WRITE_BIT(out, cPos, c & MASK);
-	}
+	// 49 bits, a, b and then c, most significant first, in all 7 bytes of out, so the
+	// last 7 bits are zero, as they were when the caller's memset() left them alone
+	const uint64_t v = ((uint64_t(a) << 37) | (uint64_t(b) << 25) | uint64_t(c)) << 15;
+	for (unsigned int i = 0U; i < 7U; i++)
+		out[i] = (unsigned char)(v >> (56U - 8U * i));
 }
 
 void CNXDNProtocol::encode(const unsigned char* in, unsigned char* out) const
 {
+	uint64_t v = 0U;
+	for (unsigned int i = 0U; i < 7U; i++)
+		v = (v << 8) | in[i];
+	v >>= 7;
 
-	unsigned int aOrig = 0U;
-	unsigned int bOrig = 0U;
-	unsigned int cOrig = 0U;
-
-	unsigned int MASK = 0x000800U;
-	for (unsigned int i = 0U; i < 12U; i++, MASK >>= 1) {
-		unsigned int n1 = i + 0U;
-		unsigned int n2 = i + 12U;
-		if (READ_BIT(in, n1))
-			aOrig |= MASK;
-		if (READ_BIT(in, n2))
-			bOrig |= MASK;
-	}
-
-	MASK = 0x1000000U;
-	for (unsigned int i = 0U; i < 25U; i++, MASK >>= 1) {
-		unsigned int n = i + 24U;
-		if (READ_BIT(in, n))
-			cOrig |= MASK;
-	}
-
-	unsigned int a = CGolay24128::encode24128(aOrig);
-
-	// The PRNG
-	unsigned int p = PRNG_TABLE[aOrig] >> 1;
-
-	unsigned int b = CGolay24128::encode23127(bOrig) >> 1;
-	b ^= p;
+	const unsigned int aOrig = (v >> 37) & 0xFFFU;
+	const unsigned int bOrig = (v >> 25) & 0xFFFU;
+	const unsigned int cOrig = v & 0x1FFFFFFU;
 
-	MASK = 0x800000U;
-	for (unsigned int i = 0U; i < 24U; i++, MASK >>= 1) {
-		unsigned int aPos = DMR_A_TABLE[i];
-		WRITE_BIT(out, aPos, a & MASK);
-	}
-
-	MASK = 0x400000U;
-	for (unsigned int i = 0U; i < 23U; i++, MASK >>= 1) {
-		unsigned int bPos = DMR_B_TABLE[i];
-		WRITE_BIT(out, bPos, b & MASK);
-	}
-
-	MASK = 0x1000000U;
-	for (unsigned int i = 0U; i < 25U; i++, MASK >>= 1) {
-		unsigned int cPos = DMR_C_TABLE[i];
-		WRITE_BIT(out, cPos, cOrig & MASK);
-	}
+	CDmrAmbe::Encode(aOrig, bOrig, cOrig, out);
 }
 
 uint8_t CNXDNProtocol::get_lich_fct(uint8_t lich)
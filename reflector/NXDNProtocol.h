@@ -68,11 +68,11 @@ protected:
 	void OnDvHeaderPacketIn(std::unique_ptr<CDvHeaderPacket> &, const CIp &);
 
 	// DV packet decoding helpers
-	bool IsValidConnectPacket(const CBuffer &, CCallsign *);
-	bool IsValidDisconnectPacket(const CBuffer &);
-	bool IsValidDvHeaderPacket(const CIp &, const CBuffer &, std::unique_ptr<CDvHeaderPacket> &);
-	bool IsValidDvFramePacket(const CIp &, const CBuffer &, std::unique_ptr<CDvHeaderPacket> &, std::array<std::unique_ptr<CDvFramePacket>, 4> &);
-	bool IsValidDvLastFramePacket(const CIp &, const CBuffer &);
+	bool IsValidConnectPacket(const CBufferView &, CCallsign *);
+	bool IsValidDisconnectPacket(const CBufferView &);
+	bool IsValidDvHeaderPacket(const CIp &, const CBufferView &, std::unique_ptr<CDvHeaderPacket> &);
+	bool IsValidDvFramePacket(const CIp &, const CBufferView &, std::unique_ptr<CDvHeaderPacket> &, std::array<std::unique_ptr<CDvFramePacket>, 4> &);
+	bool IsValidDvLastFramePacket(const CIp &, const CBufferView &);
 
 	// DV packet encoding helpers
 	bool EncodeNXDNHeaderPacket(const CDvHeaderPacket &, CBuffer &, bool islast = false);
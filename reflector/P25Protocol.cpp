@@ -116,7 +116,7 @@ void CP25Protocol::Task(void)
 				// client already connected ?
 				if ( client == nullptr )
 				{
-					std::cout << "P25 connect packet from " << Callsign << " at " << Ip << std::endl;
+					CLogLine(ELogLevel::info, "p25-connect") << "P25 connect packet from " << Callsign << " at " << Ip;
 
 					// create the client
 					auto newclient = std::make_shared<CP25Client>(Callsign, Ip);
@@ -141,7 +141,7 @@ void CP25Protocol::Task(void)
 		}
 		else if ( IsValidDisconnectPacket(Buffer, &Callsign) )
 		{
-			std::cout << "P25 disconnect packet from " << Callsign << " at " << Ip << std::endl;
+			CLogLine(ELogLevel::info, "p25-disconnect") << "P25 disconnect packet from " << Callsign << " at " << Ip;
 
 			// find client
 			CClients *clients = g_Reflector.GetClients();
@@ -158,7 +158,7 @@ void CP25Protocol::Task(void)
 			// invalid packet
 			std::string title("Unknown P25 packet from ");
 			title += Ip.GetAddress();
-			Buffer.Dump(title);
+			Dump(title.c_str(), Buffer.data(), Buffer.size());
 		}
 	}
 
@@ -281,7 +281,7 @@ void CP25Protocol::HandleQueue(void)
 ////////////////////////////////////////////////////////////////////////////////////////
 // packet decoding helpers
 
-bool CP25Protocol::IsValidConnectPacket(const CBuffer &Buffer, CCallsign *callsign)
+bool CP25Protocol::IsValidConnectPacket(const CBufferView &Buffer, CCallsign *callsign)
 {
 	bool valid = false;
 	if ( (Buffer.size() == 11) && (Buffer.data()[0] == 0xF0) )
@@ -292,7 +292,7 @@ bool CP25Protocol::IsValidConnectPacket(const CBuffer &Buffer, CCallsign *callsi
 	return valid;
 }
 
-bool CP25Protocol::IsValidDisconnectPacket(const CBuffer &Buffer, CCallsign *callsign)
+bool CP25Protocol::IsValidDisconnectPacket(const CBufferView &Buffer, CCallsign *callsign)
 {
 	bool valid = false;
 	if ( (Buffer.size() == 11) && (Buffer.data()[0] == 0xF1) )
@@ -303,7 +303,7 @@ bool CP25Protocol::IsValidDisconnectPacket(const CBuffer &Buffer, CCallsign *cal
 	return valid;
 }
 
-bool CP25Protocol::IsValidDvPacket(const CIp &Ip, const CBuffer &Buffer, std::unique_ptr<CDvFramePacket> &frame)
+bool CP25Protocol::IsValidDvPacket(const CIp &Ip, const CBufferView &Buffer, std::unique_ptr<CDvFramePacket> &frame)
 {
 	if ( (Buffer.size() >= 14) )
 	{
@@ -365,7 +365,7 @@ bool CP25Protocol::IsValidDvPacket(const CIp &Ip, const CBuffer &Buffer, std::un
 	return false;
 }
 
-bool CP25Protocol::IsValidDvHeaderPacket(const CIp &Ip, const CBuffer &Buffer, std::unique_ptr<CDvHeaderPacket> &header)
+bool CP25Protocol::IsValidDvHeaderPacket(const CIp &Ip, const CBufferView &Buffer, std::unique_ptr<CDvHeaderPacket> &header)
 {
 	if(Buffer.data()[0] == 0x66){
 		auto stream = GetStream(m_uiStreamId, &Ip);
@@ -521,7 +521,7 @@ void CP25Protocol::HandleKeepalives(void)
 		else if ( !client->IsAlive() )
 		{
 			// no, remove it
-			std::cout << "P25 client " << client->GetCallsign() << " keepalive timeout" << std::endl;
+			CLogLine(ELogLevel::info, "p25-keepalive-timeout") << "P25 client " << client->GetCallsign() << " keepalive timeout";
 			clients->RemoveClient(client);
 		}
 
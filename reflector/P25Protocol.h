@@ -59,10 +59,10 @@ protected:
 	void OnDvHeaderPacketIn(std::unique_ptr<CDvHeaderPacket> &, const CIp &);
 
 	// packet decoding helpers
-	bool IsValidConnectPacket(const CBuffer &, CCallsign *);
-	bool IsValidDisconnectPacket(const CBuffer &, CCallsign *);
-	bool IsValidDvPacket(const CIp &, const CBuffer &, std::unique_ptr<CDvFramePacket> &);
-	bool IsValidDvHeaderPacket(const CIp &, const CBuffer &, std::unique_ptr<CDvHeaderPacket> &);
+	bool IsValidConnectPacket(const CBufferView &, CCallsign *);
+	bool IsValidDisconnectPacket(const CBufferView &, CCallsign *);
+	bool IsValidDvPacket(const CIp &, const CBufferView &, std::unique_ptr<CDvFramePacket> &);
+	bool IsValidDvHeaderPacket(const CIp &, const CBufferView &, std::unique_ptr<CDvHeaderPacket> &);
 
 	// packet encoding helpers
 	void EncodeP25Packet(const CDvHeaderPacket &, const CDvFramePacket &, uint32_t, CBuffer &Buffer, bool) const;
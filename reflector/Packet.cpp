@@ -38,7 +38,7 @@ CPacket::CPacket()
 };
 
 // for the network
-CPacket::CPacket(const CBuffer &buf)
+CPacket::CPacket(const CBufferView &buf)
 {
 	if (buf.size() > 19)
 	{
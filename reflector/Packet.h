@@ -31,7 +31,7 @@ class CPacket
 public:
 	// constructor
 	CPacket();
-	CPacket(const CBuffer &Buffer);
+	CPacket(const CBufferView &Buffer);
 	CPacket(uint16_t sid, uint8_t dstarpid);
 	CPacket(uint16_t sid, uint8_t dmrpid, uint8_t dmrsubpid, bool lastpacket);
 	CPacket(uint16_t sid, uint8_t pid, bool lastpacket);
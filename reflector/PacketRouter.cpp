@@ -0,0 +1,151 @@
+// urfd -- The universal reflector
+// Copyright © 2024 Thomas A. Early N7TAE
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include <iostream>
+
+#include "PacketRouter.h"
+
+////////////////////////////////////////////////////////////////////////////////////////
+// set
+
+void CPacketRouter::SetRoutes(const char *protocol, const SPacketRoute *routes, unsigned count)
+{
+	m_protocol.assign(protocol);
+	m_routes = routes;
+	m_count = count;
+	for (unsigned t = 0; t < PACKET_TYPES_MAX; t++)
+	{
+		m_names[t] = nullptr;
+		m_stream[t] = false;
+		m_hits[t].store(0, std::memory_order_relaxed);
+	}
+	m_names[0] = "unknown";
+	for (unsigned i = 0; i < count; i++)
+	{
+		if (routes[i].type < PACKET_TYPES_MAX)
+		{
+			m_names[routes[i].type] = routes[i].name;
+			m_stream[routes[i].type] = routes[i].stream;
+		}
+		else
+			std::cerr << "The " << protocol << " packet type '" << routes[i].name << "' is out of range" << std::endl;
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////
+// operation
+
+unsigned CPacketRouter::Route(const CBufferView &Buffer)
+{
+	const unsigned len = Buffer.size();
+
+	// the first four bytes, most significant first, just like SPacketRoute::magic
+	uint32_t word = 0;
+	for (unsigned i = 0; i < 4; i++)
+		word = (word << 8) | ((i < len) ? Buffer[i] : 0u);
+
+	unsigned type = 0;
+	for (unsigned i = 0; i < m_count; i++)
+	{
+		const SPacketRoute &r = m_routes[i];
+		if (len >= r.minlen && len <= r.maxlen && (word & r.mask) == r.magic)
+		{
+			type = r.type;
+			break;
+		}
+	}
+
+	// there is only one writer, so there's no need for a locked add
+	if (type < PACKET_TYPES_MAX)
+		m_hits[type].store(m_hits[type].load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+	return type;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////
+// socket filter
+
+// A UDP socket filter sees the 8 byte UDP header ahead of the payload, and its length
+// includes it. Each route is tested in turn: a length window, then up to four bytes of
+// magic. A match accepts the datagram, anything else falls through to the final drop.
+bool CPacketRouter::CompileFilter(std::vector<struct sock_filter> &program) const
+{
+	const unsigned hdr = 8;
+	program.clear();
+	for (unsigned i = 0; i < m_count; i++)
+	{
+		const SPacketRoute &r = m_routes[i];
+		unsigned n = 0;	// magic bytes
+		while (n < 4 && (r.mask & (0xff000000u >> (8 * n))))
+			n++;
+
+		// the block for this route, its jumps are filled in below
+		std::vector<struct sock_filter> b;
+		b.push_back(BPF_STMT(BPF_LD | BPF_W | BPF_LEN, 0));
+		b.push_back(BPF_JUMP(BPF_JMP | BPF_JGE | BPF_K, r.minlen + hdr, 0, 0));
+		if (r.maxlen < 0xffffffffu - hdr)
+			b.push_back(BPF_JUMP(BPF_JMP | BPF_JGT | BPF_K, r.maxlen + hdr, 0, 0));
+		switch (n)
+		{
+		case 0:
+			break;
+		case 1:
+			b.push_back(BPF_STMT(BPF_LD | BPF_B | BPF_ABS, hdr));
+			b.push_back(BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, r.magic >> 24, 0, 0));
+			break;
+		case 2:
+			b.push_back(BPF_STMT(BPF_LD | BPF_H | BPF_ABS, hdr));
+			b.push_back(BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, r.magic >> 16, 0, 0));
+			break;
+		default:
+			b.push_back(BPF_STMT(BPF_LD | BPF_W | BPF_ABS, hdr));
+			if (3 == n)
+				b.push_back(BPF_STMT(BPF_ALU | BPF_AND | BPF_K, r.mask));
+			b.push_back(BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, r.magic, 0, 0));
+			break;
+		}
+		b.push_back(BPF_STMT(BPF_RET | BPF_K, 0xffffffffu));
+
+		// every failed test skips to the next route, the last test's success falls into the accept
+		const unsigned size = b.size();
+		for (unsigned j = 0; j < size; j++)
+		{
+			if (BPF_JMP == BPF_CLASS(b[j].code))
+			{
+				const unsigned skip = size - j - 1;	// to the first instruction after this block
+				if (BPF_JGT == BPF_OP(b[j].code))
+					b[j].jt = skip;	// too long
+				else
+					b[j].jf = skip;
+			}
+		}
+		program.insert(program.end(), b.begin(), b.end());
+	}
+	program.push_back(BPF_STMT(BPF_RET | BPF_K, 0));
+
+	// the jumps are all within a route's block, but the kernel limits the length
+	return program.size() <= BPF_MAXINSNS;
+}
+
+void CPacketRouter::Report(std::ostream &os) const
+{
+	os << m_protocol << " packets received:";
+	for (unsigned t = 0; t < PACKET_TYPES_MAX; t++)
+	{
+		if (m_names[t] && (t > 0 || GetHits(0)))
+			os << ' ' << m_names[t] << ' ' << GetHits(t);
+	}
+	os << std::endl;
+}
@@ -0,0 +1,105 @@
+// urfd -- The universal reflector
+// Copyright © 2024 Thomas A. Early N7TAE
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+#include <linux/filter.h>
+
+#include "Buffer.h"
+
+// the most packet types of one protocol, including unknown
+#define PACKET_TYPES_MAX    16
+
+////////////////////////////////////////////////////////////////////////////////////////
+// a packet type of a protocol, known by its length and up to four leading magic bytes.
+// Tables of these are constexpr, so the magic is packed at compile time.
+// Stream packets, the voice, take the fast lane; everything else is control traffic.
+
+struct SPacketRoute
+{
+	template <typename T>
+	constexpr SPacketRoute(T t, const char *n, unsigned min, unsigned max, const char *m = "", bool s = false)
+		: type(unsigned(t)), name(n), minlen(min), maxlen(max), magic(Pack(m)), mask(Mask(m)), stream(s) {}
+
+	unsigned    type;    // the protocol's packet type, 0 is reserved for unknown
+	const char *name;
+	unsigned    minlen, maxlen;
+	uint32_t    magic, mask;
+	bool        stream;
+
+private:
+	static constexpr uint32_t Pack(const char *m)
+	{
+		uint32_t w = 0;
+		for (unsigned i = 0; i < 4; i++)
+			w = (w << 8) | (m[0] ? uint8_t(*m++) : 0u);
+		return w;
+	}
+	static constexpr uint32_t Mask(const char *m)
+	{
+		uint32_t w = 0;
+		for (unsigned i = 0; i < 4; i++)
+			w = (w << 8) | (m[0] ? (m++, 0xffu) : 0u);
+		return w;
+	}
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
+// Sends a datagram straight to the one parser that can take it, instead of trying
+// every parser in turn, and counts the packets of each type. Only the protocol's
+// thread calls Route(), but the counters can be read from anywhere.
+
+class CPacketRouter
+{
+public:
+	CPacketRouter() : m_routes(nullptr), m_count(0), m_names{}, m_stream{} {}
+
+	template <size_t N>
+	void SetRoutes(const char *protocol, const SPacketRoute (&routes)[N])
+	{
+		static_assert(N > 0, "a protocol needs at least one route");
+		SetRoutes(protocol, routes, N);
+	}
+
+	// the type of the first route the datagram matches, or 0 if there isn't one
+	unsigned Route(const CBufferView &Buffer);
+
+	// counters
+	uint64_t GetHits(unsigned type) const { return (type < PACKET_TYPES_MAX) ? m_hits[type].load(std::memory_order_relaxed) : 0; }
+	const char *GetName(unsigned type) const { return (type < PACKET_TYPES_MAX) ? m_names[type] : nullptr; }
+	bool HasRoutes(void) const { return m_count > 0; }
+	bool IsStream(unsigned type) const { return (type < PACKET_TYPES_MAX) && m_stream[type]; }
+	void Report(std::ostream &) const;
+
+	// the same routing as a classic BPF socket filter, so the kernel can drop any
+	// datagram that no route takes; false if the routes can't be expressed as one
+	bool CompileFilter(std::vector<struct sock_filter> &program) const;
+
+protected:
+	void SetRoutes(const char *, const SPacketRoute *, unsigned);
+
+	std::string         m_protocol;
+	const SPacketRoute *m_routes;
+	unsigned            m_count;
+	const char         *m_names[PACKET_TYPES_MAX];
+	bool                m_stream[PACKET_TYPES_MAX];
+	std::atomic<uint64_t> m_hits[PACKET_TYPES_MAX];
+};
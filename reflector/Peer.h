@@ -43,6 +43,7 @@ public:
 	const CIp &GetIp(void) const                        { return m_Ip; }
 	char *GetReflectorModules(void)                     { return m_ReflectorModules; }
 	std::time_t GetConnectTime(void) const              { return m_ConnectTime; }
+	std::time_t GetLastHeardTime(void) const            { return m_LastHeardTime; }
 
 	// set
 
@@ -67,10 +68,6 @@ public:
 	std::list<std::shared_ptr<CClient>>::const_iterator cbegin() const { return m_Clients.cbegin(); }
 	std::list<std::shared_ptr<CClient>>::const_iterator cend() const   { return m_Clients.cend(); }
 
-	// reporting
-	virtual void WriteXml(std::ofstream &);
-	void JsonReport(nlohmann::json &report);
-
 protected:
 	// data
 	CCallsign             m_Callsign;
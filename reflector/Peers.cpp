@@ -23,7 +23,7 @@
 // constructor
 
 
-CPeers::CPeers() {}
+CPeers::CPeers() : m_Generation(0) {}
 
 ////////////////////////////////////////////////////////////////////////////////////////
 // destructors
@@ -55,7 +55,8 @@ void CPeers::AddPeer(std::shared_ptr<CPeer> peer)
 
 	// if not, append to the vector
 	m_Peers.push_back(peer);
-	std::cout << "New peer " << peer->GetCallsign() << " at " << peer->GetIp() << " added with protocol " << peer->GetProtocolName()  << std::endl;
+	m_Generation.fetch_add(1, std::memory_order_release);
+	CLogLine(ELogLevel::info, "peer-add") << "New peer" << Field("callsign", peer->GetCallsign()) << Field("ip", peer->GetIp()) << Field("protocol", peer->GetProtocolName());
 	// and append all peer's client to reflector client list
 	// it is double lock safe to lock Clients list after Peers list
 	CClients *clients = g_Reflector.GetClients();
@@ -87,8 +88,9 @@ void CPeers::RemovePeer(std::shared_ptr<CPeer> peer)
 			g_Reflector.ReleaseClients();
 
 			// remove it
-			std::cout << "Peer " << (*pit)->GetCallsign() << " at " << (*pit)->GetIp() << " removed" << std::endl;
+			CLogLine(ELogLevel::info, "peer-remove") << "Peer removed" << Field("callsign", (*pit)->GetCallsign()) << Field("ip", (*pit)->GetIp());
 			pit = m_Peers.erase(pit);
+			m_Generation.fetch_add(1, std::memory_order_release);
 		}
 		else
 		{
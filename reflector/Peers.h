@@ -18,6 +18,8 @@
 
 #pragma once
 
+#include <atomic>
+
 #include "Peer.h"
 
 class CPeers
@@ -38,6 +40,9 @@ public:
 	void AddPeer(std::shared_ptr<CPeer>);
 	void RemovePeer(std::shared_ptr<CPeer>);
 
+	// reporting, counts the changes the status files would show
+	uint32_t GetGeneration(void) const { return m_Generation.load(std::memory_order_acquire); }
+
 	// pass-through
 	std::list<std::shared_ptr<CPeer>>::iterator begin()              { return m_Peers.begin(); }
 	std::list<std::shared_ptr<CPeer>>::iterator end()                { return m_Peers.end(); }
@@ -56,4 +61,5 @@ protected:
 	// data
 	std::mutex         m_Mutex;
 	std::list<std::shared_ptr<CPeer>> m_Peers;
+	std::atomic<uint32_t> m_Generation;
 };
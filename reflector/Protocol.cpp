@@ -21,6 +21,30 @@
 #include "Protocol.h"
 #include "Clients.h"
 
+////////////////////////////////////////////////////////////////////////////////////////
+// the [Rate Limits] key for each protocol
+
+static const std::string *RateLimitKey(EProtocol ptype)
+{
+	switch (ptype)
+	{
+		case EProtocol::bm:       return &g_Keys.ratelimit.bm;
+		case EProtocol::dcs:      return &g_Keys.ratelimit.dcs;
+		case EProtocol::dextra:   return &g_Keys.ratelimit.dextra;
+		case EProtocol::dmrplus:  return &g_Keys.ratelimit.dmrplus;
+		case EProtocol::dplus:    return &g_Keys.ratelimit.dplus;
+		case EProtocol::g3:       return &g_Keys.ratelimit.g3;
+		case EProtocol::m17:      return &g_Keys.ratelimit.m17;
+		case EProtocol::dmrmmdvm: return &g_Keys.ratelimit.mmdvm;
+		case EProtocol::nxdn:     return &g_Keys.ratelimit.nxdn;
+		case EProtocol::p25:      return &g_Keys.ratelimit.p25;
+		case EProtocol::urf:      return &g_Keys.ratelimit.urf;
+		case EProtocol::usrp:     return &g_Keys.ratelimit.usrp;
+		case EProtocol::ysf:      return &g_Keys.ratelimit.ysf;
+		default:                  return nullptr;
+	}
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////
 // constructor
 
@@ -49,6 +73,10 @@ CProtocol::~CProtocol()
 bool CProtocol::Initialize(const char *type, const EProtocol ptype, const uint16_t port, const bool has_ipv4, const bool has_ipv6)
 {
 	m_Port = port;
+
+	// flood protection
+	ConfigureRateLimiter(m_RateLimiter, ptype);
+
 	// init reflector apparent callsign
 	m_ReflectorCallsign = g_Reflector.GetCallsign();
 
@@ -59,6 +87,10 @@ bool CProtocol::Initialize(const char *type, const EProtocol ptype, const uint16
 	if (type)
 		m_ReflectorCallsign.PatchCallsign(0, type, 3);
 
+	// the kernel can drop what none of the routes would take
+	std::vector<struct sock_filter> filter;
+	const bool usefilter = m_Router.HasRoutes() && g_Configure.GetBoolean(g_Keys.ratelimit.filter) && m_Router.CompileFilter(filter);
+
 	// create our sockets
 	if (has_ipv4)
 	{
@@ -66,7 +98,7 @@ bool CProtocol::Initialize(const char *type, const EProtocol ptype, const uint16
 		CIp ip4(AF_INET, port, ipv4binding.c_str());
 		if ( ip4.IsSet() )
 		{
-			if (! m_Socket4.Open(ip4))
+			if (! m_Socket4.Open(ip4, usefilter ? &filter : nullptr))
 				return false;
 		}
 		std::cout << "Listening on " << ip4 << std::endl;
@@ -80,7 +112,7 @@ bool CProtocol::Initialize(const char *type, const EProtocol ptype, const uint16
 			CIp ip6(AF_INET6, port, ipv6binding.c_str());
 			if ( ip6.IsSet() )
 			{
-				if (! m_Socket6.Open(ip6))
+				if (! m_Socket6.Open(ip6, usefilter ? &filter : nullptr))
 				{
 					m_Socket4.Close();
 					return false;
@@ -113,12 +145,31 @@ void CProtocol::Thread()
 	}
 }
 
+// from the protocol's [Rate Limits] key, left off if it has none
+void CProtocol::ConfigureRateLimiter(CRateLimiter &limiter, const EProtocol ptype) const
+{
+	auto ratekey = RateLimitKey(ptype);
+	if (ratekey)
+	{
+		const auto rate = g_Configure.GetUnsigned(*ratekey);
+		limiter.Configure(rate, rate * g_Configure.GetUnsigned(g_Keys.ratelimit.burst), g_Configure.GetUnsigned(g_Keys.ratelimit.ban));
+	}
+}
+
 void CProtocol::Close(void)
 {
 	keep_running = false;
 	if ( m_Future.valid() )
 	{
 		m_Future.get();
+		if ( m_Router.HasRoutes() )
+		{
+			m_Router.Report(std::cout);
+			if ( m_ControlLane.GetDropped() )
+				std::cout << "Control packets dropped: " << m_ControlLane.GetDropped() << std::endl;
+		}
+		if ( m_RateLimiter.IsEnabled() )
+			m_RateLimiter.Report(m_Port, std::cout);
 	}
 	m_Socket4.Close();
 	m_Socket6.Close();
@@ -141,8 +192,7 @@ void CProtocol::OnDvFramePacketIn(std::unique_ptr<CDvFramePacket> &Frame, const
 //#ifdef DEBUG
 	else
 	{
-		std::cout << std::showbase << std::hex;
-		std::cout << "Orphaned Frame with ID " << ntohs(Frame->GetStreamId()) << std::noshowbase << std::dec << " on " << *Ip << std::endl;
+		CLogLine(ELogLevel::warning, "orphaned-frame") << "Orphaned Frame" << HexField("sid", ntohs(Frame->GetStreamId())) << Field("ip", *Ip);
 		Frame.reset();
 	}
 //#endif
@@ -168,6 +218,18 @@ std::shared_ptr<CPacketStream> CProtocol::GetStream(uint16_t uiStreamId, const C
 	return nullptr;
 }
 
+// for a frame of a stream that is already open, the gatekeeper
+// checks the header that the stream was opened with
+bool CProtocol::MayTransmitOnStream(uint16_t uiStreamId, const CIp &Ip, EProtocol protocol)
+{
+	auto stream = GetStream(uiStreamId, &Ip);
+	if ( stream )
+	{
+		return g_GateKeeper.MayTransmit(stream->GetUserCallsign(), Ip, protocol, stream->GetRpt2Module());
+	}
+	return false;
+}
+
 void CProtocol::CheckStreamsTimeout(void)
 {
 	for ( auto it=m_Streams.begin(); it!=m_Streams.end(); )
@@ -221,14 +283,30 @@ uint32_t CProtocol::ModuleToDmrDestId(char m) const
 ////////////////////////////////////////////////////////////////////////////////////////
 // Receivers
 
+// A stream packet that was just received is handled right away. Control packets queue in
+// the control lane, which is only drained when no stream packet is in hand, at its own rate.
+bool CProtocol::NextPacket(bool received, CBuffer &buf, CIp &Ip, unsigned &type)
+{
+	if ( received )
+	{
+		type = m_Router.Route(buf);
+		if ( m_Router.IsStream(type) )
+			return true;
+		m_ControlLane.Push(buf, Ip, type);
+	}
+	return m_ControlLane.Pop(buf, Ip, type);
+}
+
+// a datagram from a source the IP access list denies, or that is over its rate, is
+// dropped here, as if nothing came in
 bool CProtocol::Receive6(CBuffer &buf, CIp &ip, int time_ms)
 {
-	return m_Socket6.Receive(buf, ip, time_ms);
+	return m_Socket6.Receive(buf, ip, time_ms) && g_GateKeeper.MayReceive(ip) && m_RateLimiter.Admit(ip);
 }
 
 bool CProtocol::Receive4(CBuffer &buf, CIp &ip, int time_ms)
 {
-	return m_Socket4.Receive(buf, ip, time_ms);
+	return m_Socket4.Receive(buf, ip, time_ms) && g_GateKeeper.MayReceive(ip) && m_RateLimiter.Admit(ip);
 }
 
 bool CProtocol::ReceiveDS(CBuffer &buf, CIp &ip, int time_ms)
@@ -240,10 +318,10 @@ bool CProtocol::ReceiveDS(CBuffer &buf, CIp &ip, int time_ms)
 	{
 		if (fd6 < 0)
 			return false;
-		return m_Socket6.Receive(buf, ip, time_ms);
+		return Receive6(buf, ip, time_ms);
 	}
 	else if (fd6 < 0)
-		return m_Socket4.Receive(buf, ip, time_ms);
+		return Receive4(buf, ip, time_ms);
 
 	fd_set fset;
 	FD_ZERO(&fset);
@@ -263,9 +341,9 @@ bool CProtocol::ReceiveDS(CBuffer &buf, CIp &ip, int time_ms)
 	}
 
 	if (FD_ISSET(fd4, &fset))
-		return m_Socket4.ReceiveFrom(buf, ip);
+		return m_Socket4.ReceiveFrom(buf, ip) && g_GateKeeper.MayReceive(ip) && m_RateLimiter.Admit(ip);
 	else
-		return m_Socket6.ReceiveFrom(buf, ip);
+		return m_Socket6.ReceiveFrom(buf, ip) && g_GateKeeper.MayReceive(ip) && m_RateLimiter.Admit(ip);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////
@@ -351,45 +429,30 @@ void CProtocol::Send(const SM17Frame &frame, const CIp &Ip) const
 	}
 }
 
-#ifdef DEBUG
+// a hex and ascii dump, 16 bytes a line, handed to the log, so a flood of unknown packets
+// doesn't keep the receive thread waiting on stdout, and is cut by the log's rate limit
 void CProtocol::Dump(const char *title, const uint8_t *data, int length)
 {
-	std::cout << title << std::endl;
-
-	unsigned int offset = 0U;
-
-	while (length > 0) {
+	if ( ! g_Log.IsEnabled(ELogLevel::info) || ! g_Log.Allow("packet-dump") )
+		return;
+	g_Log.Write(ELogLevel::info, title, strlen(title));
 
-		unsigned int bytes = (length > 16) ? 16U : length;
-
-		for (unsigned i = 0U; i < bytes; i++) {
-			if (i)
-				std::cout << " ";
-			std::cout << std::hex << std::setw(2) << std::right << std::setfill('0') << int(data[offset + i]);
-		}
-
-		for (unsigned int i = bytes; i < 16U; i++)
-			std::cout << "   ";
-
-		std::cout << "   *";
-
-		for (unsigned i = 0U; i < bytes; i++) {
-			unsigned char c = data[offset + i];
-
-			if (::isprint(c))
-				std::cout << c;
+	char line[96];
+	for ( int offset = 0; offset < length; offset += 16 )
+	{
+		const int bytes = (length - offset > 16) ? 16 : (length - offset);
+		int n = snprintf(line, sizeof(line), "%04X:  ", offset);
+		for ( int i = 0; i < 16; i++ )
+		{
+			if ( i < bytes )
+				n += snprintf(line + n, sizeof(line) - n, "%02X ", data[offset + i]);
 			else
-				std::cout << '.';
+				n += snprintf(line + n, sizeof(line) - n, "   ");
 		}
-
-		std::cout << '*' << std::endl;
-
-		offset += 16U;
-
-		if (length >= 16)
-			length -= 16;
-		else
-			length = 0;
+		n += snprintf(line + n, sizeof(line) - n, "   *");
+		for ( int i = 0; i < bytes; i++ )
+			line[n++] = ::isprint(data[offset + i]) ? data[offset + i] : '.';
+		line[n++] = '*';
+		g_Log.Write(ELogLevel::info, line, n);
 	}
 }
-#endif
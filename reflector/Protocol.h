@@ -22,6 +22,9 @@
 #include "PacketStream.h"
 #include "DVHeaderPacket.h"
 #include "DVFramePacket.h"
+#include "PacketRouter.h"
+#include "ControlLane.h"
+#include "RateLimiter.h"
 
 ////////////////////////////////////////////////////////////////////////////////////////
 
@@ -73,6 +76,8 @@ public:
 
 	// get
 	const CCallsign &GetReflectorCallsign(void)const { return m_ReflectorCallsign; }
+	const CPacketRouter &GetRouter(void) const { return m_Router; }
+	const CRateLimiter &GetRateLimiter(void) const { return m_RateLimiter; }
 	uint16_t GetPort(void) const { return m_Port; }
 
 	// task
@@ -88,6 +93,7 @@ protected:
 
 	// stream handle helpers
 	std::shared_ptr<CPacketStream> GetStream(uint16_t, const CIp * = nullptr);
+	bool MayTransmitOnStream(uint16_t, const CIp &, EProtocol);
 	void CheckStreamsTimeout(void);
 
 	// queue helper
@@ -105,6 +111,10 @@ protected:
 	virtual char DmrDstIdToModule(uint32_t) const;
 	virtual uint32_t ModuleToDmrDestId(char) const;
 
+	// the two incoming lanes, for the protocols that set routes
+	int  ReceiveTimeout(int time_ms) const { return m_ControlLane.WaitTime(time_ms); }
+	bool NextPacket(bool received, CBuffer &buf, CIp &Ip, unsigned &type);
+
 	bool Receive6(CBuffer &buf, CIp &Ip, int time_ms);
 	bool Receive4(CBuffer &buf, CIp &Ip, int time_ms);
 	bool ReceiveDS(CBuffer &buf, CIp &Ip, int time_ms);
@@ -114,14 +124,20 @@ protected:
 	void Send(const CBuffer &buf, const CIp &Ip, uint16_t port) const;
 	void Send(const char    *buf, const CIp &Ip, uint16_t port) const;
 	void Send(const SM17Frame &frame, const CIp &Ip) const;
-#ifdef DEBUG
 	void Dump(const char *title, const uint8_t *data, int length);
-#endif
 
 	// socket
 	CUdpSocket m_Socket4;
 	CUdpSocket m_Socket6;
 
+	// incoming packet dispatch, for the protocols that set routes
+	CPacketRouter m_Router;
+	CControlLane  m_ControlLane;
+
+	// flood protection, ahead of any parsing
+	void ConfigureRateLimiter(CRateLimiter &limiter, const EProtocol ptype) const;
+	CRateLimiter  m_RateLimiter;
+
 	// streams
 	std::unordered_map<uint16_t, std::shared_ptr<CPacketStream>> m_Streams;
 
@@ -0,0 +1,145 @@
+// urfd -- The universal reflector
+// Copyright © 2024 Thomas A. Early N7TAE
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "Log.h"
+#include "RateLimiter.h"
+
+////////////////////////////////////////////////////////////////////////////////////////
+// configuration
+
+void CRateLimiter::Configure(unsigned rate, unsigned burst, unsigned banseconds)
+{
+	m_rate = rate;
+	m_burst = (burst < 1) ? 1 : burst;
+	m_ban = std::chrono::seconds(banseconds);
+	m_pruned = Clock::now();
+	m_sources.clear();
+	m_sources.reserve(RATE_SOURCES_MAX);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////
+// operation
+
+bool CRateLimiter::Admit(const CIp &Ip)
+{
+	if ( 0 == m_rate )
+		return true;
+
+	// a gateway, a dashboard or a load test on this host is the sysop's own
+	if ( Ip.IsLoopback() )
+	{
+		Count(m_passed);
+		return true;
+	}
+
+	const auto now = Clock::now();
+	if ( now - m_pruned > std::chrono::seconds(RATE_PRUNE_SECONDS) )
+		Prune(now, std::chrono::seconds(RATE_PRUNE_SECONDS));
+
+	const auto key = MakeKey(Ip);
+	auto it = m_sources.find(key);
+	if ( m_sources.end() == it )
+	{
+		if ( m_sources.size() >= RATE_SOURCES_MAX )
+		{
+			if ( now - m_pruned > std::chrono::seconds(1) )
+				Prune(now, std::chrono::seconds(1));
+			if ( m_sources.size() >= RATE_SOURCES_MAX )
+			{
+				// a flood of new addresses: let the newcomer through rather than lock out everyone
+				Count(m_untracked);
+				Count(m_passed);
+				return true;
+			}
+		}
+		it = m_sources.emplace(key, SSource{ double(m_burst), now, now, Clock::time_point(), 0 }).first;
+	}
+	auto &s = it->second;
+
+	if ( now < s.banned )
+	{
+		Count(m_dropped);
+		return false;
+	}
+
+	// refill
+	s.tokens += std::chrono::duration<double>(now - s.last).count() * m_rate;
+	if ( s.tokens > m_burst )
+		s.tokens = m_burst;
+	s.last = now;
+
+	if ( s.tokens >= 1.0 )
+	{
+		s.tokens -= 1.0;
+		Count(m_passed);
+		return true;
+	}
+
+	Count(m_dropped);
+	if ( now - s.window > std::chrono::seconds(RATE_STRIKE_WINDOW) )
+	{
+		s.window = now;
+		s.strikes = 0;
+	}
+	if ( ++s.strikes > m_rate && m_ban.count() )
+	{
+		s.banned = now + m_ban;
+		s.strikes = 0;
+		Count(m_bans);
+		CLogLine(ELogLevel::warning, "source-banned") << "Flooding source banned" << Field("ip", Ip) << Field("seconds", std::chrono::duration_cast<std::chrono::seconds>(m_ban).count());
+	}
+	return false;
+}
+
+void CRateLimiter::Report(uint16_t port, std::ostream &os) const
+{
+	os << "Rate limiter on port " << port << ": " << GetPassed() << " passed, " << GetDropped() << " dropped, " << GetBans() << " bans";
+	if ( GetUntracked() )
+		os << ", " << GetUntracked() << " untracked";
+	os << std::endl;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////
+// helpers
+
+// an IPv4 address is keyed as its IPv4-mapped IPv6 address
+CRateLimiter::SSourceKey CRateLimiter::MakeKey(const CIp &Ip)
+{
+	SSourceKey key { 0, 0 };
+	if ( AF_INET6 == Ip.GetFamily() )
+	{
+		const auto *a = reinterpret_cast<const struct sockaddr_in6 *>(Ip.GetCPointer())->sin6_addr.s6_addr;
+		memcpy(&key.hi, a, 8);
+		memcpy(&key.lo, a + 8, 8);
+	}
+	else
+	{
+		key.lo = 0xffff00000000ull | Ip.GetAddr();
+	}
+	return key;
+}
+
+void CRateLimiter::Prune(Clock::time_point now, Clock::duration idle)
+{
+	for ( auto it = m_sources.begin(); it != m_sources.end(); )
+	{
+		if ( now - it->second.last > idle && now >= it->second.banned )
+			it = m_sources.erase(it);
+		else
+			it++;
+	}
+	m_pruned = now;
+}
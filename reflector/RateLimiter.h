@@ -0,0 +1,88 @@
+// urfd -- The universal reflector
+// Copyright © 2024 Thomas A. Early N7TAE
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <unordered_map>
+
+#include "IP.h"
+
+#define RATE_SOURCES_MAX    8192    // sources being tracked, per protocol
+#define RATE_STRIKE_WINDOW  10      // seconds over which dropped packets are counted toward a ban
+#define RATE_PRUNE_SECONDS  60      // a source that's been quiet this long is forgotten
+
+////////////////////////////////////////////////////////////////////////////////////////
+// A token bucket for each source address, checked before a datagram is parsed. A source
+// may send rate packets a second, with bursts of up to burst packets. A source that has
+// more than rate packets dropped within RATE_STRIKE_WINDOW seconds is banned, and
+// everything it sends is dropped until the ban expires. A rate of zero turns this off.
+// The source is the address alone: a flood can't escape by changing its port. Loopback
+// sources, 127.0.0.0/8 and ::1, are never limited.
+// Only the protocol's thread calls Admit(), but the counters can be read from anywhere.
+
+class CRateLimiter
+{
+public:
+	CRateLimiter() : m_rate(0), m_burst(0), m_ban(0), m_passed(0), m_dropped(0), m_bans(0), m_untracked(0) {}
+
+	void Configure(unsigned rate, unsigned burst, unsigned banseconds);
+
+	// false if the datagram should be dropped without looking at it
+	bool Admit(const CIp &Ip);
+
+	bool IsEnabled(void) const { return m_rate > 0; }
+
+	// counters
+	uint64_t GetPassed(void)    const { return m_passed.load(std::memory_order_relaxed); }
+	uint64_t GetDropped(void)   const { return m_dropped.load(std::memory_order_relaxed); }
+	uint64_t GetBans(void)      const { return m_bans.load(std::memory_order_relaxed); }
+	uint64_t GetUntracked(void) const { return m_untracked.load(std::memory_order_relaxed); }
+	void Report(uint16_t port, std::ostream &) const;
+
+protected:
+	using Clock = std::chrono::steady_clock;
+
+	struct SSourceKey
+	{
+		uint64_t hi, lo;
+		bool operator==(const SSourceKey &rhs) const { return hi == rhs.hi && lo == rhs.lo; }
+	};
+	struct SSourceKeyHash
+	{
+		std::size_t operator()(const SSourceKey &k) const { return std::hash<uint64_t>()(k.hi * 0x9e3779b97f4a7c15ull ^ k.lo); }
+	};
+	struct SSource
+	{
+		double tokens;
+		Clock::time_point last, window, banned;
+		unsigned strikes;
+	};
+
+	static SSourceKey MakeKey(const CIp &Ip);
+	void Prune(Clock::time_point now, Clock::duration idle);
+	static void Count(std::atomic<uint64_t> &counter) { counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed); }
+
+	unsigned m_rate, m_burst;
+	Clock::duration m_ban;
+	Clock::time_point m_pruned;
+	std::unordered_map<SSourceKey, SSource, SSourceKeyHash> m_sources;
+
+	std::atomic<uint64_t> m_passed, m_dropped, m_bans, m_untracked;
+};
@@ -70,6 +70,10 @@ bool CReflector::Start(void)
 			return true;
 	}
 
+	// start the file watcher, before anything that has files to watch
+	if (g_FileWatcher.Start())
+		return true;
+
 	// init gate keeper. It can only return true!
 	g_GateKeeper.Init();
 
@@ -82,6 +86,13 @@ bool CReflector::Start(void)
 	// init wiresx node directory. Likewise with the return vale.
 	g_LYtr.LookupInit();
 
+	// start the dashboard data server, if it's wanted
+	if (g_Configure.GetBoolean(g_Keys.status.enable))
+	{
+		if (m_StatusServer.Start(g_Configure.GetString(g_Keys.status.bind), g_Configure.GetUnsigned(g_Keys.status.port)))
+			return true;
+	}
+
 	// create protocols
 	if (! m_Protocols.Init())
 	{
@@ -165,6 +176,9 @@ void CReflector::Stop(void)
 	// close protocols
 	m_Protocols.Close();
 
+	// stop the dashboard data server
+	m_StatusServer.Stop();
+
 	// close gatekeeper
 	g_GateKeeper.Close();
 
@@ -173,6 +187,9 @@ void CReflector::Stop(void)
 	g_LNid.LookupClose();
 	g_LYtr.LookupClose();
 
+	// nothing is left to watch
+	g_FileWatcher.Stop();
+
 #ifndef NO_DHT
 	// kill the DHT
 	node.cancelPut(refhash, toUType(EUrfdValueID::Config));
@@ -238,15 +255,14 @@ std::shared_ptr<CPacketStream> CReflector::OpenStream(std::unique_ptr<CDvHeaderP
 		client->Heard();
 
 		// report
-		std::cout << std::showbase << std::hex;
-		std::cout << "Opening stream on module " << module << " for client " << client->GetCallsign() << " with sid " << ntohs(DvHeader->GetStreamId()) << " by user " << DvHeader->GetMyCallsign() << std::endl;
-		std::cout << std::noshowbase << std::dec;
+		CLogLine(ELogLevel::info, "stream-open") << "Opening stream" << Field("module", module) << Field("client", client->GetCallsign()) << HexField("sid", ntohs(DvHeader->GetStreamId())) << Field("user", DvHeader->GetMyCallsign());
 
 		// and push header packet
 		stream->Push(std::move(DvHeader));
 
 		// notify
-		//OnStreamOpen(stream->GetUserCallsign());
+		if (IsListening())
+			Notify("stream-open", nlohmann::json{ { "Module", std::string(1, module) }, { "Callsign", stream->GetUserCallsign().GetCS() }, { "Repeater", client->GetCallsign().GetCS() }, { "Protocol", client->GetProtocolName() } });
 
 	}
 	return stream;
@@ -274,9 +290,10 @@ void CReflector::CloseStream(std::shared_ptr<CPacketStream> stream)
 			client->NotAMaster();
 
 			// notify
-			//OnStreamClose(stream->GetUserCallsign());
+			if (IsListening())
+				Notify("stream-close", nlohmann::json{ { "Module", std::string(1, GetStreamModule(stream)) }, { "Callsign", stream->GetUserCallsign().GetCS() }, { "Repeater", client->GetCallsign().GetCS() } });
 
-			std::cout << "Closing stream of module " << GetStreamModule(stream) << std::endl;
+			CLogLine(ELogLevel::info, "stream-close") << "Closing stream" << Field("module", GetStreamModule(stream));
 		}
 
 		// release clients
@@ -330,58 +347,22 @@ void CReflector::RouterThread(const char ThisModule)
 
 // Maintenance thread hands xml and/or json update,
 // and also keeps the transcoder TCP port(s) connected
-#define XML_UPDATE_PERIOD 10
+#define REPORT_CHECK_PERIOD 1	// seconds, the files are only rewritten when something has changed
 
 void CReflector::MaintenanceThread()
 {
-	std::string xmlpath, jsonpath;
-	if (g_Configure.Contains(g_Keys.files.xml))
-		xmlpath.assign(g_Configure.GetString(g_Keys.files.xml));
-	if (g_Configure.Contains(g_Keys.files.json))
-		jsonpath.assign(g_Configure.GetString(g_Keys.files.json));
 	auto tcport = g_Configure.GetUnsigned(g_Keys.tc.port);
 
-	if (xmlpath.empty() && jsonpath.empty())
+	if (! m_Reporter.Configure())
 		return;	// nothing to do
 
 	while (keep_running)
 	{
-		// report to xml file
-		if (! xmlpath.empty())
-		{
-			std::ofstream xmlFile;
-			xmlFile.open(xmlpath, std::ios::out | std::ios::trunc);
-			if ( xmlFile.is_open() )
-			{
-				// write xml file
-				WriteXmlFile(xmlFile);
-
-				// and close file
-				xmlFile.close();
-			}
-			else
-			{
-				std::cout << "Failed to open " << xmlpath  << std::endl;
-			}
-		}
-
-		// json report
-		if (!  jsonpath.empty())
-		{
-			nlohmann::json jreport;
-			JsonReport(jreport);
-			std::ofstream jsonFile;
-			jsonFile.open(jsonpath, std::ios::out | std::ios::trunc);
-			if (jsonFile.is_open())
-			{
-				jsonFile << jreport.dump();
-				jsonFile.close();
-			}
-		}
-
+		// rewrite the status files, if anything has changed
+		m_Reporter.Update();
 
 		// and wait a bit and do something useful at the same time
-		for (int i=0; i< XML_UPDATE_PERIOD*10 && keep_running; i++)
+		for (int i=0; i< REPORT_CHECK_PERIOD*10 && keep_running; i++)
 		{
 			if (tcport && g_TCServer.AnyAreClosed())
 			{
@@ -428,90 +409,6 @@ char CReflector::GetStreamModule(std::shared_ptr<CPacketStream> stream)
 	return ' ';
 }
 
-////////////////////////////////////////////////////////////////////////////////////////
-// report helpers
-
-void CReflector::JsonReport(nlohmann::json &report)
-{
-	for (auto &item : g_Configure.GetData().items())
-	{
-		if (isupper(item.key().at(0)))
-			report["Configure"][item.key()] = item.value();
-	}
-
-	report["Peers"] = nlohmann::json::array();
-	auto peers = GetPeers();
-	for (auto pit=peers->cbegin(); pit!=peers->cend(); pit++)
-		(*pit)->JsonReport(report);
-	ReleasePeers();
-
-	report["Clients"] = nlohmann::json::array();
-	auto clients = GetClients();
-	for (auto cit=clients->cbegin(); cit!=clients->cend(); cit++)
-		(*cit)->JsonReport(report);
-	ReleaseClients();
-
-	report["Users"] = nlohmann::json::array();
-	auto users = GetUsers();
-	for (auto uid=users->begin(); uid!=users->end(); uid++)
-		(*uid).JsonReport(report);
-	ReleaseUsers();
-}
-
-void CReflector::WriteXmlFile(std::ofstream &xmlFile)
-{
-	// write header
-	xmlFile << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>" << std::endl;
-
-	// software version
-	xmlFile << "<Version>" << g_Version << "</Version>" << std::endl;
-
-	CCallsign cs = m_Callsign;
-	cs.PatchCallsign(0, "XLX", 3);
-
-	// linked peers
-	xmlFile << "<" << cs << "linked peers>" << std::endl;
-	// lock
-	CPeers *peers = GetPeers();
-	// iterate on peers
-	for ( auto pit=peers->cbegin(); pit!=peers->cend(); pit++ )
-	{
-		(*pit)->WriteXml(xmlFile);
-	}
-	// unlock
-	ReleasePeers();
-	xmlFile << "</" << cs << "linked peers>" << std::endl;
-
-	// linked nodes
-	xmlFile << "<" << cs << "linked nodes>" << std::endl;
-	// lock
-	CClients *clients = GetClients();
-	// iterate on clients
-	for ( auto cit=clients->cbegin(); cit!=clients->cend(); cit++ )
-	{
-		if ( (*cit)->IsNode() )
-		{
-			(*cit)->WriteXml(xmlFile);
-		}
-	}
-	// unlock
-	ReleaseClients();
-	xmlFile << "</" << cs << "linked nodes>" << std::endl;
-
-	// last heard users
-	xmlFile << "<" << cs << "heard users>" << std::endl;
-	// lock
-	CUsers *users = GetUsers();
-	// iterate on users
-	for ( auto it=users->begin(); it!=users->end(); it++ )
-	{
-		it->WriteXml(xmlFile);
-	}
-	// unlock
-	ReleaseUsers();
-	xmlFile << "</" << cs << "heard users>" << std::endl;
-}
-
 #ifndef NO_DHT
 // DHT put() and get()
 void CReflector::PutDHTConfig()
@@ -25,6 +25,8 @@
 #include "Peers.h"
 #include "Protocols.h"
 #include "PacketStream.h"
+#include "StatusReporter.h"
+#include "StatusServer.h"
 
 #ifndef NO_DHT
 #include "dht-values.h"
@@ -74,7 +76,13 @@ public:
 	// check
 	bool IsValidModule(char c) const                { return m_Modules.npos!=m_Modules.find(c); }
 
-	// notifications
+	// moves whenever the clients, peers or users change
+	uint64_t GetReportGeneration(void) const        { return uint64_t(m_Clients.GetGeneration()) + m_Peers.GetGeneration() + m_Users.GetGeneration(); }
+
+	// notifications, for the status server's event stream
+	bool IsListening(void) const                    { return m_StatusServer.IsListening(); }
+	void Notify(const char *event, const nlohmann::json &data) { m_StatusServer.Publish(event, data); }
+	std::shared_ptr<const std::string> GetStatusJson(void) const { return m_Reporter.GetJson(); }
 
 #ifndef NO_DHT
 	void GetDHTConfig(const std::string &cs);
@@ -95,10 +103,6 @@ protected:
 	bool IsStreamOpen(const std::unique_ptr<CDvHeaderPacket> &);
 	char GetStreamModule(std::shared_ptr<CPacketStream>);
 
-	// xml helpers
-	void WriteXmlFile(std::ofstream &);
-	void JsonReport(nlohmann::json &report);
-
 	// identity
 	CCallsign   m_Callsign;
 	std::string m_Modules, m_TCmodules;
@@ -109,6 +113,10 @@ protected:
 	CPeers     m_Peers;            // list of linked peers
 	CProtocols m_Protocols;        // list of supported protocol handlers
 
+	// status files and server
+	CStatusReporter m_Reporter;
+	CStatusServer   m_StatusServer;
+
 	// queues
 	std::unordered_map<char, std::shared_ptr<CPacketStream>> m_Stream;
 
@@ -0,0 +1,302 @@
+// urfd -- The universal reflector
+// Copyright © 2024 Thomas A. Early N7TAE
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <unordered_set>
+#include <cstdio>
+#include <cstring>
+#include <cerrno>
+
+#include "Global.h"
+#include "StatusReporter.h"
+
+CStatusReporter::CStatusReporter() : m_Generation(0), m_Written(false), m_KeepJson(false) {}
+
+bool CStatusReporter::Configure(void)
+{
+	if (g_Configure.Contains(g_Keys.files.xml))
+		m_XmlPath.assign(g_Configure.GetString(g_Keys.files.xml));
+	if (g_Configure.Contains(g_Keys.files.json))
+		m_JsonPath.assign(g_Configure.GetString(g_Keys.files.json));
+	if (g_Configure.Contains(g_Keys.files.events))
+		m_EventsPath.assign(g_Configure.GetString(g_Keys.files.events));
+	m_KeepJson = g_Configure.GetBoolean(g_Keys.status.enable);
+	return m_KeepJson || ! (m_XmlPath.empty() && m_JsonPath.empty() && m_EventsPath.empty());
+}
+
+void CStatusReporter::Update(void)
+{
+	// read the count before the lists, so a change made while they're copied is seen next time
+	const auto generation = g_Reflector.GetReportGeneration();
+	if (m_Written && generation == m_Generation)
+		return;
+
+	SSnapshot snap;
+	TakeSnapshot(snap);
+
+	if (! m_XmlPath.empty())
+		WriteFile(m_XmlPath, MakeXml(snap));
+	if (m_KeepJson || ! m_JsonPath.empty())
+	{
+		auto json = std::make_shared<const std::string>(MakeJson(snap));
+		if (! m_JsonPath.empty())
+			WriteFile(m_JsonPath, *json);
+		if (m_KeepJson)
+			std::atomic_store(&m_Json, json);
+	}
+	if (! m_EventsPath.empty())
+	{
+		const auto events = MakeEvents(snap);
+		if (! events.empty())
+		{
+			std::ofstream file(m_EventsPath, std::ios::out | std::ios::app);
+			if (file.is_open())
+				file << events;
+			else
+				std::cout << "Failed to open " << m_EventsPath << std::endl;
+		}
+	}
+
+	m_Generation = generation;
+	m_Written = true;
+	m_Last = std::move(snap);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////
+// the snapshot, the only part done with the lists locked
+
+void CStatusReporter::TakeSnapshot(SSnapshot &snap) const
+{
+	auto peers = g_Reflector.GetPeers();
+	snap.peers.reserve(peers->GetSize());
+	for (auto pit=peers->begin(); pit!=peers->end(); pit++)
+	{
+		auto &peer = *pit;
+		snap.peers.push_back(SLink{ peer->GetCallsign(), peer->GetIp(), peer->GetReflectorModules(), peer->GetProtocolName(), peer->GetConnectTime(), peer->GetLastHeardTime(), false });
+	}
+	g_Reflector.ReleasePeers();
+
+	auto clients = g_Reflector.GetClients();
+	snap.clients.reserve(clients->GetSize());
+	for (auto cit=clients->cbegin(); cit!=clients->cend(); cit++)
+	{
+		auto &client = *cit;
+		snap.clients.push_back(SLink{ client->GetCallsign(), client->GetIp(), std::string(1, client->GetReflectorModule()), client->GetProtocolName(), client->GetConnectTime(), client->GetLastHeardTime(), client->IsNode() });
+	}
+	g_Reflector.ReleaseClients();
+
+	auto users = g_Reflector.GetUsers();
+	for (auto uit=users->cbegin(); uit!=users->cend(); uit++)
+		snap.users.push_back(*uit);
+	g_Reflector.ReleaseUsers();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////
+// the documents
+
+std::string CStatusReporter::MakeXml(const SSnapshot &snap) const
+{
+	std::ostringstream xml;
+
+	// header and software version
+	xml << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>" << std::endl;
+	xml << "<Version>" << g_Version << "</Version>" << std::endl;
+
+	CCallsign cs = g_Reflector.GetCallsign();
+	cs.PatchCallsign(0, "XLX", 3);
+
+	// linked peers
+	xml << "<" << cs << "linked peers>" << std::endl;
+	for (const auto &peer : snap.peers)
+	{
+		xml << "<PEER>" << std::endl;
+		xml << "\t<Callsign>" << peer.callsign << "</Callsign>" << std::endl;
+		xml << "\t<IP>" << peer.ip.GetAddress() << "</IP>" << std::endl;
+		xml << "\t<LinkedModule>" << peer.modules << "</LinkedModule>" << std::endl;
+		xml << "\t<Protocol>" << peer.protocol << "</Protocol>" << std::endl;
+		auto s = TimeString(peer.connect);
+		if (! s.empty())
+			xml << "\t<ConnectTime>" << s << "</ConnectTime>" << std::endl;
+		s = TimeString(peer.heard);
+		if (! s.empty())
+			xml << "\t<LastHeardTime>" << s << "</LastHeardTime>" << std::endl;
+		xml << "</PEER>" << std::endl;
+	}
+	xml << "</" << cs << "linked peers>" << std::endl;
+
+	// linked nodes
+	xml << "<" << cs << "linked nodes>" << std::endl;
+	for (const auto &client : snap.clients)
+	{
+		if (! client.node)
+			continue;
+		xml << "<NODE>" << std::endl;
+		xml << "\t<Callsign>" << client.callsign << "</Callsign>" << std::endl;
+		xml << "\t<IP>" << client.ip.GetAddress() << "</IP>" << std::endl;
+		xml << "\t<LinkedModule>" << client.modules << "</LinkedModule>" << std::endl;
+		xml << "\t<Protocol>" << client.protocol << "</Protocol>" << std::endl;
+		auto s = TimeString(client.connect);
+		if (! s.empty())
+			xml << "\t<ConnectTime>" << s << "</ConnectTime>" << std::endl;
+		s = TimeString(client.heard);
+		if (! s.empty())
+			xml << "\t<LastHeardTime>" << s << "</LastHeardTime>" << std::endl;
+		xml << "</NODE>" << std::endl;
+	}
+	xml << "</" << cs << "linked nodes>" << std::endl;
+
+	// last heard users
+	xml << "<" << cs << "heard users>" << std::endl;
+	for (const auto &user : snap.users)
+		user.WriteXml(xml);
+	xml << "</" << cs << "heard users>" << std::endl;
+
+	return xml.str();
+}
+
+std::string CStatusReporter::MakeJson(const SSnapshot &snap) const
+{
+	nlohmann::json report;
+	for (auto &item : g_Configure.GetData().items())
+	{
+		if (isupper(item.key().at(0)))
+			report["Configure"][item.key()] = item.value();
+	}
+
+	report["Peers"] = nlohmann::json::array();
+	for (const auto &peer : snap.peers)
+	{
+		nlohmann::json jpeer;
+		jpeer["Callsign"] = peer.callsign.GetCS();
+		jpeer["Modules"] = peer.modules;
+		jpeer["Protocol"] = peer.protocol;
+		auto s = TimeString(peer.connect);
+		if (! s.empty())
+			jpeer["ConnectTime"] = s;
+		report["Peers"].push_back(jpeer);
+	}
+
+	report["Clients"] = nlohmann::json::array();
+	for (const auto &client : snap.clients)
+	{
+		nlohmann::json jclient;
+		jclient["Callsign"] = client.callsign.GetCS();
+		jclient["OnModule"] = client.modules;
+		jclient["Protocol"] = client.protocol;
+		auto s = TimeString(client.connect);
+		if (! s.empty())
+			jclient["ConnectTime"] = s;
+		report["Clients"].push_back(jclient);
+	}
+
+	report["Users"] = nlohmann::json::array();
+	for (const auto &user : snap.users)
+		user.JsonReport(report);
+
+	return report.dump();
+}
+
+// one json line for each difference between this snapshot and the last one
+std::string CStatusReporter::MakeEvents(const SSnapshot &snap) const
+{
+	const auto now = TimeString(std::time(nullptr));
+	std::string events;
+
+	auto compare = [&](const std::vector<SLink> &from, const std::vector<SLink> &to, const char *event, const char *modkey)
+	{
+		std::unordered_set<std::string> keys;
+		for (const auto &link : from)
+			keys.insert(link.Key());
+		for (const auto &link : to)
+		{
+			if (keys.count(link.Key()))
+				continue;
+			nlohmann::json jevent;
+			jevent["Time"] = now;
+			jevent["Event"] = event;
+			jevent["Callsign"] = link.callsign.GetCS();
+			jevent[modkey] = link.modules;
+			jevent["Protocol"] = link.protocol;
+			events.append(jevent.dump()).push_back('\n');
+		}
+	};
+	compare(m_Last.peers, snap.peers, "PeerLinked", "Modules");
+	compare(snap.peers, m_Last.peers, "PeerUnlinked", "Modules");
+	compare(m_Last.clients, snap.clients, "ClientLinked", "OnModule");
+	compare(snap.clients, m_Last.clients, "ClientUnlinked", "OnModule");
+
+	// a station is heard again if it's back with a new time
+	std::unordered_set<std::string> heard;
+	for (const auto &user : m_Last.users)
+		heard.insert(user.GetCallsign() + ' ' + std::to_string(user.GetLastHeardTime()));
+	for (auto uit=snap.users.crbegin(); uit!=snap.users.crend(); uit++)
+	{
+		if (heard.count(uit->GetCallsign() + ' ' + std::to_string(uit->GetLastHeardTime())))
+			continue;
+		nlohmann::json juser;
+		uit->JsonReport(juser);
+		auto jevent = juser["Users"][0];
+		jevent["Time"] = now;
+		jevent["Event"] = "UserHeard";
+		events.append(jevent.dump()).push_back('\n');
+	}
+
+	return events;
+}
+
+std::string CStatusReporter::SLink::Key(void) const
+{
+	return protocol + ' ' + callsign.GetCS() + ' ' + ip.GetAddress() + ' ' + modules;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////
+// helpers
+
+bool CStatusReporter::WriteFile(const std::string &path, const std::string &text)
+{
+	const std::string tmppath(path + ".tmp");
+	std::ofstream file(tmppath, std::ios::out | std::ios::trunc);
+	if (! file.is_open())
+	{
+		std::cout << "Failed to open " << tmppath << std::endl;
+		return true;
+	}
+	file << text;
+	file.close();
+	if (file.fail())
+	{
+		std::cout << "Failed to write " << tmppath << std::endl;
+		remove(tmppath.c_str());
+		return true;
+	}
+	if (rename(tmppath.c_str(), path.c_str()))
+	{
+		std::cout << "Failed to rename " << tmppath << " to " << path << ": " << strerror(errno) << std::endl;
+		remove(tmppath.c_str());
+		return true;
+	}
+	return false;
+}
+
+std::string CStatusReporter::TimeString(std::time_t t)
+{
+	char s[100];
+	if (std::strftime(s, sizeof(s), "%FT%TZ", std::gmtime(&t)))
+		return s;
+	return std::string();
+}
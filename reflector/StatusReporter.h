@@ -0,0 +1,86 @@
+// urfd -- The universal reflector
+// Copyright © 2024 Thomas A. Early N7TAE
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <cstdint>
+#include <ctime>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Callsign.h"
+#include "IP.h"
+#include "User.h"
+
+////////////////////////////////////////////////////////////////////////////////////////
+// Writes the xml and json status files, and appends to the event file. The clients,
+// peers and users each count their changes, and nothing is done until one of the
+// counts moves. Then each list is copied while it's locked, and the documents are
+// built from the copies after the locks are released. Each file is written next to
+// itself and renamed over the old one, so a reader like the dashboard sees one whole
+// document or the other, never part of one. The event file, if there is one, gets a
+// json line for each client or peer that comes or goes, and for each station that's
+// heard, found by comparing the copies with the last ones. If the status server is
+// on, the json report is also kept for it to hand out.
+
+class CStatusReporter
+{
+public:
+	CStatusReporter();
+
+	// reads the paths from the ini file, false if there's nothing to write
+	bool Configure(void);
+
+	// call from the maintenance thread, only does anything if there's been a change
+	void Update(void);
+
+	// the last json report, for the status server, nullptr before the first one
+	std::shared_ptr<const std::string> GetJson(void) const { return std::atomic_load(&m_Json); }
+
+protected:
+	struct SLink
+	{
+		CCallsign   callsign;
+		CIp         ip;
+		std::string modules;
+		std::string protocol;
+		std::time_t connect, heard;
+		bool        node;
+
+		std::string Key(void) const;
+	};
+
+	struct SSnapshot
+	{
+		std::vector<SLink> peers, clients;
+		std::vector<CUser> users;
+	};
+
+	void TakeSnapshot(SSnapshot &snap) const;
+	std::string MakeXml(const SSnapshot &snap) const;
+	std::string MakeJson(const SSnapshot &snap) const;
+	std::string MakeEvents(const SSnapshot &snap) const;
+	static bool WriteFile(const std::string &path, const std::string &text);
+	static std::string TimeString(std::time_t t);
+
+	std::string m_XmlPath, m_JsonPath, m_EventsPath;
+	uint64_t    m_Generation;
+	bool        m_Written;
+	bool        m_KeepJson;
+	SSnapshot   m_Last;
+	std::shared_ptr<const std::string> m_Json;	// only touched with std::atomic_load/store
+};
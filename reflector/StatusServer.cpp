@@ -0,0 +1,332 @@
+// urfd -- The universal reflector
+// Copyright © 2024 Thomas A. Early N7TAE
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include <iostream>
+#include <sstream>
+#include <cstring>
+#include <cerrno>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+
+#include "Global.h"
+#include "StatusServer.h"
+
+CStatusServer::CStatusServer() : m_ListenFd(-1), m_WakeFd{-1, -1}, m_Listeners(0), keep_running(false) {}
+
+CStatusServer::~CStatusServer()
+{
+	Stop();
+}
+
+bool CStatusServer::Start(const std::string &address, uint16_t port)
+{
+	m_Ip = CIp(address.c_str(), AF_UNSPEC, SOCK_STREAM, port);
+	if (AF_INET != m_Ip.GetFamily() && AF_INET6 != m_Ip.GetFamily())
+	{
+		std::cerr << "Status server can't use address " << address << std::endl;
+		return true;
+	}
+
+	m_ListenFd = socket(m_Ip.GetFamily(), SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+	if (m_ListenFd < 0)
+	{
+		std::cerr << "Status server can't open a socket: " << strerror(errno) << std::endl;
+		return true;
+	}
+	int yes = 1;
+	setsockopt(m_ListenFd, SOL_SOCKET, SO_REUSEADDR, &yes, sizeof(int));
+	if (bind(m_ListenFd, m_Ip.GetCPointer(), m_Ip.GetSize()) || listen(m_ListenFd, 8))
+	{
+		std::cerr << "Status server can't listen at " << m_Ip << ": " << strerror(errno) << std::endl;
+		Stop();
+		return true;
+	}
+
+	if (pipe2(m_WakeFd, O_NONBLOCK | O_CLOEXEC))
+	{
+		std::cerr << "Status server can't make its wake pipe: " << strerror(errno) << std::endl;
+		Stop();
+		return true;
+	}
+
+	keep_running = true;
+	try
+	{
+		m_Future = std::async(std::launch::async, &CStatusServer::Thread, this);
+	}
+	catch (const std::exception &e)
+	{
+		std::cerr << "Cannot start the status server thread: " << e.what() << std::endl;
+		Stop();
+		return true;
+	}
+	std::cout << "Status server listening at " << m_Ip << std::endl;
+	return false;
+}
+
+void CStatusServer::Stop(void)
+{
+	keep_running = false;
+	if (m_Future.valid())
+		m_Future.get();
+	for (auto &c : m_Connections)
+		close(c.fd);
+	m_Connections.clear();
+	m_Listeners = 0;
+	for (int *fd : { &m_ListenFd, &m_WakeFd[0], &m_WakeFd[1] })
+	{
+		if (*fd >= 0)
+		{
+			close(*fd);
+			*fd = -1;
+		}
+	}
+}
+
+void CStatusServer::Publish(const char *event, const nlohmann::json &data)
+{
+	std::string frame("event: ");
+	frame.append(event).append("\ndata: ").append(data.dump()).append("\n\n");
+	{
+		std::lock_guard<std::mutex> lock(m_QueueMutex);
+		if (m_Queue.size() >= STATUS_MAX_QUEUE)
+			return;	// the thread is that far behind, it'll catch up with /status
+		m_Queue.push_back(std::move(frame));
+	}
+	const char c = 0;
+	if (write(m_WakeFd[1], &c, 1)) {}	// if the pipe is full, the thread is already awake
+}
+
+////////////////////////////////////////////////////////////////////////////////////////
+// the thread, the only one that touches the connections
+
+void CStatusServer::Thread(void)
+{
+	std::vector<struct pollfd> pfds;
+	while (keep_running)
+	{
+		pfds.clear();
+		pfds.push_back({ m_ListenFd, POLLIN, 0 });
+		pfds.push_back({ m_WakeFd[0], POLLIN, 0 });
+		for (const auto &c : m_Connections)
+			pfds.push_back({ c.fd, short(c.out.empty() ? POLLIN : (POLLIN | POLLOUT)), 0 });
+
+		if (poll(pfds.data(), pfds.size(), STATUS_WAKE_MS) < 0)
+		{
+			if (EINTR == errno)
+				continue;
+			std::cerr << "Status server poll failed: " << strerror(errno) << std::endl;
+			return;
+		}
+
+		// these may add connections, or data to send, so the rest of pfds is done first
+		const bool accept = pfds[0].revents & POLLIN;
+		const bool wake = pfds[1].revents & POLLIN;
+
+		const auto now = std::time(nullptr);
+		std::vector<bool> drops(m_Connections.size(), false);
+		for (std::size_t i = 0; i < m_Connections.size(); i++)
+		{
+			auto &c = m_Connections[i];
+			const auto revents = pfds[i + 2].revents;
+			bool drop = revents & (POLLERR | POLLHUP | POLLNVAL);
+			if (! drop && (revents & POLLIN))
+			{
+				if (c.events)
+				{
+					// a listener has nothing more to say, this is just to see it close
+					char buf[256];
+					auto len = recv(c.fd, buf, sizeof(buf), 0);
+					drop = (0 == len) || (len < 0 && EAGAIN != errno && EWOULDBLOCK != errno);
+				}
+				else
+				{
+					ReadRequest(c);
+				}
+			}
+			if (! drop && ! c.out.empty())
+				drop = WriteOut(c);
+			if (! drop)
+			{
+				if (c.events)
+				{
+					if (now - c.last >= STATUS_PING_SECONDS)
+					{
+						c.last = now;
+						c.out.append(": ping\n\n");
+					}
+				}
+				else if (c.closing && c.out.empty())
+					drop = true;
+				else if (now - c.last >= STATUS_REQUEST_SECONDS)
+					drop = true;
+			}
+			drops[i] = drop;
+		}
+		for (std::size_t i = m_Connections.size(); i-- > 0; )
+		{
+			if (drops[i])
+			{
+				close(m_Connections[i].fd);
+				if (m_Connections[i].events)
+					m_Listeners--;
+				m_Connections.erase(m_Connections.begin() + i);
+			}
+		}
+
+		if (wake)
+			Distribute();
+		if (accept)
+			AcceptAll();
+	}
+}
+
+void CStatusServer::AcceptAll(void)
+{
+	while (true)
+	{
+		auto fd = accept4(m_ListenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+		if (fd < 0)
+			return;
+		if (m_Connections.size() >= STATUS_MAX_CONNECTIONS)
+		{
+			close(fd);
+			continue;
+		}
+		m_Connections.push_back(SConnection{ fd, std::string(), std::string(), false, false, std::time(nullptr) });
+	}
+}
+
+void CStatusServer::ReadRequest(SConnection &c)
+{
+	char buf[1024];
+	while (true)
+	{
+		auto len = recv(c.fd, buf, sizeof(buf), 0);
+		if (len <= 0)
+		{
+			if (0 == len || (EAGAIN != errno && EWOULDBLOCK != errno))
+				c.closing = true;	// out is empty, so it's dropped
+			return;
+		}
+		if (c.closing || c.events)
+			continue;	// the reply has been made, the rest is ignored
+		c.in.append(buf, len);
+		auto end = c.in.find("\r\n\r\n");
+		if (std::string::npos != end)
+		{
+			Respond(c, c.in.substr(0, c.in.find("\r\n")));
+			c.in.clear();
+		}
+		else if (c.in.size() > STATUS_MAX_REQUEST)
+		{
+			Reply(c, "431 Request Header Fields Too Large", "text/plain", "request too large\n");
+			c.in.clear();
+		}
+	}
+}
+
+void CStatusServer::Respond(SConnection &c, const std::string &request)
+{
+	std::istringstream iss(request);
+	std::string method, target;
+	iss >> method >> target;
+	auto query = target.find('?');
+	if (std::string::npos != query)
+		target.resize(query);
+
+	if (method.compare("GET"))
+	{
+		Reply(c, "405 Method Not Allowed", "text/plain", "only GET is supported\n");
+	}
+	else if (0 == target.compare("/status"))
+	{
+		auto json = g_Reflector.GetStatusJson();
+		if (json)
+			Reply(c, "200 OK", "application/json", *json);
+		else
+			Reply(c, "503 Service Unavailable", "text/plain", "the first report isn't ready yet\n");
+	}
+	else if (0 == target.compare("/events"))
+	{
+		c.out.assign("HTTP/1.1 200 OK\r\nContent-Type: text/event-stream\r\nCache-Control: no-cache\r\nAccess-Control-Allow-Origin: *\r\nConnection: keep-alive\r\n\r\n");
+		c.events = true;
+		c.last = std::time(nullptr);
+		m_Listeners++;
+	}
+	else
+	{
+		Reply(c, "404 Not Found", "text/plain", "try /status or /events\n");
+	}
+}
+
+void CStatusServer::Reply(SConnection &c, const char *status, const char *type, const std::string &body)
+{
+	c.out.assign("HTTP/1.1 ").append(status).append("\r\nContent-Type: ").append(type);
+	c.out.append("\r\nContent-Length: ").append(std::to_string(body.size()));
+	c.out.append("\r\nCache-Control: no-cache\r\nAccess-Control-Allow-Origin: *\r\nConnection: close\r\n\r\n");
+	c.out.append(body);
+	c.closing = true;
+}
+
+// true if the connection is to be dropped
+bool CStatusServer::WriteOut(SConnection &c)
+{
+	while (! c.out.empty())
+	{
+		auto len = send(c.fd, c.out.data(), c.out.size(), MSG_NOSIGNAL);
+		if (len < 0)
+			return (EAGAIN != errno && EWOULDBLOCK != errno);
+		c.out.erase(0, len);
+	}
+	return false;
+}
+
+// hand the queued events to the listeners
+void CStatusServer::Distribute(void)
+{
+	char buf[256];
+	while (0 < read(m_WakeFd[0], buf, sizeof(buf))) {}
+
+	std::vector<std::string> queue;
+	{
+		std::lock_guard<std::mutex> lock(m_QueueMutex);
+		queue.swap(m_Queue);
+	}
+	for (auto &c : m_Connections)
+	{
+		if (! c.events)
+			continue;
+		for (const auto &frame : queue)
+			c.out.append(frame);
+		if (c.out.size() > STATUS_MAX_BACKLOG)
+		{
+			std::cout << "Status server dropped a listener that fell behind" << std::endl;
+			c.out.clear();
+			c.events = false;
+			m_Listeners--;
+			c.closing = true;	// with nothing left to send, it's dropped on the next pass
+		}
+		else if (WriteOut(c))
+		{
+			c.out.clear();
+			c.events = false;
+			m_Listeners--;
+			c.closing = true;
+		}
+	}
+}
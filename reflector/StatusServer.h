@@ -0,0 +1,89 @@
+// urfd -- The universal reflector
+// Copyright © 2024 Thomas A. Early N7TAE
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <atomic>
+#include <ctime>
+#include <future>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+#include "IP.h"
+
+#define STATUS_WAKE_MS          1000        // how often the thread looks at keep_running
+#define STATUS_MAX_CONNECTIONS  32          // more than this are closed as soon as they're accepted
+#define STATUS_MAX_REQUEST      4096        // bytes, a bigger request is dropped
+#define STATUS_REQUEST_SECONDS  10          // to finish sending a request
+#define STATUS_MAX_BACKLOG      (256*1024)  // bytes, an event listener that falls this far behind is dropped
+#define STATUS_MAX_QUEUE        1024        // events waiting for the thread
+#define STATUS_PING_SECONDS     15          // an event listener gets a comment this often, to keep proxies from closing it
+
+////////////////////////////////////////////////////////////////////////////////////////
+// A small HTTP server for dashboards, on one thread with non-blocking sockets:
+//
+//   GET /status  the json report, the same document as the JsonPath file
+//   GET /events  a Server-Sent-Events stream of stream-open, stream-close,
+//                client-link and client-unlink, each with a json object as its data
+//
+// Any thread can Publish() an event. It's queued and the server's thread is woken
+// to hand it to the listeners, so a publisher never waits on a socket. If no one is
+// listening, IsListening() is false, and the publisher needn't build the event.
+
+class CStatusServer
+{
+public:
+	CStatusServer();
+	~CStatusServer();
+
+	bool Start(const std::string &address, uint16_t port);	// true on error
+	void Stop(void);
+
+	bool IsListening(void) const { return m_Listeners.load(std::memory_order_relaxed) > 0; }
+	void Publish(const char *event, const nlohmann::json &data);
+
+protected:
+	struct SConnection
+	{
+		int fd;
+		std::string in, out;
+		bool events;		// this is an event listener
+		bool closing;		// close once out is sent
+		std::time_t last;	// when the request started, or the last ping
+	};
+
+	void Thread(void);
+	void AcceptAll(void);
+	void ReadRequest(SConnection &c);
+	void Respond(SConnection &c, const std::string &request);
+	void Reply(SConnection &c, const char *status, const char *type, const std::string &body);
+	bool WriteOut(SConnection &c);
+	void Distribute(void);
+
+	CIp m_Ip;
+	int m_ListenFd;
+	int m_WakeFd[2];
+	std::vector<SConnection> m_Connections;
+	std::atomic<int> m_Listeners;
+
+	std::mutex m_QueueMutex;
+	std::vector<std::string> m_Queue;
+
+	std::atomic<bool> keep_running;
+	std::future<void> m_Future;
+};
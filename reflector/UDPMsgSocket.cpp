@@ -57,13 +57,10 @@ int CUdpMsgSocket::Receive(CBuffer *Buffer, CIp *Ip, int timeout)
 	// socket valid ?
 	if ( m_fd != -1 )
 	{
-		// allocate buffer
-		Buffer->resize(UDP_MSG_BUFFER_LENMAX);
-
-		//prepare msghdr
+		//prepare msghdr, to read straight into the buffer
 		bzero(&Msg, sizeof(Msg));
 		Iov[0].iov_base = Buffer->data();
-		Iov[0].iov_len = UDP_MSG_BUFFER_LENMAX;
+		Iov[0].iov_len = Buffer->capacity();
 
 		bzero(&Sin, sizeof(Sin));
 		Msg.msg_name = &Sin;
@@ -87,7 +84,7 @@ int CUdpMsgSocket::Receive(CBuffer *Buffer, CIp *Ip, int timeout)
 		if ( iRecvLen != -1 )
 		{
 			// adjust buffer size
-			Buffer->resize(iRecvLen);
+			Buffer->SetSize(iRecvLen);
 
 			// get IP
 			if (AF_INET == m_addr.GetFamily())
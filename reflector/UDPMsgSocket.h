@@ -24,7 +24,7 @@
 
 #include "UDPSocket.h"
 
-#define UDP_MSG_BUFFER_LENMAX       1024
+#define UDP_MSG_BUFFER_LENMAX       BUFFER_LENMAX
 
 class CUdpMsgSocket : public CUdpSocket
 {
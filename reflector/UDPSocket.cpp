@@ -38,7 +38,7 @@ CUdpSocket::~CUdpSocket()
 // open & close
 
 // returns true on error
-bool CUdpSocket::Open(const CIp &Ip)
+bool CUdpSocket::Open(const CIp &Ip, const std::vector<struct sock_filter> *filter)
 {
 	// check for a valid family
 	if (AF_UNSPEC == Ip.GetFamily())
@@ -54,14 +54,25 @@ bool CUdpSocket::Open(const CIp &Ip)
 	// initialize sockaddr struct
 	m_addr = Ip;
 
+	// only a fixed port needs this, with it Linux can hand the same ephemeral port to two sockets
 	int reuse = 1;
-	if ( 0 > setsockopt(m_fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(int)))
+	if ( 0 != m_addr.GetPort() && 0 > setsockopt(m_fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(int)))
 	{
 		std::cerr << "Cannot set the UDP socket option on " << m_addr << ", " << strerror(errno) << std::endl;
 		Close();
 		return false;
 	}
 
+	// it's only an optimization, the protocol still checks everything it reads
+	if (filter && filter->size())
+	{
+		struct sock_fprog prog;
+		prog.len = (unsigned short)filter->size();
+		prog.filter = const_cast<struct sock_filter *>(filter->data());
+		if (setsockopt(m_fd, SOL_SOCKET, SO_ATTACH_FILTER, &prog, sizeof(prog)))
+			std::cerr << "Cannot attach the socket filter on " << m_addr << ", " << strerror(errno) << std::endl;
+	}
+
 	if (fcntl(m_fd, F_SETFL, O_NONBLOCK))
 	{
 		std::cerr << "fcntl set non-blocking failed on " << m_addr << ", " << strerror(errno) << std::endl;
@@ -134,15 +145,14 @@ bool CUdpSocket::Receive(CBuffer &Buffer, CIp &Ip, int timeout)
 
 bool CUdpSocket::ReceiveFrom(CBuffer &Buffer, CIp &ip)
 {
-	// read
-	uint8_t buf[UDP_BUFFER_LENMAX];
+	// read, straight into the buffer
 	unsigned int fromsize = sizeof(struct sockaddr_storage);
-	auto iRecvLen = recvfrom(m_fd, buf, UDP_BUFFER_LENMAX, 0, ip.GetPointer(), &fromsize);
+	auto iRecvLen = recvfrom(m_fd, Buffer.data(), Buffer.capacity(), 0, ip.GetPointer(), &fromsize);
 
 	if (0 >= iRecvLen)
 		return false;
 
-	Buffer.Set(buf, iRecvLen);
+	Buffer.SetSize(iRecvLen);
 
 	return true;
 }
@@ -152,6 +162,11 @@ bool CUdpSocket::ReceiveFrom(CBuffer &Buffer, CIp &ip)
 
 void CUdpSocket::Send(const CBuffer &Buffer, const CIp &Ip) const
 {
+	if (Buffer.Overflowed())
+	{
+		std::cerr << "Not sending an overflowed buffer on UDP port " << m_addr << std::endl;
+		return;
+	}
 	sendto(m_fd, Buffer.data(), Buffer.size(), 0, Ip.GetCPointer(), Ip.GetSize());
 }
 
@@ -162,6 +177,11 @@ void CUdpSocket::Send(const char *Buffer, const CIp &Ip) const
 
 void CUdpSocket::Send(const CBuffer &Buffer, const CIp &Ip, uint16_t destport) const
 {
+	if (Buffer.Overflowed())
+	{
+		std::cerr << "Not sending an overflowed buffer on UDP port " << m_addr << std::endl;
+		return;
+	}
 	CIp temp(Ip);
 	temp.SetPort(destport);
 	sendto(m_fd, Buffer.data(), Buffer.size(), 0, temp.GetCPointer(), temp.GetSize());
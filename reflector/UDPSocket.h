@@ -25,11 +25,13 @@
 #include <sys/socket.h>
 #include <sys/ioctl.h>
 #include <arpa/inet.h>
+#include <linux/filter.h>
+#include <vector>
 
 #include "IP.h"
 #include "Buffer.h"
 
-#define UDP_BUFFER_LENMAX       1024
+#define UDP_BUFFER_LENMAX       BUFFER_LENMAX
 
 class CUdpSocket
 {
@@ -41,7 +43,8 @@ public:
 	~CUdpSocket();
 
 	// open & close
-	bool Open(const CIp &Ip);
+	// with a filter, the kernel drops the datagrams it doesn't accept
+	bool Open(const CIp &Ip, const std::vector<struct sock_filter> *filter = nullptr);
 	void Close(void);
 	int  GetSocket(void)
 	{
@@ -27,8 +27,23 @@
 ////////////////////////////////////////////////////////////////////////////////////////
 // operation
 
+enum class EUrfPacket : unsigned { unknown, frame, header, keepalive, connect, disconnect, ack, nack };
+
+// the dv packets are sized by CDvHeaderPacket and CDvFramePacket, their parsers check that
+static constexpr SPacketRoute URFRoutes[] = {
+	{ EUrfPacket::frame,      "frame",      4, BUFFER_LENMAX, "URFF", true },
+	{ EUrfPacket::keepalive,  "keepalive", 10, 10, "PING" },
+	{ EUrfPacket::header,     "header",     4, BUFFER_LENMAX, "URFH", true },
+	{ EUrfPacket::connect,    "connect",   40, 40, "CONN" },
+	{ EUrfPacket::ack,        "ack",       40, 40, "ACKN" },
+	{ EUrfPacket::disconnect, "disconnect",10, 10, "DISC" },
+	{ EUrfPacket::nack,       "nack",      10, 10, "NACK" },
+};
+
 bool CURFProtocol::Initialize(const char *type, const EProtocol ptype, const uint16_t port, const bool has_ipv4, const bool has_ipv6)
 {
+	m_Router.SetRoutes("URF", URFRoutes);
+
 	if (! CProtocol::Initialize(type, ptype, port, has_ipv4, has_ipv6))
 		return false;
 
@@ -57,20 +72,23 @@ void CURFProtocol::Task(void)
 	// any incoming packet ?
 #if XLX_IPV6==true
 #if XLX_IPV4==true
-	if ( ReceiveDS(Buffer, Ip, 20) )
+	const bool received = ReceiveDS(Buffer, Ip, ReceiveTimeout(20));
 #else
-	if ( Receive6(Buffer, Ip, 20) )
+	const bool received = Receive6(Buffer, Ip, ReceiveTimeout(20));
 #endif
 #else
-	if ( Receive4(Buffer, Ip, 20) )
+	const bool received = Receive4(Buffer, Ip, ReceiveTimeout(20));
 #endif
+	unsigned route;
+	if ( NextPacket(received, Buffer, Ip, route) )
 	{
 		// crack the packet
-		if ( IsValidDvFramePacket(Buffer, Frame) )
+		const auto type = EUrfPacket(route);
+		if ( EUrfPacket::frame == type && IsValidDvFramePacket(Buffer, Frame) )
 		{
 			OnDvFramePacketIn(Frame, &Ip);
 		}
-		else if ( IsValidKeepAlivePacket(Buffer, &Callsign) )
+		else if ( EUrfPacket::keepalive == type && IsValidKeepAlivePacket(Buffer, &Callsign) )
 		{
 			// find peer
 			CPeers *peers = g_Reflector.GetPeers();
@@ -82,7 +100,7 @@ void CURFProtocol::Task(void)
 			}
 			g_Reflector.ReleasePeers();
 		}
-		else if ( IsValidDvHeaderPacket(Buffer, Header) )
+		else if ( EUrfPacket::header == type && IsValidDvHeaderPacket(Buffer, Header) )
 		{
 			// callsign allowed?
 			if ( g_GateKeeper.MayTransmit(Header->GetMyCallsign(), Ip) )
@@ -90,9 +108,9 @@ void CURFProtocol::Task(void)
 				OnDvHeaderPacketIn(Header, Ip);
 			}
 		}
-		else if ( IsValidConnectPacket(Buffer, &Callsign, Modules, &Version) )
+		else if ( EUrfPacket::connect == type && IsValidConnectPacket(Buffer, &Callsign, Modules, &Version) )
 		{
-			std::cout << "URF (" << Version.GetMajor() << "." << Version.GetMinor() << "." << Version.GetRevision() << ") connect packet for modules " << Modules << " from " << Callsign <<  " at " << Ip << std::endl;
+			CLogLine(ELogLevel::info, "urf-connect") << "URF (" << Version.GetMajor() << "." << Version.GetMinor() << "." << Version.GetRevision() << ") connect packet for modules " << Modules << " from " << Callsign <<  " at " << Ip;
 
 			// callsign authorized?
 			if ( g_GateKeeper.MayLink(Callsign, Ip, EProtocol::urf, Modules) )
@@ -118,9 +136,9 @@ void CURFProtocol::Task(void)
 				Send(Buffer, Ip);
 			}
 		}
-		else if ( IsValidAckPacket(Buffer, &Callsign, Modules, &Version)  )
+		else if ( EUrfPacket::ack == type && IsValidAckPacket(Buffer, &Callsign, Modules, &Version)  )
 		{
-			std::cout << "URF ack packet for modules " << Modules << " from " << Callsign << " at " << Ip << std::endl;
+			CLogLine(ELogLevel::info, "urf-ack") << "URF ack packet for modules " << Modules << " from " << Callsign << " at " << Ip;
 
 			// callsign authorized?
 			if ( g_GateKeeper.MayLink(Callsign, Ip, EProtocol::urf, Modules) )
@@ -140,9 +158,9 @@ void CURFProtocol::Task(void)
 				g_Reflector.ReleasePeers();
 			}
 		}
-		else if ( IsValidDisconnectPacket(Buffer, &Callsign) )
+		else if ( EUrfPacket::disconnect == type && IsValidDisconnectPacket(Buffer, &Callsign) )
 		{
-			std::cout << "URF disconnect packet from " << Callsign << " at " << Ip << std::endl;
+			CLogLine(ELogLevel::info, "urf-disconnect") << "URF disconnect packet from " << Callsign << " at " << Ip;
 
 			// find peer
 			CPeers *peers = g_Reflector.GetPeers();
@@ -156,15 +174,15 @@ void CURFProtocol::Task(void)
 			}
 			g_Reflector.ReleasePeers();
 		}
-		else if ( IsValidNackPacket(Buffer, &Callsign) )
+		else if ( EUrfPacket::nack == type && IsValidNackPacket(Buffer, &Callsign) )
 		{
-			std::cout << "URF nack packet from " << Callsign << " at " << Ip << std::endl;
+			CLogLine(ELogLevel::info, "urf-nack") << "URF nack packet from " << Callsign << " at " << Ip;
 		}
 		else
 		{
 			std::string title("Unknown URF packet from ");
 			title += Ip.GetAddress();
-			Buffer.Dump(title);
+			Dump(title.c_str(), Buffer.data(), Buffer.size());
 		}
 	}
 
@@ -272,7 +290,7 @@ void CURFProtocol::HandleKeepalives(void)
 			Send(disconnect, peer->GetIp());
 
 			// remove it
-			std::cout << "URF peer " << peer->GetCallsign() << " keepalive timeout" << std::endl;
+			CLogLine(ELogLevel::info, "urf-keepalive-timeout") << "URF peer " << peer->GetCallsign() << " keepalive timeout";
 			peers->RemovePeer(peer);
 		}
 	}
@@ -301,7 +319,7 @@ void CURFProtocol::HandlePeerLinks(void)
 			// send disconnect packet
 			EncodeDisconnectPacket(&buffer);
 			Send(buffer, peer->GetIp());
-			std::cout << "Sending disconnect packet to URF peer " << peer->GetCallsign() << std::endl;
+			CLogLine(ELogLevel::info, "urf-disconnect") << "Sending disconnect packet to URF peer " << peer->GetCallsign();
 			// remove client
 			peers->RemovePeer(peer);
 		}
@@ -350,7 +368,7 @@ void CURFProtocol::HandlePeerLinks(void)
 					// send connect packet to re-initiate peer link
 					EncodeConnectPacket(&buffer, it->second.GetModules().c_str());
 					Send(buffer, it->second.GetIp());
-					std::cout << "Sent connect packet to URF peer " << cs << " @ " << it->second.GetIp() << " for modules " << it->second.GetModules() << std::endl;
+					CLogLine(ELogLevel::info, "urf-connect") << "Sent connect packet to URF peer " << cs << " @ " << it->second.GetIp() << " for modules " << it->second.GetModules();
 #ifndef NO_DHT
 				}
 			}
@@ -428,7 +446,7 @@ void CURFProtocol::OnDvFramePacketIn(std::unique_ptr<CDvFramePacket> &DvFrame, c
 ////////////////////////////////////////////////////////////////////////////////////////
 // packet decoding helpers
 
-bool CURFProtocol::IsValidKeepAlivePacket(const CBuffer &Buffer, CCallsign *callsign)
+bool CURFProtocol::IsValidKeepAlivePacket(const CBufferView &Buffer, CCallsign *callsign)
 {
 	bool valid = false;
 	uint8_t magic[] = { 'P','I','N','G' };
@@ -441,7 +459,7 @@ bool CURFProtocol::IsValidKeepAlivePacket(const CBuffer &Buffer, CCallsign *call
 }
 
 
-bool CURFProtocol::IsValidConnectPacket(const CBuffer &Buffer, CCallsign *callsign, char *modules, CVersion *version)
+bool CURFProtocol::IsValidConnectPacket(const CBufferView &Buffer, CCallsign *callsign, char *modules, CVersion *version)
 {
 	bool valid = false;
 	uint8_t magic[] = { 'C','O','N','N' };
@@ -467,7 +485,7 @@ bool CURFProtocol::IsValidConnectPacket(const CBuffer &Buffer, CCallsign *callsi
 	return valid;
 }
 
-bool CURFProtocol::IsValidDisconnectPacket(const CBuffer &Buffer, CCallsign *callsign)
+bool CURFProtocol::IsValidDisconnectPacket(const CBufferView &Buffer, CCallsign *callsign)
 {
 	bool valid = false;
 	uint8_t magic[] = { 'D','I','S','C' };
@@ -479,7 +497,7 @@ bool CURFProtocol::IsValidDisconnectPacket(const CBuffer &Buffer, CCallsign *cal
 	return valid;
 }
 
-bool CURFProtocol::IsValidAckPacket(const CBuffer &Buffer, CCallsign *callsign, char *modules, CVersion *version)
+bool CURFProtocol::IsValidAckPacket(const CBufferView &Buffer, CCallsign *callsign, char *modules, CVersion *version)
 {
 	bool valid = false;
 	uint8_t magic[] = { 'A','C','K','N' };
@@ -497,7 +515,7 @@ bool CURFProtocol::IsValidAckPacket(const CBuffer &Buffer, CCallsign *callsign,
 	return valid;
 }
 
-bool CURFProtocol::IsValidNackPacket(const CBuffer &Buffer, CCallsign *callsign)
+bool CURFProtocol::IsValidNackPacket(const CBufferView &Buffer, CCallsign *callsign)
 {
 	bool valid = false;
 	uint8_t magic[] = { 'N','A','C','K' };
@@ -509,7 +527,7 @@ bool CURFProtocol::IsValidNackPacket(const CBuffer &Buffer, CCallsign *callsign)
 	return valid;
 }
 
-bool CURFProtocol::IsValidDvHeaderPacket(const CBuffer &Buffer, std::unique_ptr<CDvHeaderPacket> &header)
+bool CURFProtocol::IsValidDvHeaderPacket(const CBufferView &Buffer, std::unique_ptr<CDvHeaderPacket> &header)
 {
 	uint8_t magic[] = { 'U', 'R', 'F', 'H' };
 	if (Buffer.size()==CDvHeaderPacket::GetNetworkSize() && 0==Buffer.Compare(magic, 4))
@@ -526,7 +544,7 @@ bool CURFProtocol::IsValidDvHeaderPacket(const CBuffer &Buffer, std::unique_ptr<
 	return false;
 }
 
-bool CURFProtocol::IsValidDvFramePacket(const CBuffer &Buffer, std::unique_ptr<CDvFramePacket> &dvframe)
+bool CURFProtocol::IsValidDvFramePacket(const CBufferView &Buffer, std::unique_ptr<CDvFramePacket> &dvframe)
 {
 	uint8_t magic[] = { 'U', 'R', 'F', 'F' };
 	if (Buffer.size()==CDvFramePacket::GetNetworkSize() && 0==Buffer.Compare(magic, 4))
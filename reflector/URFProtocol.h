@@ -48,13 +48,13 @@ protected:
 	void OnDvFramePacketIn(std::unique_ptr<CDvFramePacket> &, const CIp * = nullptr);
 
 	// packet decoding helpers
-	bool IsValidKeepAlivePacket(const CBuffer &, CCallsign *);
-	bool IsValidConnectPacket(const CBuffer &, CCallsign *, char *, CVersion *);
-	bool IsValidDisconnectPacket(const CBuffer &, CCallsign *);
-	bool IsValidAckPacket(const CBuffer &, CCallsign *, char *, CVersion *);
-	bool IsValidNackPacket(const CBuffer &, CCallsign *);
-	bool IsValidDvHeaderPacket(const CBuffer &, std::unique_ptr<CDvHeaderPacket> &);
-	bool IsValidDvFramePacket(const CBuffer &, std::unique_ptr<CDvFramePacket> &);
+	bool IsValidKeepAlivePacket(const CBufferView &, CCallsign *);
+	bool IsValidConnectPacket(const CBufferView &, CCallsign *, char *, CVersion *);
+	bool IsValidDisconnectPacket(const CBufferView &, CCallsign *);
+	bool IsValidAckPacket(const CBufferView &, CCallsign *, char *, CVersion *);
+	bool IsValidNackPacket(const CBufferView &, CCallsign *);
+	bool IsValidDvHeaderPacket(const CBufferView &, std::unique_ptr<CDvHeaderPacket> &);
+	bool IsValidDvFramePacket(const CBufferView &, std::unique_ptr<CDvFramePacket> &);
 
 	// packet encoding helpers
 	void EncodeKeepAlivePacket(CBuffer *);
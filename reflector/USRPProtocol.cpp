@@ -164,7 +164,7 @@ void CUSRPProtocol::Task(void)
 			// invalid packet
 			std::string title("Unknown USRP packet from ");
 			title += Ip.GetAddress();
-			Buffer.Dump(title);
+			Dump(title.c_str(), Buffer.data(), Buffer.size());
 		}
 	}
 
@@ -283,7 +283,7 @@ void CUSRPProtocol::HandleQueue(void)
 ////////////////////////////////////////////////////////////////////////////////////////
 // packet decoding helpers
 
-bool CUSRPProtocol::IsValidDvPacket(const CIp &Ip, const CBuffer &Buffer, std::unique_ptr<CDvHeaderPacket> &header, std::unique_ptr<CDvFramePacket> &frame)
+bool CUSRPProtocol::IsValidDvPacket(const CIp &Ip, const CBufferView &Buffer, std::unique_ptr<CDvHeaderPacket> &header, std::unique_ptr<CDvFramePacket> &frame)
 {
 	if(!memcmp(Buffer.data(), "USRP", 4) && (Buffer.size() == 352) && (Buffer.data()[20] == USRP_TYPE_VOICE) && (Buffer.data()[15] == USRP_KEYUP_TRUE) )
 	{
@@ -311,7 +311,7 @@ bool CUSRPProtocol::IsValidDvPacket(const CIp &Ip, const CBuffer &Buffer, std::u
 	return false;
 }
 
-bool CUSRPProtocol::IsValidDvHeaderPacket(const CIp &Ip, const CBuffer &Buffer, std::unique_ptr<CDvHeaderPacket> &header)
+bool CUSRPProtocol::IsValidDvHeaderPacket(const CIp &Ip, const CBufferView &Buffer, std::unique_ptr<CDvHeaderPacket> &header)
 {
 	if(!memcmp(Buffer.data(), "USRP", 4) && (Buffer.size() == 352) && (Buffer.data()[20] == USRP_TYPE_TEXT) && (Buffer.data()[32] == TLV_TAG_SET_INFO) ){
 		auto stream = GetStream(m_uiStreamId, &Ip);
@@ -331,7 +331,7 @@ bool CUSRPProtocol::IsValidDvHeaderPacket(const CIp &Ip, const CBuffer &Buffer,
 	return false;
 }
 
-bool CUSRPProtocol::IsValidDvLastPacket(const CBuffer &Buffer)
+bool CUSRPProtocol::IsValidDvLastPacket(const CBufferView &Buffer)
 {
 	if(!memcmp(Buffer.data(), "USRP", 4) && (Buffer.size() == 32) && (Buffer.data()[15] == USRP_KEYUP_FALSE) )
 	{
@@ -53,9 +53,9 @@ protected:
 	void OnDvHeaderPacketIn(std::unique_ptr<CDvHeaderPacket> &, const CIp &);
 
 	// packet decoding helpers
-	bool IsValidDvPacket(const CIp &, const CBuffer &, std::unique_ptr<CDvHeaderPacket> &, std::unique_ptr<CDvFramePacket> &);
-	bool IsValidDvHeaderPacket(const CIp &, const CBuffer &, std::unique_ptr<CDvHeaderPacket> &);
-	bool IsValidDvLastPacket(const CBuffer &);
+	bool IsValidDvPacket(const CIp &, const CBufferView &, std::unique_ptr<CDvHeaderPacket> &, std::unique_ptr<CDvFramePacket> &);
+	bool IsValidDvHeaderPacket(const CIp &, const CBufferView &, std::unique_ptr<CDvHeaderPacket> &);
+	bool IsValidDvLastPacket(const CBufferView &);
 
 	// packet encoding helpers
 	void EncodeUSRPHeaderPacket(const CDvHeaderPacket &, uint32_t, CBuffer &) const;
@@ -61,7 +61,7 @@ bool CUser::operator <(const CUser &user) const
 ////////////////////////////////////////////////////////////////////////////////////////
 // reporting
 
-void CUser::WriteXml(std::ofstream &xmlFile)
+void CUser::WriteXml(std::ostream &xmlFile) const
 {
 	xmlFile << "<STATION>" << std::endl;
 	xmlFile << "\t<Callsign>" << m_My << "</Callsign>" << std::endl;
@@ -77,7 +77,7 @@ void CUser::WriteXml(std::ofstream &xmlFile)
 	xmlFile << "</STATION>" << std::endl;
 }
 
-void CUser::JsonReport(nlohmann::json &report)
+void CUser::JsonReport(nlohmann::json &report) const
 {
 	nlohmann::json juser;
 	juser["Callsign"] = m_My.GetCS();
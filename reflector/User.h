@@ -49,8 +49,8 @@ public:
 	bool operator <(const CUser &) const;
 
 	// reporting
-	void WriteXml(std::ofstream &);
-	void JsonReport(nlohmann::json &report);
+	void WriteXml(std::ostream &) const;
+	void JsonReport(nlohmann::json &report) const;
 
 protected:
 	// data
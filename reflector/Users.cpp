@@ -23,7 +23,7 @@
 ////////////////////////////////////////////////////////////////////////////////////////
 // constructor
 
-CUsers::CUsers() {}
+CUsers::CUsers() : m_Generation(0) {}
 
 ////////////////////////////////////////////////////////////////////////////////////////
 // users management
@@ -39,6 +39,7 @@ void CUsers::AddUser(const CUser &user)
 	{
 		m_Users.resize(m_Users.size()-1);
 	}
+	m_Generation.fetch_add(1, std::memory_order_release);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////
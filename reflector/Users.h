@@ -18,6 +18,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <list>
 #include <mutex>
 
@@ -40,6 +41,9 @@ public:
 	int    GetSize(void) const          { return (int)m_Users.size(); }
 	void   AddUser(const CUser &);
 
+	// reporting, counts the changes the status files would show
+	uint32_t GetGeneration(void) const  { return m_Generation.load(std::memory_order_acquire); }
+
 	// pass-through
 	std::list<CUser>::iterator begin()              { return m_Users.begin(); }
 	std::list<CUser>::iterator end()                { return m_Users.end(); }
@@ -54,4 +58,5 @@ protected:
 	// data
 	std::mutex        m_Mutex;
 	std::list<CUser>  m_Users;
+	std::atomic<uint32_t> m_Generation;
 };
@@ -158,7 +158,7 @@ void CYsfProtocol::Task(void)
 				// client already connected ?
 				if ( client == nullptr )
 				{
-					std::cout << "YSF connect packet from " << Callsign << " at " << Ip << std::endl;
+					CLogLine(ELogLevel::info, "ysf-connect") << "YSF connect packet from " << Callsign << " at " << Ip;
 
 					// create the client
 					auto newclient = std::make_shared<CYsfClient>(Callsign, Ip);
@@ -180,7 +180,7 @@ void CYsfProtocol::Task(void)
 		}
 		else if ( IsValidDisconnectPacket(Buffer) )
 		{
-			std::cout << "YSF disconnect packet from " << Ip << std::endl;
+			CLogLine(ELogLevel::info, "ysf-disconnect") << "YSF disconnect packet from " << Ip;
 
 			// find client
 			CClients *clients = g_Reflector.GetClients();
@@ -205,7 +205,7 @@ void CYsfProtocol::Task(void)
 		}
 		else if ( IsValidServerStatusPacket(Buffer) )
 		{
-			std::cout << "YSF server status enquiry from " << Ip << std::endl;
+			CLogLine(ELogLevel::info, "ysf-status") << "YSF server status enquiry from " << Ip;
 			// reply
 			EncodeServerStatusPacket(&Buffer);
 			Send(Buffer, Ip);
@@ -227,7 +227,7 @@ void CYsfProtocol::Task(void)
 #ifdef DEBUG
 			std::string title("Unknown YSF packet from ");
 			title += Ip.GetAddress();
-			Buffer.Dump(title);
+			Dump(title.c_str(), Buffer.data(), Buffer.size());
 #endif
 		}
 	}
@@ -321,6 +321,7 @@ void CYsfProtocol::HandleQueue(void)
 			// update local stream cache
 			// this relies on queue feeder setting valid module id
 			m_StreamsCache[mod].m_dvHeader = CDvHeaderPacket((CDvHeaderPacket &)*packet.get());
+			EncodeStreamTemplates(m_StreamsCache[mod]);
 
 			// encode it
 			EncodeYSFHeaderPacket((CDvHeaderPacket &)*packet.get(), &buffer);
@@ -343,7 +344,7 @@ void CYsfProtocol::HandleQueue(void)
 				if ( sid == 4 )
 				{
 
-					EncodeYSFPacket(m_StreamsCache[mod].m_dvHeader, m_StreamsCache[mod].m_dvFrames, &buffer);
+					EncodeYSFPacket(m_StreamsCache[mod], &buffer);
 				}
 			}
 		}
@@ -395,7 +396,7 @@ void CYsfProtocol::HandleKeepalives(void)
 		else if ( !client->IsAlive() )
 		{
 			// no, remove it
-			std::cout << "YSF client " << client->GetCallsign() << " keepalive timeout" << std::endl;
+			CLogLine(ELogLevel::info, "ysf-keepalive-timeout") << "YSF client " << client->GetCallsign() << " keepalive timeout";
 			clients->RemoveClient(client);
 		}
 
@@ -406,7 +407,7 @@ void CYsfProtocol::HandleKeepalives(void)
 ////////////////////////////////////////////////////////////////////////////////////////
 // DV packet decoding helpers
 
-bool CYsfProtocol::IsValidConnectPacket(const CBuffer &Buffer, CCallsign *callsign)
+bool CYsfProtocol::IsValidConnectPacket(const CBufferView &Buffer, CCallsign *callsign)
 {
 	uint8_t tag[] = { 'Y','S','F','P' };
 
@@ -420,7 +421,7 @@ bool CYsfProtocol::IsValidConnectPacket(const CBuffer &Buffer, CCallsign *callsi
 	return valid;
 }
 
-bool CYsfProtocol::IsValidDisconnectPacket(const CBuffer &Buffer)
+bool CYsfProtocol::IsValidDisconnectPacket(const CBufferView &Buffer)
 {
 	uint8_t tag[] = { 'Y','S','F','U' };
 
@@ -431,7 +432,7 @@ bool CYsfProtocol::IsValidDisconnectPacket(const CBuffer &Buffer)
 	return false;
 }
 
-bool CYsfProtocol::IsValidDvPacket(const CBuffer &Buffer, CYSFFICH *Fich)
+bool CYsfProtocol::IsValidDvPacket(const CBufferView &Buffer, CYSFFICH *Fich)
 {
 	uint8_t tag[] = { 'Y','S','F','D' };
 
@@ -449,7 +450,7 @@ bool CYsfProtocol::IsValidDvPacket(const CBuffer &Buffer, CYSFFICH *Fich)
 }
 
 
-bool CYsfProtocol::IsValidDvHeaderPacket(const CIp &Ip, const CYSFFICH &Fich, const CBuffer &Buffer, std::unique_ptr<CDvHeaderPacket> &header, std::array<std::unique_ptr<CDvFramePacket>, 5> &frames)
+bool CYsfProtocol::IsValidDvHeaderPacket(const CIp &Ip, const CYSFFICH &Fich, const CBufferView &Buffer, std::unique_ptr<CDvHeaderPacket> &header, std::array<std::unique_ptr<CDvFramePacket>, 5> &frames)
 {
 	CCallsign csMY;
 	// DV header ?
@@ -503,7 +504,7 @@ bool CYsfProtocol::IsValidDvHeaderPacket(const CIp &Ip, const CYSFFICH &Fich, co
 	return false;
 }
 
-bool CYsfProtocol::IsValidDvFramePacket(const CIp &Ip, const CYSFFICH &Fich, const CBuffer &Buffer, std::unique_ptr<CDvHeaderPacket> &header, std::array<std::unique_ptr<CDvFramePacket>, 5> &frames)
+bool CYsfProtocol::IsValidDvFramePacket(const CIp &Ip, const CYSFFICH &Fich, const CBufferView &Buffer, std::unique_ptr<CDvHeaderPacket> &header, std::array<std::unique_ptr<CDvFramePacket>, 5> &frames)
 {
 	// is it DV frame ?
 	if ( Fich.getFI() == YSF_FI_COMMUNICATIONS )
@@ -514,7 +515,7 @@ bool CYsfProtocol::IsValidDvFramePacket(const CIp &Ip, const CYSFFICH &Fich, con
 		auto stream = GetStream(uiStreamId, &Ip);
 		if ( !stream )
 		{
-			std::cerr << "Late entry YSF voice frame, creating YSF header on " << Ip << std::endl;
+			CLogLine(ELogLevel::info, "ysf-late-entry") << "Late entry YSF voice frame, creating YSF header on " << Ip;
 			CCallsign csMY;
 			char sz[YSF_CALLSIGN_LENGTH+1];
 			memcpy(sz, &(Buffer.data()[14]), YSF_CALLSIGN_LENGTH);
@@ -577,7 +578,7 @@ bool CYsfProtocol::IsValidDvFramePacket(const CIp &Ip, const CYSFFICH &Fich, con
 	return false;
 }
 
-bool CYsfProtocol::IsValidDvLastFramePacket(const CIp &Ip, const CYSFFICH &Fich, const CBuffer &Buffer, std::unique_ptr<CDvFramePacket> &oneframe, std::unique_ptr<CDvFramePacket> &lastframe)
+bool CYsfProtocol::IsValidDvLastFramePacket(const CIp &Ip, const CYSFFICH &Fich, const CBufferView &Buffer, std::unique_ptr<CDvFramePacket> &oneframe, std::unique_ptr<CDvFramePacket> &lastframe)
 {
 	// DV header ?
 	if ( Fich.getFI() == YSF_FI_TERMINATOR )
@@ -678,98 +679,109 @@ bool CYsfProtocol::EncodeYSFHeaderPacket(const CDvHeaderPacket &Header, CBuffer
 	return true;
 }
 
-bool CYsfProtocol::EncodeYSFPacket(const CDvHeaderPacket &Header, const CDvFramePacket *DvFrames, CBuffer *Buffer) const
+bool CYsfProtocol::EncodeYSFPacket(const CYsfStreamCacheItem &Cache, CBuffer *Buffer) const
 {
-	uint8_t tag[]  = { 'Y','S','F','D' };
-	uint8_t dest[] = { 'A','L','L',' ',' ',' ',' ',' ',' ',' ' };
-	uint8_t gps[]  = { 0x52,0x22,0x61,0x5F,0x27,0x03,0x5E,0x20,0x20,0x20 };
-	char  sz[YSF_CALLSIGN_LENGTH];
-	uint8_t fichd[YSF_FICH_LENGTH_BYTES];
+	const CDvFramePacket *DvFrames = Cache.m_dvFrames;
+	const uint8_t fn = DvFrames[0].GetYsfPacketId() & 0x07U;
 
-	// tag
-	Buffer->Set(tag, sizeof(tag));
-	// rpt1
-	memset(sz, ' ', sizeof(sz));
-	Header.GetRpt1Callsign().GetCallsignString(sz);
-	sz[::strlen(sz)] = ' ';
-	Buffer->Append((uint8_t *)sz, YSF_CALLSIGN_LENGTH);
-	// my
-	memset(sz, ' ', sizeof(sz));
-	Header.GetMyCallsign().GetCallsignString(sz);
-	sz[::strlen(sz)] = ' ';
-	Buffer->Append((uint8_t *)sz, YSF_CALLSIGN_LENGTH);
-	// dest
-	Buffer->Append(dest, 10);
+	// tag, rpt1, my, dest and FS from the stream's template
+	Buffer->Set((uint8_t *)Cache.m_Voice, YSF_PACKET_SIZE);
+	uint8_t *data = Buffer->data();
 	// net frame counter
-	Buffer->Append(DvFrames[0].GetYsfPacketFrameId());
-	// FS
-	Buffer->Append((uint8_t *)YSF_SYNC_BYTES, YSF_SYNC_LENGTH_BYTES);
+	data[34] = DvFrames[0].GetYsfPacketFrameId();
 	// FICH
-	CYSFFICH fich;
-	fich.setFI(YSF_FI_COMMUNICATIONS);
-	fich.setCS(2U);
-	fich.setFN(DvFrames[0].GetYsfPacketId());
-	fich.setFT(6U);
-	fich.setDev(0U);
-	fich.setMR(YSF_MR_BUSY);
-	fich.setDT(YSF_DT_VD_MODE2);
-	fich.setSQL(0U);
-	fich.setSQ(0U);
-	fich.encode(fichd);
-	Buffer->Append(fichd, YSF_FICH_LENGTH_BYTES);
-	// payload
-	CYSFPayload payload;
-	uint8_t temp[120];
-	memset(temp, 0x00, sizeof(temp));
-	// DV
+	memcpy(data+35+YSF_SYNC_LENGTH_BYTES, Cache.m_Fich[fn], YSF_FICH_LENGTH_BYTES);
+	// payload, each of the 5 channels is 5 bytes of DT and a 13 byte VCH
+	uint8_t *p = data+35+YSF_SYNC_LENGTH_BYTES+YSF_FICH_LENGTH_BYTES;
 	for ( int i = 0; i < 5; i++ )
 	{
-		CYsfUtils::EncodeVD2Vch((unsigned char *)DvFrames[i].GetCodecData(ECodecType::dmr), temp+35+(18*i));
-	}
-	// data
-	switch (DvFrames[0].GetYsfPacketId())
-	{
-	case 0:
-		// Dest
-		payload.writeVDMode2Data(temp, (const unsigned char*)"**********");
-		break;
-	case 1:
-		// Src
-		memset(sz, ' ', sizeof(sz));
-		Header.GetMyCallsign().GetCallsignString(sz);
-		sz[::strlen(sz)] = ' ';
-		payload.writeVDMode2Data(temp, (const unsigned char*)sz);
-		break;
-	case 2:
-		// Down
-		memset(sz, ' ', sizeof(sz));
-		Header.GetRpt1Callsign().GetCallsignString(sz);
-		sz[::strlen(sz)] = ' ';
-		payload.writeVDMode2Data(temp, (const unsigned char*)sz);
-		break;
-	case 5:
-		// Rem3+4
-		// we need to provide a fake radioid for radios
-		// to display src callsign
-		payload.writeVDMode2Data(temp, (const unsigned char*)"     G0gBJ");
-		break;
-	case 6:
-		// DT1
-		// we need to issue a fake gps string with proper terminator
-		// and crc for radios to display src callsign
-		payload.writeVDMode2Data(temp, gps);
-		break;
-	default:
-		payload.writeVDMode2Data(temp, (const unsigned char*)"          ");
-		break;
-
+		memcpy(p+(18*i), Cache.m_DT[fn]+(5*i), 5);
+		CYsfUtils::EncodeVD2Vch((unsigned char *)DvFrames[i].GetCodecData(ECodecType::dmr), p+(18*i)+5);
 	}
-	Buffer->Append(temp+30, 120-30);
 
 	// done
 	return true;
 }
 
+void CYsfProtocol::EncodeStreamTemplates(CYsfStreamCacheItem &Cache) const
+{
+	const CDvHeaderPacket &Header = Cache.m_dvHeader;
+	uint8_t tag[]  = { 'Y','S','F','D' };
+	uint8_t dest[] = { 'A','L','L',' ',' ',' ',' ',' ',' ',' ' };
+	uint8_t gps[]  = { 0x52,0x22,0x61,0x5F,0x27,0x03,0x5E,0x20,0x20,0x20 };
+	char  my[YSF_CALLSIGN_LENGTH], rpt1[YSF_CALLSIGN_LENGTH];
+
+	memset(rpt1, ' ', sizeof(rpt1));
+	Header.GetRpt1Callsign().GetCallsignString(rpt1);
+	rpt1[::strlen(rpt1)] = ' ';
+	memset(my, ' ', sizeof(my));
+	Header.GetMyCallsign().GetCallsignString(my);
+	my[::strlen(my)] = ' ';
+
+	// voice packet template, the counter, FICH and payload are filled in for each packet
+	uint8_t *data = Cache.m_Voice;
+	memset(data, 0, YSF_PACKET_SIZE);
+	memcpy(data, tag, sizeof(tag));
+	memcpy(data+4, rpt1, YSF_CALLSIGN_LENGTH);
+	memcpy(data+14, my, YSF_CALLSIGN_LENGTH);
+	memcpy(data+24, dest, 10);
+	memcpy(data+35, YSF_SYNC_BYTES, YSF_SYNC_LENGTH_BYTES);
+
+	// FICH and DT for each FN
+	CYSFPayload payload;
+	for ( uint8_t fn = 0; fn < 8; fn++ )
+	{
+		CYSFFICH fich;
+		fich.setFI(YSF_FI_COMMUNICATIONS);
+		fich.setCS(2U);
+		fich.setFN(fn);
+		fich.setFT(6U);
+		fich.setDev(0U);
+		fich.setMR(YSF_MR_BUSY);
+		fich.setDT(YSF_DT_VD_MODE2);
+		fich.setSQL(0U);
+		fich.setSQ(0U);
+		fich.encode(Cache.m_Fich[fn]);
+
+		uint8_t temp[120];
+		memset(temp, 0x00, sizeof(temp));
+		switch (fn)
+		{
+		case 0:
+			// Dest
+			payload.writeVDMode2Data(temp, (const unsigned char*)"**********");
+			break;
+		case 1:
+			// Src
+			payload.writeVDMode2Data(temp, (const unsigned char*)my);
+			break;
+		case 2:
+			// Down
+			payload.writeVDMode2Data(temp, (const unsigned char*)rpt1);
+			break;
+		case 5:
+			// Rem3+4
+			// we need to provide a fake radioid for radios
+			// to display src callsign
+			payload.writeVDMode2Data(temp, (const unsigned char*)"     G0gBJ");
+			break;
+		case 6:
+			// DT1
+			// we need to issue a fake gps string with proper terminator
+			// and crc for radios to display src callsign
+			payload.writeVDMode2Data(temp, gps);
+			break;
+		default:
+			payload.writeVDMode2Data(temp, (const unsigned char*)"          ");
+			break;
+		}
+		for ( int i = 0; i < 5; i++ )
+		{
+			memcpy(Cache.m_DT[fn]+(5*i), temp+30+(18*i), 5);
+		}
+	}
+}
+
 bool CYsfProtocol::EncodeLastYSFPacket(const CDvHeaderPacket &Header, CBuffer *Buffer) const
 {
 	uint8_t tag[]  = { 'Y','S','F','D' };
@@ -828,7 +840,7 @@ bool CYsfProtocol::EncodeLastYSFPacket(const CDvHeaderPacket &Header, CBuffer *B
 ////////////////////////////////////////////////////////////////////////////////////////
 // Wires-X packet decoding helpers
 
-bool CYsfProtocol::IsValidwirexPacket(const CBuffer &Buffer, CYSFFICH *Fich, CCallsign *Callsign, int *Cmd, int *Arg)
+bool CYsfProtocol::IsValidwirexPacket(const CBufferView &Buffer, CYSFFICH *Fich, CCallsign *Callsign, int *Cmd, int *Arg)
 {
 	uint8_t tag[] = { 'Y','S','F','D' };
 	uint8_t DX_REQ[]    = {0x5DU, 0x71U, 0x5FU};
@@ -886,7 +898,7 @@ bool CYsfProtocol::IsValidwirexPacket(const CBuffer &Buffer, CYSFFICH *Fich, CCa
 								valid = true;
 #ifdef DEBUG
 								if (! valid)
-									std::cout << "WiresX command CRC failed:" << (int)crc << " != " << (int)command[i + 1U] << std::endl;
+									CLogLine(ELogLevel::warning, "ysf-wiresx-crc") << "WiresX command CRC failed:" << (int)crc << " != " << (int)command[i + 1U];
 #endif
 							}
 							break;
@@ -949,7 +961,7 @@ bool CYsfProtocol::IsValidwirexPacket(const CBuffer &Buffer, CYSFFICH *Fich, CCa
 
 // server status packet decoding helpers
 
-bool CYsfProtocol::IsValidServerStatusPacket(const CBuffer &Buffer) const
+bool CYsfProtocol::IsValidServerStatusPacket(const CBufferView &Buffer) const
 {
 	uint8_t tag[] = { 'Y','S','F','S' };
 
@@ -958,7 +970,7 @@ bool CYsfProtocol::IsValidServerStatusPacket(const CBuffer &Buffer) const
 
 // Info packet sent by some clients -- currently ignored by YSFReflector
 
-bool CYsfProtocol::IsValidInfoPacket(const CBuffer &Buffer) const
+bool CYsfProtocol::IsValidInfoPacket(const CBufferView &Buffer) const
 {
 	uint8_t tag[] = { 'Y','S','F','I' };
 
@@ -967,14 +979,14 @@ bool CYsfProtocol::IsValidInfoPacket(const CBuffer &Buffer) const
 
 // Valid packet sent by registry as an ACK response to a server status reply from reflector
 
-bool CYsfProtocol::IsValidAckPacket(const CBuffer &Buffer) const
+bool CYsfProtocol::IsValidAckPacket(const CBufferView &Buffer) const
 {
 	uint8_t tag[] = { 'Y','S','F','V' };
 
 	return ( (Buffer.size() >= 4) && (Buffer.Compare(tag, sizeof(tag)) == 0) );
 }
 
-bool CYsfProtocol::IsValidOptionsPacket(const CBuffer &Buffer) const
+bool CYsfProtocol::IsValidOptionsPacket(const CBufferView &Buffer) const
 {
 	uint8_t tag[] = { 'Y','S','F','O' };
 
@@ -43,6 +43,10 @@
 // YSF Module ID
 #define YSF_MODULE_ID             'B'
 
+// YSFD packet
+#define YSF_PACKET_SIZE           155
+#define YSF_DT_SIZE               25
+
 ////////////////////////////////////////////////////////////////////////////////////////
 // class
 
@@ -55,6 +59,11 @@ public:
 	CDvHeaderPacket m_dvHeader;
 	CDvFramePacket  m_dvFrames[5];
 
+	// encoded once when the header arrives, only the FN changes between voice packets
+	uint8_t m_Voice[YSF_PACKET_SIZE];           // tag, callsigns and sync
+	uint8_t m_Fich[8][YSF_FICH_LENGTH_BYTES];   // FICH for each FN
+	uint8_t m_DT[8][YSF_DT_SIZE];               // VD mode 2 DT for each FN, 5 bytes in each of the 5 channels
+
 	//uint8_t  m_uiSeqId;
 };
 
@@ -82,29 +91,30 @@ protected:
 	void OnDvHeaderPacketIn(std::unique_ptr<CDvHeaderPacket> &, const CIp &);
 
 	// DV packet decoding helpers
-	bool IsValidConnectPacket(const CBuffer &, CCallsign *);
-	bool IsValidDisconnectPacket(const CBuffer &);
-	bool IsValidDvPacket(const CBuffer &, CYSFFICH *);
-	bool IsValidDvHeaderPacket(const CIp &, const CYSFFICH &, const CBuffer &, std::unique_ptr<CDvHeaderPacket> &, std::array<std::unique_ptr<CDvFramePacket>, 5> &);
-	bool IsValidDvFramePacket(const CIp &, const CYSFFICH &, const CBuffer &, std::unique_ptr<CDvHeaderPacket> &, std::array<std::unique_ptr<CDvFramePacket>, 5> &);
-	bool IsValidDvLastFramePacket(const CIp &, const CYSFFICH &, const CBuffer &, std::unique_ptr<CDvFramePacket> &, std::unique_ptr<CDvFramePacket> &);
+	bool IsValidConnectPacket(const CBufferView &, CCallsign *);
+	bool IsValidDisconnectPacket(const CBufferView &);
+	bool IsValidDvPacket(const CBufferView &, CYSFFICH *);
+	bool IsValidDvHeaderPacket(const CIp &, const CYSFFICH &, const CBufferView &, std::unique_ptr<CDvHeaderPacket> &, std::array<std::unique_ptr<CDvFramePacket>, 5> &);
+	bool IsValidDvFramePacket(const CIp &, const CYSFFICH &, const CBufferView &, std::unique_ptr<CDvHeaderPacket> &, std::array<std::unique_ptr<CDvFramePacket>, 5> &);
+	bool IsValidDvLastFramePacket(const CIp &, const CYSFFICH &, const CBufferView &, std::unique_ptr<CDvFramePacket> &, std::unique_ptr<CDvFramePacket> &);
 
 	// DV packet encoding helpers
 	void EncodeConnectAckPacket(CBuffer *) const;
 	//void EncodeConnectNackPacket(const CCallsign &, char, CBuffer *);
 	//void EncodeDisconnectPacket(CBuffer *, std::shared_ptr<CClient>);
 	bool EncodeYSFHeaderPacket(const CDvHeaderPacket &, CBuffer *) const;
-	bool EncodeYSFPacket(const CDvHeaderPacket &, const CDvFramePacket *, CBuffer *) const;
+	bool EncodeYSFPacket(const CYsfStreamCacheItem &, CBuffer *) const;
+	void EncodeStreamTemplates(CYsfStreamCacheItem &) const;
 	bool EncodeLastYSFPacket(const CDvHeaderPacket &, CBuffer *) const;
 
 	// Wires-X packet decoding helpers
-	bool IsValidwirexPacket(const CBuffer &, CYSFFICH *, CCallsign *, int *, int*);
+	bool IsValidwirexPacket(const CBufferView &, CYSFFICH *, CCallsign *, int *, int*);
 
 	// server status packet decoding helpers
-	bool IsValidServerStatusPacket(const CBuffer &) const;
-	bool IsValidInfoPacket(const CBuffer &) const;
-	bool IsValidAckPacket(const CBuffer &) const;
-	bool IsValidOptionsPacket(const CBuffer &) const;
+	bool IsValidServerStatusPacket(const CBufferView &) const;
+	bool IsValidInfoPacket(const CBufferView &) const;
+	bool IsValidAckPacket(const CBufferView &) const;
+	bool IsValidOptionsPacket(const CBufferView &) const;
 	uint32_t CalcHash(const uint8_t *, int) const;
 
 	// server status packet encoding helpers
@@ -22,7 +22,7 @@
 #include <string.h>
 #include "YSFDefines.h"
 #include "YSFUtils.h"
-#include "Golay24128.h"
+#include "DMRAmbe.h"
 
 void CYsfUtils::DecodeVD2Vchs(uint8_t *data, uint8_t **ambe)
 {
@@ -83,32 +83,7 @@ void CYsfUtils::DecodeVD2Vchs(uint8_t *data, uint8_t **ambe)
 
 		// convert to ambe2plus
 		unsigned char v_dmr[9U];
-
-		unsigned int a = CGolay24128::encode24128(dat_a);
-		unsigned int p = PRNG_TABLE[dat_a] >> 1;
-		unsigned int b = CGolay24128::encode23127(dat_b) >> 1;
-		b ^= p;
-
-		unsigned int MASK = 0x800000U;
-		for (unsigned int i = 0U; i < 24U; i++, MASK >>= 1)
-		{
-			unsigned int aPos = DMR_A_TABLE[i];
-			WRITE_BIT(v_dmr, aPos, a & MASK);
-		}
-
-		MASK = 0x400000U;
-		for (unsigned int i = 0U; i < 23U; i++, MASK >>= 1)
-		{
-			unsigned int bPos = DMR_B_TABLE[i];
-			WRITE_BIT(v_dmr, bPos, b & MASK);
-		}
-
-		MASK = 0x1000000U;
-		for (unsigned int i = 0U; i < 25U; i++, MASK >>= 1)
-		{
-			unsigned int cPos = DMR_C_TABLE[i];
-			WRITE_BIT(v_dmr, cPos, dat_c & MASK);
-		}
+		CDmrAmbe::Encode(dat_a, dat_b, dat_c, v_dmr);
 
 		memcpy(ambe[frame++], v_dmr, 9);
 	}
@@ -117,35 +92,8 @@ void CYsfUtils::DecodeVD2Vchs(uint8_t *data, uint8_t **ambe)
 void CYsfUtils::EncodeVD2Vch(uint8_t *ambe, uint8_t *data)
 {
 	// convert from ambe2plus
-	unsigned int a = 0U;
-	unsigned int MASK = 0x800000U;
-	for (unsigned int i = 0U; i < 24U; i++, MASK >>= 1)
-	{
-		unsigned int aPos = DMR_A_TABLE[i];
-
-		if (READ_BIT(ambe, aPos))
-			a |= MASK;
-	}
-
-	unsigned int b = 0U;
-	MASK = 0x400000U;
-	for (unsigned int i = 0U; i < 23U; i++, MASK >>= 1)
-	{
-		unsigned int bPos = DMR_B_TABLE[i];
-
-		if (READ_BIT(ambe, bPos))
-			b |= MASK;
-	}
-
-	unsigned int dat_c = 0U;
-	MASK = 0x1000000U;
-	for (unsigned int i = 0U; i < 25U; i++, MASK >>= 1)
-	{
-		unsigned int cPos = DMR_C_TABLE[i];
-
-		if (READ_BIT(ambe, cPos))
-			dat_c |= MASK;
-	}
+	unsigned int dat_a, dat_b, dat_c;
+	CDmrAmbe::Decode(ambe, dat_a, dat_b, dat_c);
 
 	// and to vch
 	unsigned char vch[13U];
@@ -153,13 +101,6 @@ void CYsfUtils::EncodeVD2Vch(uint8_t *ambe, uint8_t *data)
 	memset(vch, 0U, 13U);
 	memset(ysfFrame, 0, 13U);
 
-	unsigned int dat_a = a >> 12;
-
-	// The PRNG
-	b ^= (PRNG_TABLE[dat_a] >> 1);
-
-	unsigned int dat_b = b >> 11;
-
 	for (unsigned int i = 0U; i < 12U; i++)
 	{
 		bool s = (dat_a << (20U + i)) & 0x80000000U;
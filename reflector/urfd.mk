@@ -0,0 +1,9 @@
+# this is where the binary will be installed
+BINDIR = /usr/local/bin
+
+# besides making an executable that gdb can use,
+# this will also provide some additional log messsage
+debug = false
+
+# To disable DHT support, set DHT to false.
+DHT = false